@@ -0,0 +1,422 @@
+#include "arquivo.h"
+#include "io.h"
+#include "cores.h"
+#include "paralelo.h"
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+const size_t COLABORADORES_POR_BLOCO_ARQUIVO = 256;
+
+static const char MAGIA_CABECALHO[] = "RHARQ001";
+static const char MAGIA_RODAPE[] = "RHARQFIM";
+static const size_t TAMANHO_CABECALHO = 8 + 4;
+static const size_t TAMANHO_ENTRADA_BLOCO = 4 + 4 + 8 + 4 + 4;
+static const size_t TAMANHO_RODAPE_ARQUIVO = 8 + 4 + 4 + 8;
+static const size_t BLOCOS_EM_CACHE = 8;
+
+// Maior linha "ID;calendario" possível (ID de 11 caracteres, 366 dias "ddd:Tn,") e, com ela, o maior
+// bloco descomprimido que um arquivo válido pode declarar
+static const size_t TAMANHO_MAXIMO_LINHA_ARQUIVO = 11 + 1 + 366 * 7 + 1;
+static const uint64_t TAMANHO_MAXIMO_BLOCO_ARQUIVO = COLABORADORES_POR_BLOCO_ARQUIVO * TAMANHO_MAXIMO_LINHA_ARQUIVO;
+
+std::string nomeArquivoAno(int ano) {
+    return "rh_arquivo_" + std::to_string(ano) + ".dat";
+}
+
+// --- Inteiros little-endian ---
+
+static void escreverU32(std::string& destino, uint32_t valor) {
+    for (int i = 0; i < 4; ++i) destino += static_cast<char>((valor >> (8 * i)) & 0xFF);
+}
+
+static void escreverU64(std::string& destino, uint64_t valor) {
+    for (int i = 0; i < 8; ++i) destino += static_cast<char>((valor >> (8 * i)) & 0xFF);
+}
+
+static uint32_t lerU32(const char* p) {
+    uint32_t valor = 0;
+    for (int i = 0; i < 4; ++i) valor |= static_cast<uint32_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    return valor;
+}
+
+static uint64_t lerU64(const char* p) {
+    uint64_t valor = 0;
+    for (int i = 0; i < 8; ++i) valor |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    return valor;
+}
+
+// ===============================================
+// COMPRESSÃO LZ
+// ===============================================
+// Cada sequência: token (4 bits de literais | 4 bits de cópia-4), extensões de 255 em 255,
+// os literais, e o deslocamento da cópia (2 bytes). A última sequência só tem literais.
+
+static const size_t COPIA_MINIMA = 4;
+static const size_t JANELA_LZ = 65535;
+static const int BITS_TABELA_LZ = 12;
+
+static void escreverComprimentoExtra(std::string& destino, size_t resto) {
+    while (resto >= 255) { destino += static_cast<char>(255); resto -= 255; }
+    destino += static_cast<char>(resto);
+}
+
+static void emitirSequencia(std::string& destino, const char* literais, size_t numLiterais,
+                            size_t deslocamento, size_t comprimentoCopia) {
+    size_t extraCopia = comprimentoCopia >= COPIA_MINIMA ? comprimentoCopia - COPIA_MINIMA : 0;
+    unsigned token = (static_cast<unsigned>(std::min<size_t>(numLiterais, 15)) << 4) |
+                     static_cast<unsigned>(std::min<size_t>(extraCopia, 15));
+    destino += static_cast<char>(token);
+    if (numLiterais >= 15) escreverComprimentoExtra(destino, numLiterais - 15);
+    destino.append(literais, numLiterais);
+    if (comprimentoCopia == 0) return; // Última sequência
+
+    destino += static_cast<char>(deslocamento & 0xFF);
+    destino += static_cast<char>((deslocamento >> 8) & 0xFF);
+    if (extraCopia >= 15) escreverComprimentoExtra(destino, extraCopia - 15);
+}
+
+void comprimirLZ(const std::string& origem, std::string& destino) {
+    destino.clear();
+    destino.reserve(origem.size() / 2 + 16);
+    const char* dados = origem.data();
+    const size_t n = origem.size();
+
+    // Última posição (+1) de cada sequência de 4 bytes, pelo hash
+    std::vector<uint32_t> tabela(size_t(1) << BITS_TABELA_LZ, 0);
+    auto ler4 = [&](size_t pos) { uint32_t v; std::memcpy(&v, dados + pos, 4); return v; };
+
+    size_t ancora = 0, pos = 0;
+    while (pos + COPIA_MINIMA <= n) {
+        uint32_t sequencia = ler4(pos);
+        uint32_t h = (sequencia * 2654435761u) >> (32 - BITS_TABELA_LZ);
+        size_t candidato = tabela[h];
+        tabela[h] = static_cast<uint32_t>(pos + 1);
+
+        if (candidato != 0 && pos + 1 - candidato <= JANELA_LZ && ler4(candidato - 1) == sequencia) {
+            size_t inicioCopia = candidato - 1;
+            size_t comprimento = COPIA_MINIMA;
+            while (pos + comprimento < n && dados[inicioCopia + comprimento] == dados[pos + comprimento]) ++comprimento;
+
+            emitirSequencia(destino, dados + ancora, pos - ancora, pos - inicioCopia, comprimento);
+            pos += comprimento;
+            ancora = pos;
+        } else {
+            ++pos;
+        }
+    }
+    emitirSequencia(destino, dados + ancora, n - ancora, 0, 0);
+}
+
+bool descomprimirLZ(const char* dados, size_t tamanho, size_t tamanhoOriginal, std::string& destino) {
+    destino.clear();
+    destino.reserve(tamanhoOriginal);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(dados);
+    const unsigned char* fim = p + tamanho;
+
+    auto lerComprimentoExtra = [&](size_t& comprimento) {
+        unsigned char b;
+        do {
+            if (p >= fim) return false;
+            b = *p++;
+            comprimento += b;
+        } while (b == 255);
+        return true;
+    };
+
+    while (p < fim) {
+        unsigned token = *p++;
+        size_t numLiterais = token >> 4;
+        if (numLiterais == 15 && !lerComprimentoExtra(numLiterais)) return false;
+        if (static_cast<size_t>(fim - p) < numLiterais || destino.size() + numLiterais > tamanhoOriginal) return false;
+        destino.append(reinterpret_cast<const char*>(p), numLiterais);
+        p += numLiterais;
+        if (p == fim) break; // Última sequência
+
+        if (fim - p < 2) return false;
+        size_t deslocamento = static_cast<size_t>(p[0]) | (static_cast<size_t>(p[1]) << 8);
+        p += 2;
+        size_t comprimento = token & 0x0F;
+        if (comprimento == 15 && !lerComprimentoExtra(comprimento)) return false;
+        comprimento += COPIA_MINIMA;
+        if (deslocamento == 0 || deslocamento > destino.size() || destino.size() + comprimento > tamanhoOriginal) return false;
+
+        // A cópia pode sobrepor-se ao que está a ser escrito (repetições), por isso é byte a byte
+        size_t origem = destino.size() - deslocamento;
+        for (size_t i = 0; i < comprimento; ++i) destino += destino[origem + i];
+    }
+    return destino.size() == tamanhoOriginal;
+}
+
+// ===============================================
+// ESCRITA DO ARQUIVO
+// ===============================================
+
+bool anoArquivado(int ano) {
+    return std::ifstream(nomeArquivoAno(ano)).is_open();
+}
+
+// Escreve o arquivo sem mensagens. 'bytesOriginais' recebe o tamanho das linhas antes de comprimir.
+static bool escreverArquivo(const std::vector<Colaborador>& lista, int ano, const std::string& nomeFicheiro,
+                            size_t& bytesOriginais, size_t& bytesComprimidos) {
+    std::vector<const Colaborador*> ordenados;
+    ordenados.reserve(lista.size());
+    for (const auto& colab : lista) ordenados.push_back(&colab);
+    std::sort(ordenados.begin(), ordenados.end(),
+              [](const Colaborador* a, const Colaborador* b) { return a->id < b->id; });
+
+    std::string dados(MAGIA_CABECALHO, 8);
+    escreverU32(dados, static_cast<uint32_t>(ano));
+
+    // Os blocos são independentes: são codificados e comprimidos em paralelo e juntados por ordem
+    const size_t numBlocos = (ordenados.size() + COLABORADORES_POR_BLOCO_ARQUIVO - 1) / COLABORADORES_POR_BLOCO_ARQUIVO;
+    std::vector<std::string> comprimidos(numBlocos);
+    std::vector<size_t> tamanhosOriginais(numBlocos);
+    executarParalelo(numBlocos, [&](size_t b) {
+        const size_t inicio = b * COLABORADORES_POR_BLOCO_ARQUIVO;
+        const size_t fimBloco = std::min(ordenados.size(), inicio + COLABORADORES_POR_BLOCO_ARQUIVO);
+        std::string bloco;
+        for (size_t i = inicio; i < fimBloco; ++i) {
+            bloco += std::to_string(ordenados[i]->id);
+            bloco += ';';
+            codificarCalendario(ordenados[i]->calendario, bloco, &ordenados[i]->parciais);
+            bloco += '\n';
+        }
+        comprimirLZ(bloco, comprimidos[b]);
+        tamanhosOriginais[b] = bloco.size();
+    });
+
+    std::string indice;
+    bytesOriginais = 0;
+    for (size_t b = 0; b < numBlocos; ++b) {
+        const size_t inicio = b * COLABORADORES_POR_BLOCO_ARQUIVO;
+        const size_t fimBloco = std::min(ordenados.size(), inicio + COLABORADORES_POR_BLOCO_ARQUIVO);
+        escreverU32(indice, static_cast<uint32_t>(ordenados[inicio]->id));
+        escreverU32(indice, static_cast<uint32_t>(ordenados[fimBloco - 1]->id));
+        escreverU64(indice, dados.size());
+        escreverU32(indice, static_cast<uint32_t>(comprimidos[b].size()));
+        escreverU32(indice, static_cast<uint32_t>(tamanhosOriginais[b]));
+        dados += comprimidos[b];
+        std::string().swap(comprimidos[b]);
+        bytesOriginais += tamanhosOriginais[b];
+    }
+
+    uint64_t inicioIndice = dados.size();
+    dados += indice;
+    escreverU64(dados, inicioIndice);
+    escreverU32(dados, static_cast<uint32_t>(numBlocos));
+    escreverU32(dados, static_cast<uint32_t>(ordenados.size()));
+    dados.append(MAGIA_RODAPE, 8);
+    bytesComprimidos = dados.size();
+
+    const std::string temporario = nomeFicheiro + ".tmp";
+    {
+        std::ofstream ficheiro(temporario, std::ios::binary);
+        if (!ficheiro.is_open()) return false;
+        ficheiro.write(dados.data(), static_cast<std::streamsize>(dados.size()));
+        if (!ficheiro) return false;
+    }
+    return publicarFicheiro(temporario, nomeFicheiro);
+}
+
+// Declarado mais abaixo, junto da leitura
+static void esquecerArquivo(int ano);
+
+bool arquivarAno(const std::vector<Colaborador>& lista, int ano) {
+    const std::string nomeFicheiro = nomeArquivoAno(ano);
+    if (anoArquivado(ano)) {
+        std::cerr << COR_VERMELHA << "ERRO: O ano " << ano << " ja esta arquivado (" << nomeFicheiro << ").\n" << RESET_COR;
+        return false;
+    }
+
+    size_t bytesOriginais = 0, bytesComprimidos = 0;
+    if (!escreverArquivo(lista, ano, nomeFicheiro, bytesOriginais, bytesComprimidos)) {
+        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel gravar " << nomeFicheiro << ".\n" << RESET_COR;
+        return false;
+    }
+    esquecerArquivo(ano); // Uma consulta anterior pode ter registado que o ano não existia
+    std::cout << COR_VERDE << "[INFO] Ano " << ano << " arquivado em " << nomeFicheiro << ": " << lista.size()
+              << " colaboradores, " << bytesOriginais / 1024 << " KB -> " << bytesComprimidos / 1024 << " KB.\n" << RESET_COR;
+    return true;
+}
+
+// ===============================================
+// LEITURA A PEDIDO
+// ===============================================
+
+struct EntradaBloco {
+    int primeiroId = 0;
+    int ultimoId = 0;
+    uint64_t offset = 0;
+    uint32_t tamanhoComprimido = 0;
+    uint32_t tamanhoOriginal = 0;
+};
+
+struct ArquivoAno {
+    std::mutex mutex; // Protege o ficheiro e a cache (as consultas podem vir de várias threads)
+    std::ifstream ficheiro;
+    std::vector<EntradaBloco> blocos;
+
+    // Cache LRU de blocos descomprimidos (mais recente à frente)
+    std::list<std::pair<size_t, std::string>> cache;
+
+    bool abrir(const std::string& nomeFicheiro, int ano);
+    const std::string* bloco(size_t posicao);
+};
+
+bool ArquivoAno::abrir(const std::string& nomeFicheiro, int ano) {
+    ficheiro.open(nomeFicheiro, std::ios::binary | std::ios::ate);
+    if (!ficheiro.is_open()) return false;
+
+    std::streamoff tamanho = ficheiro.tellg();
+    if (tamanho < static_cast<std::streamoff>(TAMANHO_CABECALHO + TAMANHO_RODAPE_ARQUIVO)) return false;
+
+    char cabecalho[TAMANHO_CABECALHO];
+    char rodape[TAMANHO_RODAPE_ARQUIVO];
+    ficheiro.seekg(0);
+    ficheiro.read(cabecalho, sizeof(cabecalho));
+    ficheiro.seekg(tamanho - static_cast<std::streamoff>(TAMANHO_RODAPE_ARQUIVO));
+    ficheiro.read(rodape, sizeof(rodape));
+    if (!ficheiro || std::memcmp(cabecalho, MAGIA_CABECALHO, 8) != 0 || std::memcmp(rodape + 16, MAGIA_RODAPE, 8) != 0 ||
+        static_cast<int>(lerU32(cabecalho + 8)) != ano) {
+        return false;
+    }
+
+    uint64_t inicioIndice = lerU64(rodape);
+    uint32_t numBlocos = lerU32(rodape + 8);
+    if (inicioIndice < TAMANHO_CABECALHO || inicioIndice > static_cast<uint64_t>(tamanho) ||
+        inicioIndice + uint64_t(numBlocos) * TAMANHO_ENTRADA_BLOCO + TAMANHO_RODAPE_ARQUIVO != static_cast<uint64_t>(tamanho)) {
+        return false;
+    }
+
+    std::string indice(numBlocos * TAMANHO_ENTRADA_BLOCO, '\0');
+    ficheiro.seekg(static_cast<std::streamoff>(inicioIndice));
+    ficheiro.read(&indice[0], static_cast<std::streamsize>(indice.size()));
+    if (!ficheiro) return false;
+
+    // O índice não é usado sem ser validado: os blocos seguem-se sem buracos desde o cabeçalho até
+    // ao índice, os IDs sobem de bloco para bloco (a pesquisa binária depende disso) e o tamanho
+    // descomprimido é o que um bloco pode ter e o que o LZ consegue produzir (255 bytes por byte)
+    blocos.resize(numBlocos);
+    uint64_t proximoOffset = TAMANHO_CABECALHO;
+    for (uint32_t i = 0; i < numBlocos; ++i) {
+        const char* p = indice.data() + i * TAMANHO_ENTRADA_BLOCO;
+        EntradaBloco& entrada = blocos[i];
+        entrada.primeiroId = static_cast<int>(lerU32(p));
+        entrada.ultimoId = static_cast<int>(lerU32(p + 4));
+        entrada.offset = lerU64(p + 8);
+        entrada.tamanhoComprimido = lerU32(p + 16);
+        entrada.tamanhoOriginal = lerU32(p + 20);
+
+        if (entrada.offset != proximoOffset || entrada.tamanhoComprimido == 0 ||
+            entrada.offset + entrada.tamanhoComprimido > inicioIndice) {
+            return false;
+        }
+        if (entrada.primeiroId > entrada.ultimoId || (i > 0 && entrada.primeiroId <= blocos[i - 1].ultimoId)) return false;
+        if (entrada.tamanhoOriginal > TAMANHO_MAXIMO_BLOCO_ARQUIVO ||
+            entrada.tamanhoOriginal > uint64_t(entrada.tamanhoComprimido) * 255) {
+            return false;
+        }
+        proximoOffset = entrada.offset + entrada.tamanhoComprimido;
+    }
+    return proximoOffset == inicioIndice;
+}
+
+const std::string* ArquivoAno::bloco(size_t posicao) {
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+        if (it->first == posicao) {
+            cache.splice(cache.begin(), cache, it);
+            return &cache.front().second;
+        }
+    }
+
+    const EntradaBloco& entrada = blocos[posicao];
+    std::string comprimido(entrada.tamanhoComprimido, '\0');
+    ficheiro.clear();
+    ficheiro.seekg(static_cast<std::streamoff>(entrada.offset));
+    ficheiro.read(&comprimido[0], static_cast<std::streamsize>(comprimido.size()));
+    if (!ficheiro) return nullptr;
+
+    std::string texto;
+    if (!descomprimirLZ(comprimido.data(), comprimido.size(), entrada.tamanhoOriginal, texto)) return nullptr;
+    cache.emplace_front(posicao, std::move(texto));
+    if (cache.size() > BLOCOS_EM_CACHE) cache.pop_back();
+    return &cache.front().second;
+}
+
+// Arquivos abertos por ano (nullptr = não existe ou é inválido, para não voltar a tentar).
+// Depois da primeira consulta a um ano, encontrá-lo só precisa do lock partilhado.
+static std::shared_mutex mutexArquivos;
+static std::map<int, std::shared_ptr<ArquivoAno>> arquivosAbertos;
+
+static std::shared_ptr<ArquivoAno> arquivoDoAno(int ano) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutexArquivos);
+        auto it = arquivosAbertos.find(ano);
+        if (it != arquivosAbertos.end()) return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutexArquivos);
+    auto it = arquivosAbertos.find(ano);
+    if (it == arquivosAbertos.end()) {
+        auto arquivo = std::make_shared<ArquivoAno>();
+        if (!arquivo->abrir(nomeArquivoAno(ano), ano)) {
+            if (arquivo->ficheiro.is_open()) {
+                std::cerr << COR_AMARELA << "[AVISO] " << nomeArquivoAno(ano) << " nao e um arquivo valido.\n" << RESET_COR;
+            }
+            arquivo.reset();
+        }
+        it = arquivosAbertos.emplace(ano, std::move(arquivo)).first;
+    }
+    return it->second;
+}
+
+bool lerCalendarioArquivado(int id, int ano, std::map<int, TipoMarcacao>& calendario, ParciaisDia* parciais) {
+    std::shared_ptr<ArquivoAno> arquivo = arquivoDoAno(ano);
+    if (!arquivo) return false;
+    std::lock_guard<std::mutex> lock(arquivo->mutex);
+
+    // Bloco cujo intervalo de IDs contém o colaborador
+    auto blocoIt = std::upper_bound(arquivo->blocos.begin(), arquivo->blocos.end(), id,
+                                    [](int valor, const EntradaBloco& b) { return valor < b.primeiroId; });
+    if (blocoIt == arquivo->blocos.begin() || id > std::prev(blocoIt)->ultimoId) return false;
+    const std::string* texto = arquivo->bloco(static_cast<size_t>(std::prev(blocoIt) - arquivo->blocos.begin()));
+    if (texto == nullptr) return false;
+
+    const char* p = texto->data();
+    const char* fim = p + texto->size();
+    while (p < fim) {
+        const char* fimLinha = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(fim - p)));
+        if (fimLinha == nullptr) fimLinha = fim;
+        int idLinha = 0;
+        auto resultado = std::from_chars(p, fimLinha, idLinha);
+        if (resultado.ec == std::errc() && idLinha == id && resultado.ptr < fimLinha && *resultado.ptr == ';') {
+            calendario.clear();
+            if (parciais != nullptr) parciais->clear();
+            try {
+                descodificarCalendario(resultado.ptr + 1, fimLinha, calendario, parciais);
+            } catch (const std::exception&) {
+                return false;
+            }
+            return true;
+        }
+        p = fimLinha + 1;
+    }
+    return false;
+}
+
+static void esquecerArquivo(int ano) {
+    std::unique_lock<std::shared_mutex> lock(mutexArquivos);
+    arquivosAbertos.erase(ano);
+}
+
+void fecharArquivos() {
+    std::unique_lock<std::shared_mutex> lock(mutexArquivos);
+    arquivosAbertos.clear();
+}
@@ -0,0 +1,46 @@
+#ifndef ARQUIVO_H
+#define ARQUIVO_H
+
+#include "colaborador.h"
+#include <string>
+#include <vector>
+#include <map>
+
+// ===============================================
+// ARQUIVO DE ANOS FECHADOS
+// ===============================================
+// O calendário em memória (Colaborador::calendario) é o do ano atual. Um ano fechado é congelado
+// num ficheiro só de leitura, rh_arquivo_<ano>.dat, com os calendários comprimidos em blocos:
+//   "RHARQ001" <ano>                                  (cabeçalho)
+//   blocos comprimidos (LZ) de linhas "ID;calendario"  (ordenadas por ID, ver codificarCalendario)
+//   índice: por bloco <primeiroId><ultimoId><offset><tamanhoComprimido><tamanhoOriginal>
+//   rodapé: <inicioIndice><numBlocos><numColaboradores> "RHARQFIM"
+// Os inteiros são binários little-endian. O arquivo só é aberto quando uma visualização, contagem
+// ou exportação pede esse ano; uma consulta descomprime apenas o bloco do colaborador, e os últimos
+// blocos usados ficam numa pequena cache.
+
+extern const size_t COLABORADORES_POR_BLOCO_ARQUIVO;
+
+// rh_arquivo_<ano>.dat
+std::string nomeArquivoAno(int ano);
+
+// Compressor LZ sem dependências (sequências literais + cópias de até 64 KB atrás)
+void comprimirLZ(const std::string& origem, std::string& destino);
+// Retorna false se os dados estiverem corrompidos ou não tiverem o tamanho esperado
+bool descomprimirLZ(const char* dados, size_t tamanho, size_t tamanhoOriginal, std::string& destino);
+
+// Congela os calendários da lista como o ano 'ano'. Um ano já arquivado não é reescrito.
+bool arquivarAno(const std::vector<Colaborador>& lista, int ano);
+
+// Verdadeiro se existir arquivo para o ano
+bool anoArquivado(int ano);
+
+// Calendário de um colaborador num ano arquivado. Retorna false se o ano não estiver arquivado
+// ou se o colaborador não constar do arquivo. Pode ser chamado de várias threads. Com 'parciais',
+// recebe também os dias marcados só em parte.
+bool lerCalendarioArquivado(int id, int ano, std::map<int, TipoMarcacao>& calendario, ParciaisDia* parciais = nullptr);
+
+// Fecha os arquivos abertos e liberta a cache de blocos
+void fecharArquivos();
+
+#endif // ARQUIVO_H
@@ -0,0 +1,155 @@
+#include "ausencias.h"
+#include "calendario.h"
+#include <algorithm>
+
+// ===============================================
+// ÁRVORE DE FENWICK
+// ===============================================
+
+void ArvoreFenwick::construir(const std::array<int, DIAS_INDICE_AUSENCIAS + 1>& contagens) {
+    arvore = contagens;
+    arvore[0] = 0;
+    for (int i = 1; i <= DIAS_INDICE_AUSENCIAS; ++i) {
+        int pai = i + (i & -i);
+        if (pai <= DIAS_INDICE_AUSENCIAS) arvore[pai] += arvore[i];
+    }
+}
+
+void ArvoreFenwick::adicionar(int dia, int delta) {
+    for (; dia >= 1 && dia <= DIAS_INDICE_AUSENCIAS; dia += dia & -dia) arvore[dia] += delta;
+}
+
+int ArvoreFenwick::somaAte(int dia) const {
+    dia = std::min(dia, DIAS_INDICE_AUSENCIAS);
+    int soma = 0;
+    for (; dia > 0; dia -= dia & -dia) soma += arvore[dia];
+    return soma;
+}
+
+int ArvoreFenwick::somaIntervalo(int inicio, int fim) const {
+    inicio = std::max(inicio, 1);
+    if (fim < inicio) return 0;
+    return somaAte(fim) - somaAte(inicio - 1);
+}
+
+// ===============================================
+// ÍNDICE POR DEPARTAMENTO
+// ===============================================
+
+void IndiceAusencias::construir(const std::vector<Colaborador>& lista, int ano) {
+    porDepartamento.clear();
+    acrescentar(lista, ano);
+}
+
+void IndiceAusencias::acrescentar(const std::vector<Colaborador>& parte, int ano) {
+    using Contagens = std::array<int, DIAS_INDICE_AUSENCIAS + 1>;
+    struct ContagensDepartamento { Contagens ferias{}, faltas{}, unidadesFerias{}, unidadesFaltas{}; };
+    std::map<std::string, ContagensDepartamento> contagens;
+
+    std::map<int, TipoMarcacao> arquivado;
+    ParciaisDia parciaisArquivados;
+    for (const auto& colab : parte) {
+        auto& c = contagens[colab.departamento];
+        const ParciaisDia* parciais = &colab.parciais;
+        const auto& calendario = ano != 0 ? calendarioComParciais(colab, ano, arquivado, parciaisArquivados, parciais) : colab.calendario;
+        for (const auto& par : calendario) {
+            if (par.first < 1 || par.first > DIAS_INDICE_AUSENCIAS) continue;
+            c.ferias[par.first] += contaTipo(MASCARA_FERIAS, par.second);
+            c.faltas[par.first] += contaTipo(MASCARA_FALTAS, par.second);
+            c.unidadesFerias[par.first] += contaTipo(MASCARA_FERIAS, par.second) * UNIDADES_POR_DIA;
+            c.unidadesFaltas[par.first] += contaTipo(MASCARA_FALTAS, par.second) * UNIDADES_POR_DIA;
+        }
+        // Os dias parciais só contam as unidades que usam
+        for (const auto& parcial : *parciais) {
+            auto marcado = calendario.find(parcial.first);
+            if (marcado == calendario.end() || parcial.first < 1 || parcial.first > DIAS_INDICE_AUSENCIAS) continue;
+            const int emFalta = UNIDADES_POR_DIA - parcial.second;
+            c.unidadesFerias[parcial.first] -= emFalta * contaTipo(MASCARA_FERIAS, marcado->second);
+            c.unidadesFaltas[parcial.first] -= emFalta * contaTipo(MASCARA_FALTAS, marcado->second);
+        }
+    }
+
+    for (auto& par : contagens) {
+        const ContagensDepartamento& c = par.second;
+        auto it = porDepartamento.find(par.first);
+        if (it == porDepartamento.end()) {
+            AusenciasDepartamento& depto = porDepartamento[par.first];
+            depto.ferias.construir(c.ferias);
+            depto.faltas.construir(c.faltas);
+            depto.unidadesFerias.construir(c.unidadesFerias);
+            depto.unidadesFaltas.construir(c.unidadesFaltas);
+            continue;
+        }
+        // Departamento já presente (ex: dividido por várias partes): somar dia a dia
+        for (int dia = 1; dia <= DIAS_INDICE_AUSENCIAS; ++dia) {
+            if (c.ferias[dia] != 0) it->second.ferias.adicionar(dia, c.ferias[dia]);
+            if (c.faltas[dia] != 0) it->second.faltas.adicionar(dia, c.faltas[dia]);
+            if (c.unidadesFerias[dia] != 0) it->second.unidadesFerias.adicionar(dia, c.unidadesFerias[dia]);
+            if (c.unidadesFaltas[dia] != 0) it->second.unidadesFaltas.adicionar(dia, c.unidadesFaltas[dia]);
+        }
+    }
+}
+
+void IndiceAusencias::alterarDia(const std::string& departamento, int diaDoAno, TipoMarcacao antes, TipoMarcacao depois,
+                                  int unidadesAntes, int unidadesDepois) {
+    if (antes == depois && unidadesAntes == unidadesDepois) return;
+    const int ferias = contaTipo(MASCARA_FERIAS, depois) - contaTipo(MASCARA_FERIAS, antes);
+    const int faltas = contaTipo(MASCARA_FALTAS, depois) - contaTipo(MASCARA_FALTAS, antes);
+    const int unidadesFerias = contaTipo(MASCARA_FERIAS, depois) * unidadesDepois - contaTipo(MASCARA_FERIAS, antes) * unidadesAntes;
+    const int unidadesFaltas = contaTipo(MASCARA_FALTAS, depois) * unidadesDepois - contaTipo(MASCARA_FALTAS, antes) * unidadesAntes;
+    if (unidadesFerias == 0 && unidadesFaltas == 0 && ferias == 0 && faltas == 0) return;
+    AusenciasDepartamento& depto = porDepartamento[departamento];
+    if (ferias != 0) depto.ferias.adicionar(diaDoAno, ferias);
+    if (faltas != 0) depto.faltas.adicionar(diaDoAno, faltas);
+    if (unidadesFerias != 0) depto.unidadesFerias.adicionar(diaDoAno, unidadesFerias);
+    if (unidadesFaltas != 0) depto.unidadesFaltas.adicionar(diaDoAno, unidadesFaltas);
+}
+
+void IndiceAusencias::removerColaborador(const Colaborador& colab) {
+    for (const auto& par : colab.calendario) {
+        alterarDia(colab.departamento, par.first, par.second, TipoMarcacao::LIVRE, unidadesDoDia(colab, par.first));
+    }
+}
+
+void IndiceAusencias::contarIntervalo(const std::string& departamento, int inicio, int fim, int& ferias, int& faltas) const {
+    ferias = 0;
+    faltas = 0;
+    auto it = porDepartamento.find(departamento);
+    if (it == porDepartamento.end()) return;
+    ferias = it->second.ferias.somaIntervalo(inicio, fim);
+    faltas = it->second.faltas.somaIntervalo(inicio, fim);
+}
+
+void IndiceAusencias::contarUnidadesIntervalo(const std::string& departamento, int inicio, int fim, int& ferias, int& faltas) const {
+    ferias = 0;
+    faltas = 0;
+    auto it = porDepartamento.find(departamento);
+    if (it == porDepartamento.end()) return;
+    ferias = it->second.unidadesFerias.somaIntervalo(inicio, fim);
+    faltas = it->second.unidadesFaltas.somaIntervalo(inicio, fim);
+}
+
+int IndiceAusencias::feriasNoDia(const std::string& departamento, int diaDoAno) const {
+    auto it = porDepartamento.find(departamento);
+    return it == porDepartamento.end() ? 0 : it->second.ferias.somaIntervalo(diaDoAno, diaDoAno);
+}
+
+// ===============================================
+// GANCHOS
+// ===============================================
+
+static IndiceAusencias* indiceAtivo = nullptr;
+
+void ativarIndiceAusencias(IndiceAusencias* indice) {
+    indiceAtivo = indice;
+}
+
+void retirarColaboradorAusencias(const Colaborador& colab) {
+    if (indiceAtivo != nullptr) indiceAtivo->removerColaborador(colab);
+}
+
+void registarAusenciaDia(const Colaborador& colab, int diaDoAno, TipoMarcacao antes, TipoMarcacao depois, int unidadesAntes) {
+    if (indiceAtivo != nullptr) {
+        indiceAtivo->alterarDia(colab.departamento, diaDoAno, antes, depois, unidadesAntes, unidadesDoDia(colab, diaDoAno));
+    }
+}
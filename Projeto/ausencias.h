@@ -0,0 +1,74 @@
+#ifndef AUSENCIAS_H
+#define AUSENCIAS_H
+
+#include "colaborador.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <array>
+
+// ===============================================
+// CONTAGENS DE AUSÊNCIAS POR INTERVALO
+// ===============================================
+// Para cada departamento, duas árvores de Fenwick (férias e faltas) indexadas pelo dia do ano.
+// Uma contagem num intervalo [inicio, fim] qualquer custa O(log 366), e uma marcação atualiza o
+// índice no mesmo tempo, por isso o índice pode acompanhar os dados (ex: no modo servidor).
+// Construir a partir de uma lista custa O(marcações + departamentos * 366).
+//
+// Há duas contagens por dia: colaboradores ausentes (um dia parcial conta como um, para os
+// conflitos de férias) e tempo marcado em unidades (UNIDADES_POR_DIA por dia inteiro, para os
+// relatórios, como em contarAusenciasIntervalo).
+
+const int DIAS_INDICE_AUSENCIAS = 366;
+
+struct ArvoreFenwick {
+    std::array<int, DIAS_INDICE_AUSENCIAS + 1> arvore{}; // Posição 0 não usada
+
+    // Constrói a árvore a partir das contagens por dia (contagens[1..366]) em tempo linear
+    void construir(const std::array<int, DIAS_INDICE_AUSENCIAS + 1>& contagens);
+    void adicionar(int dia, int delta);
+    int somaAte(int dia) const;                  // Dias 1..dia
+    int somaIntervalo(int inicio, int fim) const; // Dias inicio..fim (inclusive)
+};
+
+struct AusenciasDepartamento {
+    ArvoreFenwick ferias;          // Colaboradores por dia
+    ArvoreFenwick faltas;
+    ArvoreFenwick unidadesFerias;  // Unidades marcadas por dia
+    ArvoreFenwick unidadesFaltas;
+};
+
+struct IndiceAusencias {
+    std::map<std::string, AusenciasDepartamento> porDepartamento;
+
+    // Substitui o conteúdo pelos calendários da lista. Com 'ano' de um ano fechado, usa o arquivo
+    // desse ano (ver calendarioDoAno); com 0, o calendário em memória.
+    void construir(const std::vector<Colaborador>& lista, int ano = 0);
+
+    // Junta os calendários de uma parte da empresa (ver PercorrerEmpresa em reports.h)
+    void acrescentar(const std::vector<Colaborador>& parte, int ano = 0);
+
+    // Atualizações incrementais (as unidades são as do dia antes e depois, ver unidadesDoDia)
+    void alterarDia(const std::string& departamento, int diaDoAno, TipoMarcacao antes, TipoMarcacao depois,
+                    int unidadesAntes = UNIDADES_POR_DIA, int unidadesDepois = UNIDADES_POR_DIA);
+    void removerColaborador(const Colaborador& colab);
+
+    // Ausências do departamento nos dias inicio..fim do ano (0 se o departamento não existir)
+    void contarIntervalo(const std::string& departamento, int inicio, int fim, int& ferias, int& faltas) const;
+
+    // O mesmo em unidades (para formatarDias)
+    void contarUnidadesIntervalo(const std::string& departamento, int inicio, int fim, int& ferias, int& faltas) const;
+
+    // Número de colaboradores do departamento de férias num dia
+    int feriasNoDia(const std::string& departamento, int diaDoAno) const;
+};
+
+// Ganchos: atualizam o índice ativo (se houver), tal como os do ranking (ranking.h). O índice
+// ativo é o do calendário em memória da sessão, usado pelo menu de marcações e pelos relatórios.
+void ativarIndiceAusencias(IndiceAusencias* indice);
+void retirarColaboradorAusencias(const Colaborador& colab);
+// 'colab' já tem o dia alterado; 'unidadesAntes' são as unidades do dia antes da alteração
+void registarAusenciaDia(const Colaborador& colab, int diaDoAno, TipoMarcacao antes, TipoMarcacao depois,
+                         int unidadesAntes = UNIDADES_POR_DIA);
+
+#endif // AUSENCIAS_H
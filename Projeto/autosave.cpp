@@ -0,0 +1,169 @@
+#include "autosave.h"
+#include "io.h"
+#include "metricas.h"
+#include "indice.h"
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <fstream>
+#include <cstdio>
+#include <sstream>
+
+std::mutex mutexDados;
+
+// ===============================================
+// ESTADO DA THREAD DE AUTOSAVE
+// ===============================================
+
+static std::vector<Colaborador>* listaAutosave = nullptr;
+static std::string ficheiroAutosave;
+static std::vector<int> remocoesPendentes; // Protegido por mutexDados
+static bool autosaveAtivo = false;         // Protegido por mutexDados
+
+static std::thread threadAutosave;
+static std::mutex mutexParagem;
+static std::condition_variable cvParagem;
+static bool pedidoParagem = false;
+
+// Duplo buffer: a preparação é preenchida com o lock, a escrita vai para o disco sem o lock.
+// Só a thread de autosave (ou quem a parou) usa estes buffers.
+static std::string bufferPreparacao;
+static std::string bufferEscrita;
+static size_t tamanhoJournal = 0;
+static bool compactarJournal = true; // Gravação completa quando o journal fica grande
+static ConstrutorIndice indiceCompleto; // Índice da gravação completa (offsets no buffer)
+
+void registarRemocao(int id) {
+    if (autosaveAtivo) remocoesPendentes.push_back(id);
+}
+
+// Serializa as alterações pendentes para o buffer de preparação (chamar com mutexDados)
+static size_t prepararAlteracoes(bool completo) {
+    bufferPreparacao.clear();
+    size_t registos = 0;
+    if (!completo) {
+        // Remoções primeiro: um ID removido e reutilizado no mesmo intervalo fica com o registo novo
+        for (int id : remocoesPendentes) {
+            bufferPreparacao += "-" + std::to_string(id) + "\n";
+            ++registos;
+        }
+    }
+    remocoesPendentes.clear();
+    indiceCompleto.limpar();
+    if (completo) bufferPreparacao += linhaVersaoDados() + "\n"; // Os offsets do índice contam com ela
+
+    for (auto& colab : *listaAutosave) {
+        if (completo || colab.modificado) {
+            std::string linha = serializarColaborador(colab);
+            if (completo) indiceCompleto.registar(colab, bufferPreparacao.size(), linha.size());
+            bufferPreparacao += linha;
+            bufferPreparacao += '\n';
+            colab.modificado = false;
+            ++registos;
+        }
+    }
+    return registos;
+}
+
+// Acrescenta o buffer de escrita ao journal como um lote completo
+static bool escreverJournal() {
+    std::ofstream journal(nomeJournal(ficheiroAutosave), std::ios::app | std::ios::binary);
+    if (!journal.is_open()) return false;
+    journal.write(bufferEscrita.data(), static_cast<std::streamsize>(bufferEscrita.size()));
+    journal << MARCA_FIM_JOURNAL << "\n";
+    journal.flush();
+    tamanhoJournal += bufferEscrita.size() + MARCA_FIM_JOURNAL.size() + 1;
+    return static_cast<bool>(journal);
+}
+
+// Gravação completa (temporário + rename) que substitui o journal
+static bool escreverCompleto() {
+    const std::string temporario = ficheiroAutosave + ".tmp";
+    bufferEscrita += indiceCompleto.gerar(bufferEscrita.size());
+    {
+        std::ofstream ficheiro(temporario, std::ios::binary);
+        if (!ficheiro.is_open()) return false;
+        ficheiro.write(bufferEscrita.data(), static_cast<std::streamsize>(bufferEscrita.size()));
+        ficheiro.close();
+        if (!ficheiro) return false;
+    }
+    if (!publicarFicheiro(temporario, ficheiroAutosave)) return false;
+    std::remove(nomeJournal(ficheiroAutosave).c_str());
+    tamanhoJournal = 0;
+    return true;
+}
+
+size_t executarAutosave(bool esperarLock) {
+    if (listaAutosave == nullptr) return 0;
+    MEDIR_ESCOPO(Metrica::AUTOSAVE);
+
+    bool completo = compactarJournal && tamanhoJournal >= LIMITE_JOURNAL_BYTES;
+    size_t registos;
+    {
+        std::unique_lock<std::mutex> lock(mutexDados, std::defer_lock);
+        if (esperarLock) {
+            lock.lock();
+        } else if (!lock.try_lock()) {
+            return 0; // O menu está a alterar dados: fica para a próxima passagem
+        }
+        registos = prepararAlteracoes(completo);
+        if (registos == 0 && !completo) return 0;
+        std::swap(bufferPreparacao, bufferEscrita);
+    }
+
+    bool sucesso = completo ? escreverCompleto() : escreverJournal();
+    if (!sucesso) {
+        // Sem consola aqui (o utilizador está no menu): devolver as remoções à fila e
+        // marcar todos como alterados para a próxima passagem repetir a gravação
+        std::lock_guard<std::mutex> lock(mutexDados);
+        std::istringstream linhas(bufferEscrita);
+        std::string linha;
+        while (std::getline(linhas, linha)) {
+            if (!linha.empty() && linha[0] == '-') remocoesPendentes.push_back(std::stoi(linha.substr(1)));
+        }
+        for (auto& colab : *listaAutosave) colab.modificado = true;
+        return 0;
+    }
+    CONTAR_EVENTO(Contador::REGISTOS_AUTOSAVE, registos);
+    return registos;
+}
+
+void iniciarAutosave(std::vector<Colaborador>& lista, const std::string& nomeFicheiro, int intervaloSegundos, bool compactar) {
+    if (threadAutosave.joinable() || intervaloSegundos <= 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutexDados);
+        listaAutosave = &lista;
+        ficheiroAutosave = nomeFicheiro;
+        remocoesPendentes.clear();
+        autosaveAtivo = true;
+    }
+    compactarJournal = compactar;
+    std::ifstream journal(nomeJournal(nomeFicheiro), std::ios::binary | std::ios::ate);
+    tamanhoJournal = journal.is_open() ? static_cast<size_t>(journal.tellg()) : 0;
+    pedidoParagem = false;
+
+    threadAutosave = std::thread([intervaloSegundos]() {
+        std::unique_lock<std::mutex> lock(mutexParagem);
+        while (!cvParagem.wait_for(lock, std::chrono::seconds(intervaloSegundos), [] { return pedidoParagem; })) {
+            lock.unlock();
+            executarAutosave(false);
+            lock.lock();
+        }
+    });
+}
+
+void pararAutosave() {
+    if (!threadAutosave.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutexParagem);
+        pedidoParagem = true;
+    }
+    cvParagem.notify_one();
+    threadAutosave.join();
+
+    executarAutosave(true);
+    std::lock_guard<std::mutex> lock(mutexDados);
+    autosaveAtivo = false;
+    listaAutosave = nullptr;
+}
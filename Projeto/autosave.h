@@ -0,0 +1,48 @@
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+#include "colaborador.h"
+#include <string>
+#include <vector>
+#include <mutex>
+
+// ===============================================
+// AUTOSAVE EM SEGUNDO PLANO
+// ===============================================
+// Uma thread acorda a cada intervalo e grava apenas os colaboradores com a flag 'modificado'
+// (e as remoções pendentes) no journal "<ficheiro>.journal", sem bloquear o menu:
+//   1. Com mutexDados bloqueado, serializa os registos alterados para o buffer de preparação
+//      e limpa as flags (só cópias em memória, muito rápido).
+//   2. Troca o buffer de preparação com o de escrita (duplo buffer) e liberta o lock.
+//   3. Acrescenta o buffer de escrita ao journal, terminado por MARCA_FIM_JOURNAL.
+// Quando o journal cresce demasiado, é feita uma gravação completa (ficheiro temporário +
+// rename atómico) e o journal é apagado. O carregarDados reaplica o journal ao arrancar.
+// Se o lock estiver ocupado (ex: o utilizador está a meio de uma marcação), a gravação
+// fica para o intervalo seguinte.
+//
+// Como o passo 1 escreve nas flags dos colaboradores, todas as opções do menu que leem ou copiam
+// a lista (incluindo listagens, relatórios e exportações) fazem-no com mutexDados bloqueado, e
+// largam-no antes de esperar pelo ENTER.
+
+// Tamanho do journal a partir do qual se faz uma gravação completa
+const size_t LIMITE_JOURNAL_BYTES = 4 * 1024 * 1024;
+
+// Protege a lista de colaboradores entre o menu (leituras e alterações) e a thread de autosave
+extern std::mutex mutexDados;
+
+// Regista a remoção de um colaborador para o próximo autosave (chamar com mutexDados)
+void registarRemocao(int id);
+
+// Arranca a thread de autosave sobre a lista indicada (intervalo em segundos, > 0).
+// Com 'compactar' a false o journal nunca é convertido numa gravação completa de nomeFicheiro
+// (usado com os fragmentos de departamento, onde a lista carregada não é a empresa inteira).
+void iniciarAutosave(std::vector<Colaborador>& lista, const std::string& nomeFicheiro, int intervaloSegundos, bool compactar = true);
+
+// Para a thread (faz uma última passagem antes de terminar)
+void pararAutosave();
+
+// Executa uma passagem do autosave. Retorna o número de registos gravados.
+// Se 'esperarLock' for false e o lock estiver ocupado, não faz nada.
+size_t executarAutosave(bool esperarLock = false);
+
+#endif // AUTOSAVE_H
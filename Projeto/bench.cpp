@@ -0,0 +1,728 @@
+// Benchmarks dos caminhos principais do Mini-Sistema RH.
+//
+// Compilação:
+//   g++ -std=c++17 -O2 -pthread bench.cpp gerador.cpp calendario.cpp colaborador.cpp cores.cpp io.cpp reports.cpp paralelo.cpp metricas.cpp -o bench.exe
+//
+// Resultado em CSV (uma linha por operação e escala) para poder comparar execuções:
+//   escala,operacao,amostras,itens_por_amostra,total_ms,itens_por_s,p50_us,p90_us,p99_us,max_us
+
+#include "colaborador.h"
+#include "calendario.h"
+#include "io.h"
+#include "reports.h"
+#include "gerador.h"
+#include "indice.h"
+#include "ausencias.h"
+#include "mapacalor.h"
+#include "cobertura.h"
+#include "planeador.h"
+#include "formacoes.h"
+#include "notas.h"
+#include "validades.h"
+#include "duplicados.h"
+#include "padroes.h"
+#include "ranking.h"
+#include "viragem.h"
+#include "cifra.h"
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <map>
+
+// ===============================================
+// AUXILIARES DE MEDIÇÃO
+// ===============================================
+
+// streambuf que descarta tudo (as funções medidas escrevem para a consola)
+class StreamNulo : public std::streambuf {
+    char lixo[4096];
+protected:
+    int overflow(int c) override {
+        setp(lixo, lixo + sizeof(lixo));
+        return c;
+    }
+};
+
+// Redireciona std::cout/std::cerr para o nada e std::cin para um texto fixo, enquanto existir
+struct RedirecionarConsola {
+    explicit RedirecionarConsola(const std::string& entrada = "")
+        : textoEntrada(entrada),
+          antigoOut(std::cout.rdbuf(&nulo)),
+          antigoErr(std::cerr.rdbuf(&nulo)),
+          antigoIn(std::cin.rdbuf(textoEntrada.rdbuf())) {}
+    ~RedirecionarConsola() {
+        std::cout.rdbuf(antigoOut);
+        std::cerr.rdbuf(antigoErr);
+        std::cin.rdbuf(antigoIn);
+        std::cin.clear();
+    }
+
+    StreamNulo nulo;
+    std::istringstream textoEntrada;
+    std::streambuf* antigoOut;
+    std::streambuf* antigoErr;
+    std::streambuf* antigoIn;
+};
+
+using Relogio = std::chrono::steady_clock;
+
+static double nsDesde(Relogio::time_point inicio) {
+    return std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count();
+}
+
+// Imprime uma linha CSV com débito e percentis (em microssegundos)
+static void imprimirResultado(size_t escala, const std::string& operacao, std::vector<double> amostrasNs, size_t itensPorAmostra) {
+    if (amostrasNs.empty()) return;
+    std::sort(amostrasNs.begin(), amostrasNs.end());
+
+    double totalNs = 0;
+    for (double a : amostrasNs) totalNs += a;
+
+    auto percentil = [&](double p) {
+        size_t idx = static_cast<size_t>(p * static_cast<double>(amostrasNs.size() - 1) + 0.5);
+        return amostrasNs[idx] / 1000.0;
+    };
+    double itensPorSegundo = totalNs > 0 ? static_cast<double>(amostrasNs.size() * itensPorAmostra) * 1e9 / totalNs : 0.0;
+
+    std::printf("%zu,%s,%zu,%zu,%.3f,%.1f,%.3f,%.3f,%.3f,%.3f\n",
+                escala, operacao.c_str(), amostrasNs.size(), itensPorAmostra,
+                totalNs / 1e6, itensPorSegundo,
+                percentil(0.50), percentil(0.90), percentil(0.99), amostrasNs.back() / 1000.0);
+    std::fflush(stdout);
+}
+
+// Mede uma operação "pesada" (sobre todo o roster) repetida várias vezes
+template <typename F>
+static void medirRepetido(size_t escala, const std::string& operacao, int repeticoes, size_t itens, F&& f) {
+    std::vector<double> amostras;
+    for (int r = 0; r < repeticoes; ++r) {
+        auto inicio = Relogio::now();
+        f();
+        amostras.push_back(nsDesde(inicio));
+    }
+    imprimirResultado(escala, operacao, amostras, itens);
+}
+
+// ===============================================
+// CONFIGURAÇÃO (linha de comandos)
+// ===============================================
+
+struct ConfigBench {
+    std::vector<size_t> escalas = {1000, 10000, 100000};
+    int repeticoes = 5;        // Repetições das operações sobre todo o roster
+    size_t amostras = 2000;    // Chamadas individuais medidas nas operações pontuais
+    ParametrosGerador gerador;
+    std::string ficheiroGerar; // Se preenchido, apenas gera o ficheiro de dados e sai
+};
+
+static std::vector<size_t> lerListaEscalas(const std::string& texto) {
+    std::vector<size_t> escalas;
+    std::stringstream ss(texto);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) escalas.push_back(static_cast<size_t>(std::stoull(item)));
+    }
+    return escalas;
+}
+
+static void mostrarAjuda() {
+    std::cout << "Uso: bench.exe [opcoes]\n"
+              << "  --escalas 1000,10000,100000  Numero de colaboradores de cada execucao\n"
+              << "  --departamentos N            Numero de departamentos (default 10)\n"
+              << "  --densidade D                Fracao dos dias uteis com ausencia (default 0.05)\n"
+              << "  --bloco N                    Ausencias em blocos de N dias uteis seguidos (default 1)\n"
+              << "  --nome-min N / --nome-max N  Tamanho de cada palavra do nome\n"
+              << "  --notas N / --formacoes N    Notas e formacoes por colaborador\n"
+              << "  --repeticoes N               Repeticoes das operacoes globais (default 5)\n"
+              << "  --amostras N                 Chamadas medidas nas operacoes pontuais (default 2000)\n"
+              << "  --semente N                  Semente do gerador\n"
+              << "  --gerar FICHEIRO             Gera um ficheiro de dados com a primeira escala e sai\n";
+}
+
+static bool lerArgumentos(int argc, char* argv[], ConfigBench& cfg) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--ajuda" || arg == "-h") { mostrarAjuda(); return false; }
+        if (i + 1 >= argc) { mostrarAjuda(); return false; }
+        std::string valor = argv[++i];
+
+        if (arg == "--escalas") cfg.escalas = lerListaEscalas(valor);
+        else if (arg == "--departamentos") cfg.gerador.numDepartamentos = std::stoi(valor);
+        else if (arg == "--densidade") cfg.gerador.densidadeAusencias = std::stod(valor);
+        else if (arg == "--bloco") cfg.gerador.diasPorBloco = std::stoi(valor);
+        else if (arg == "--nome-min") cfg.gerador.tamanhoNomeMin = std::stoi(valor);
+        else if (arg == "--nome-max") cfg.gerador.tamanhoNomeMax = std::stoi(valor);
+        else if (arg == "--notas") cfg.gerador.notasPorColaborador = std::stoi(valor);
+        else if (arg == "--formacoes") cfg.gerador.formacoesPorColaborador = std::stoi(valor);
+        else if (arg == "--repeticoes") cfg.repeticoes = std::max(1, std::stoi(valor));
+        else if (arg == "--amostras") cfg.amostras = static_cast<size_t>(std::stoull(valor));
+        else if (arg == "--semente") cfg.gerador.semente = static_cast<unsigned>(std::stoul(valor));
+        else if (arg == "--gerar") cfg.ficheiroGerar = valor;
+        else { mostrarAjuda(); return false; }
+    }
+    return !cfg.escalas.empty();
+}
+
+// ===============================================
+// EXECUÇÃO DE UMA ESCALA
+// ===============================================
+
+static void executarEscala(const ConfigBench& cfg, size_t escala) {
+    ParametrosGerador p = cfg.gerador;
+    p.numColaboradores = escala;
+
+    std::vector<Colaborador> lista;
+    medirRepetido(escala, "gerarColaboradores", 1, escala, [&] { lista = gerarColaboradores(p); });
+
+    std::mt19937 rng(p.semente + 1);
+    std::uniform_int_distribution<size_t> distIndice(0, escala - 1);
+    std::uniform_int_distribution<int> distMes(1, 12);
+    std::uniform_int_distribution<int> distDia(1, 28);
+    const int ano = p.ano;
+    const std::string ficheiro = "bench_rh_data.txt";
+
+    // --- Persistência ---
+    {
+        RedirecionarConsola silencio;
+        medirRepetido(escala, "guardarDados", cfg.repeticoes, escala, [&] { guardarDados(lista, ficheiro); });
+        std::vector<Colaborador> carregada;
+        medirRepetido(escala, "carregarDados", cfg.repeticoes, escala, [&] { carregarDados(carregada, ficheiro); });
+    }
+
+    // --- Carga a pedido (índice no fim do ficheiro) ---
+    {
+        FicheiroIndexado indice;
+        medirRepetido(escala, "abrirIndice", cfg.repeticoes, 1, [&] { indice.abrir(ficheiro); });
+        indice.capacidadeCache = 64; // A maioria das pesquisas falha a cache, como num arranque a frio
+
+        std::vector<double> amostras;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            int id = lista[distIndice(rng)].id;
+            auto inicio = Relogio::now();
+            const Colaborador* volatile r = indice.procurarPorId(id);
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "procurarPorId_indice", amostras, 1);
+
+        amostras.clear();
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            std::string nome = lista[distIndice(rng)].nome;
+            auto inicio = Relogio::now();
+            const Colaborador* volatile r = indice.procurarPorNome(nome);
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "procurarPorNome_indice", amostras, 1);
+    }
+
+    // --- Parte do nome na carga a pedido: nomes cifrados vs. decifrar (cache) vs. carregar a lista ---
+    {
+        NomesCifrados nomes;
+        medirRepetido(escala, "carregarNomesCifrados", cfg.repeticoes, escala, [&] { nomes.carregar(ficheiro); });
+
+        // Parte do meio do nome de um colaborador ao acaso (a pesquisa pára no primeiro encontrado)
+        std::vector<std::string> partes;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            const std::string& nome = lista[distIndice(rng)].nome;
+            partes.push_back(nome.substr(nome.size() / 3, 5));
+        }
+        std::vector<double> amostras;
+        for (const auto& parte : partes) {
+            auto inicio = Relogio::now();
+            volatile size_t r = nomes.procurar(parte).size();
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "procurarParteNome_cifrado", amostras, 1);
+
+        // A mesma cifra declarada sem estrutura: cada nome é decifrado uma vez e fica em cache
+        const Cifra original = cifraDados();
+        Cifra semEstrutura = original;
+        semEstrutura.preservaEstrutura = false;
+        definirCifraDados(semEstrutura);
+        NomesCifrados comCache;
+        comCache.carregar(ficheiro);
+        amostras.clear();
+        for (const auto& parte : partes) {
+            auto inicio = Relogio::now();
+            volatile size_t r = comCache.procurar(parte).size();
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        definirCifraDados(original);
+        imprimirResultado(escala, "procurarParteNome_cacheDecifrada", amostras, 1);
+    }
+    std::remove(ficheiro.c_str());
+
+    // --- Pesquisa ---
+    {
+        std::vector<double> amostras;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            std::string query = std::to_string(lista[distIndice(rng)].id);
+            auto inicio = Relogio::now();
+            volatile int r = encontrarColaborador(lista, query, true);
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "encontrarColaborador_id", amostras, 1);
+
+        amostras.clear();
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            std::string query = lista[distIndice(rng)].nome;
+            auto inicio = Relogio::now();
+            volatile int r = encontrarColaborador(lista, query, false);
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "encontrarColaborador_nome", amostras, 1);
+    }
+
+    // --- Conflitos de férias (a resposta ao prompt é sempre 'S') ---
+    {
+        std::string respostas;
+        for (size_t i = 0; i < cfg.amostras; ++i) respostas += "S\n";
+        RedirecionarConsola silencio(respostas);
+
+        std::vector<double> amostras;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            const Colaborador& colab = lista[distIndice(rng)];
+            int mes = distMes(rng), dia = distDia(rng);
+            auto inicio = Relogio::now();
+            volatile bool r = verificarConflitoFerias(colab, dia, mes, ano, lista);
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "verificarConflitoFerias", amostras, 1);
+    }
+
+    // --- Contagens por intervalo (índice de ausências por departamento) ---
+    {
+        IndiceAusencias indiceAusencias;
+        medirRepetido(escala, "construirIndiceAusencias", cfg.repeticoes, escala, [&] { indiceAusencias.construir(lista); });
+
+        std::string respostas;
+        for (size_t i = 0; i < cfg.amostras; ++i) respostas += "S\n";
+        RedirecionarConsola silencio(respostas);
+
+        std::vector<double> amostras;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            const Colaborador& colab = lista[distIndice(rng)];
+            int mes = distMes(rng), dia = distDia(rng);
+            auto inicio = Relogio::now();
+            volatile bool r = verificarConflitoFerias(colab, dia, mes, ano, lista, &indiceAusencias);
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "verificarConflitoFerias_indice", amostras, 1);
+
+        // Ausências de um departamento num intervalo: percorrendo a lista vs. consultando o índice
+        std::uniform_int_distribution<int> distDiaDoAno(1, 365);
+        std::vector<std::pair<int, int>> intervalos;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            int a = distDiaDoAno(rng), b = distDiaDoAno(rng);
+            intervalos.emplace_back(std::min(a, b), std::max(a, b));
+        }
+        amostras.clear();
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            const std::string& depto = lista[distIndice(rng)].departamento;
+            int totalFerias = 0, totalFaltas = 0;
+            auto inicio = Relogio::now();
+            for (const auto& c : lista) {
+                if (c.departamento != depto) continue;
+                int ferias = 0, faltas = 0;
+                contarAusenciasIntervalo(c, intervalos[i].first, intervalos[i].second, ano, ferias, faltas);
+                totalFerias += ferias;
+                totalFaltas += faltas;
+            }
+            amostras.push_back(nsDesde(inicio));
+        }
+        imprimirResultado(escala, "contarIntervaloDepto_lista", amostras, 1);
+
+        amostras.clear();
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            const std::string& depto = lista[distIndice(rng)].departamento;
+            int ferias = 0, faltas = 0;
+            auto inicio = Relogio::now();
+            indiceAusencias.contarIntervalo(depto, intervalos[i].first, intervalos[i].second, ferias, faltas);
+            amostras.push_back(nsDesde(inicio));
+        }
+        imprimirResultado(escala, "contarIntervaloDepto_indice", amostras, 1);
+    }
+
+    // --- Contagens ---
+    {
+        std::vector<double> amostras;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            const Colaborador& colab = lista[distIndice(rng)];
+            int ferias = 0, faltas = 0;
+            auto inicio = Relogio::now();
+            contarAusencias(colab, ano, ferias, faltas);
+            amostras.push_back(nsDesde(inicio));
+        }
+        imprimirResultado(escala, "contarAusencias", amostras, 1);
+
+        amostras.clear();
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            const Colaborador& colab = lista[distIndice(rng)];
+            int ferias = 0, faltas = 0;
+            int mes = distMes(rng);
+            auto inicio = Relogio::now();
+            contarAusenciasMes(colab, mes, ano, ferias, faltas);
+            amostras.push_back(nsDesde(inicio));
+        }
+        imprimirResultado(escala, "contarAusenciasMes", amostras, 1);
+    }
+
+    // --- Formações: quem concluiu um curso, percorrendo a lista vs. consultando o índice ---
+    {
+        IndiceFormacoes indiceFormacoes;
+        medirRepetido(escala, "construirIndiceFormacoes", cfg.repeticoes, escala, [&] { indiceFormacoes.construir(lista); });
+
+        std::vector<std::string> cursos;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            const Colaborador& colab = lista[distIndice(rng)];
+            cursos.push_back(colab.formacoes.empty() ? std::string("Curso inexistente") : colab.formacoes[0].nome_curso);
+        }
+        std::vector<double> amostras;
+        for (const auto& curso : cursos) {
+            auto inicio = Relogio::now();
+            size_t encontrados = 0;
+            for (const auto& c : lista) {
+                for (const auto& f : c.formacoes) {
+                    if (f.nome_curso == curso && dataTextoParaSerial(f.data_conclusao) != SERIAL_INVALIDO) ++encontrados;
+                }
+            }
+            amostras.push_back(nsDesde(inicio));
+            volatile size_t r = encontrados;
+            (void)r;
+        }
+        imprimirResultado(escala, "procurarCurso_lista", amostras, 1);
+
+        amostras.clear();
+        for (const auto& curso : cursos) {
+            auto inicio = Relogio::now();
+            long c = indiceFormacoes.procurarCurso(curso);
+            volatile size_t r = c < 0 ? 0 : indiceFormacoes.concluidos(static_cast<uint32_t>(c)).size();
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "procurarCurso_indice", amostras, 1);
+
+        // Formações concluídas num mês qualquer do ano anterior (o gerador usa esse ano)
+        amostras.clear();
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            int mes = distMes(rng);
+            int inicioMes = dataParaSerial(1, mes, ano - 1), fimMes = dataParaSerial(diasNoMes(mes, ano - 1), mes, ano - 1);
+            auto inicio = Relogio::now();
+            volatile size_t r = indiceFormacoes.concluidosEntre(inicioMes, fimMes).size();
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "formacoesIntervalo_indice", amostras, 1);
+    }
+
+    // --- Notas: notas com uma palavra, dividindo todos os textos vs. consultando o índice invertido ---
+    {
+        IndiceNotas indiceNotas;
+        medirRepetido(escala, "construirIndiceNotas", cfg.repeticoes, escala, [&] { indiceNotas.construir(lista); });
+
+        // Última palavra de uma nota ao acaso (palavras geradas, por isso pouco frequentes)
+        std::vector<std::string> consultas;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            const Colaborador& colab = lista[distIndice(rng)];
+            std::vector<std::string> palavras = colab.notas.empty() ? std::vector<std::string>() : dividirPalavras(colab.notas[0].texto);
+            consultas.push_back(palavras.empty() ? std::string("inexistente") : palavras.back());
+        }
+        std::vector<double> amostras;
+        for (size_t i = 0; i < consultas.size() && i < 20; ++i) { // A passagem completa é lenta
+            auto inicio = Relogio::now();
+            size_t encontradas = 0;
+            for (const auto& c : lista) {
+                for (const auto& n : c.notas) {
+                    std::vector<std::string> palavras = dividirPalavras(n.texto);
+                    if (std::find(palavras.begin(), palavras.end(), consultas[i]) != palavras.end()) ++encontradas;
+                }
+            }
+            amostras.push_back(nsDesde(inicio));
+            volatile size_t r = encontradas;
+            (void)r;
+        }
+        imprimirResultado(escala, "pesquisarNotas_lista", amostras, 1);
+
+        amostras.clear();
+        for (const auto& consulta : consultas) {
+            auto inicio = Relogio::now();
+            volatile size_t r = indiceNotas.pesquisar(consulta).notas.size();
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "pesquisarNotas_indice", amostras, 1);
+
+        // Palavra presente em todas as notas geradas + filtro de datas (pior caso: lista longa)
+        amostras.clear();
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            int mes = distMes(rng);
+            int inicioMes = dataParaSerial(1, mes, ano), fimMes = dataParaSerial(diasNoMes(mes, ano), mes, ano);
+            auto inicio = Relogio::now();
+            volatile size_t r = indiceNotas.pesquisar("\"observacao sobre\"", inicioMes, fimMes).notas.size();
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "pesquisarNotasFrase_indice", amostras, 1);
+    }
+
+    // --- Validades: formações que expiram até uma data, percorrendo a lista vs. heap de expirações ---
+    {
+        // Todos os cursos gerados valem 24 meses (concluídos no ano anterior, expiram no próximo)
+        MotorValidades validades;
+        for (const auto& colab : lista) {
+            for (const auto& f : colab.formacoes) validades.definirValidade(f.nome_curso, 24);
+        }
+        medirRepetido(escala, "construirValidades", cfg.repeticoes, escala, [&] { validades.construir(lista); });
+
+        std::uniform_int_distribution<int> distDias(0, 14);
+        std::vector<int> limites;
+        for (size_t i = 0; i < cfg.amostras; ++i) limites.push_back(dataParaSerial(1, 1, ano + 1) + distDias(rng));
+
+        std::vector<double> amostras;
+        for (size_t i = 0; i < limites.size() && i < 20; ++i) { // A passagem completa é lenta
+            auto inicio = Relogio::now();
+            size_t encontradas = 0;
+            for (const auto& c : lista) {
+                for (const auto& f : c.formacoes) {
+                    int conclusao = dataTextoParaSerial(f.data_conclusao);
+                    int meses = validades.mesesDe(f.nome_curso);
+                    if (meses > 0 && conclusao != SERIAL_INVALIDO && somarMeses(conclusao, meses) <= limites[i]) ++encontradas;
+                }
+            }
+            amostras.push_back(nsDesde(inicio));
+            volatile size_t r = encontradas;
+            (void)r;
+        }
+        imprimirResultado(escala, "expiramAte_lista", amostras, 1);
+
+        amostras.clear();
+        for (int limite : limites) {
+            auto inicio = Relogio::now();
+            volatile size_t r = validades.expiramAte(limite).size();
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "expiramAte_heap", amostras, 1);
+    }
+
+    // --- Nomes duplicados: lote por blocos + Myers, e verificação de um nome novo ---
+    {
+        std::vector<ParDuplicado> pares;
+        medirRepetido(escala, "detetarDuplicados", cfg.repeticoes, escala, [&] { pares = detetarDuplicados(lista); });
+
+        // Nomes existentes com uma letra trocada (o caso que a verificação exata não apanhava)
+        std::vector<std::string> nomes;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            std::string nome = lista[distIndice(rng)].nome;
+            if (nome.size() > 3) nome[nome.size() / 2] = nome[nome.size() / 2] == 'x' ? 'y' : 'x';
+            nomes.push_back(nome);
+        }
+        std::vector<double> amostras;
+        for (size_t i = 0; i < nomes.size() && i < 50; ++i) { // Sem índice compara com a lista toda
+            auto inicio = Relogio::now();
+            volatile size_t r = procurarNomesSemelhantes(lista, nomes[i]).size();
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "nomesSemelhantes_lista", amostras, 1);
+
+        IndiceNomes indiceNomes;
+        indiceNomes.construir(lista);
+        amostras.clear();
+        for (const auto& nome : nomes) {
+            auto inicio = Relogio::now();
+            volatile size_t r = indiceNomes.semelhantes(nome).size();
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "nomesSemelhantes_indice", amostras, 1);
+    }
+
+    // --- Relatórios (saída descartada) ---
+    {
+        RedirecionarConsola silencio;
+        medirRepetido(escala, "dashboardResumido", cfg.repeticoes, escala, [&] { dashboardResumido(lista); });
+        medirRepetido(escala, "estatisticasDepartamento", cfg.repeticoes, escala, [&] { estatisticasDepartamento(lista); });
+    }
+    medirRepetido(escala, "calcularMapaCalor", cfg.repeticoes, escala, [&] {
+        MapaCalor mapa = calcularMapaCalor(lista, ano);
+        (void)mapa;
+    });
+    {
+        // Referência: o mesmo cálculo a percorrer o calendário de cada colaborador dia a dia
+        const DiasAno naoUteis = diasNaoUteis(ano, FICHEIRO_FERIADOS);
+        const int diasAno = 337 + diasNoMes(2, ano);
+        medirRepetido(escala, "padroesAusencia_diaADia", cfg.repeticoes, escala, [&] {
+            long long total = 0;
+            for (const auto& c : lista) {
+                int episodios = 0, dias = 0;
+                bool emEpisodio = false;
+                for (int d = 1; d <= diasAno; ++d) {
+                    auto it = c.calendario.find(d);
+                    if (it != c.calendario.end() && it->second == TipoMarcacao::FALTA) {
+                        if (!emEpisodio) ++episodios;
+                        emEpisodio = true;
+                        ++dias;
+                    } else if (!naoUteis.test(static_cast<size_t>(d))) {
+                        emEpisodio = false;
+                    }
+                }
+                total += static_cast<long long>(episodios) * episodios * dias;
+            }
+            volatile long long r = total;
+            (void)r;
+        });
+
+        std::vector<PadraoAusencia> padroes;
+        medirRepetido(escala, "padroesAusencia_bitset", cfg.repeticoes, escala,
+                      [&] { padroes = calcularPadroesAusencia(lista, ano, naoUteis); });
+        medirRepetido(escala, "topPadroes_parcial", cfg.repeticoes, padroes.size(), [&] {
+            std::vector<PadraoAusencia> top = topPadroes(padroes, 20, CriterioPadrao::BRADFORD);
+            (void)top;
+        });
+        medirRepetido(escala, "topPadroes_ordenacaoCompleta", cfg.repeticoes, padroes.size(), [&] {
+            std::vector<PadraoAusencia> top = topPadroes(padroes, padroes.size(), CriterioPadrao::BRADFORD);
+            (void)top;
+        });
+    }
+    {
+        RankingAusencias ranking;
+        medirRepetido(escala, "construirRanking", cfg.repeticoes, escala, [&] { ranking.construir(lista); });
+
+        // Referência: voltar a contar a lista inteira e ordenar só os 20 primeiros
+        medirRepetido(escala, "top20_recontagem", cfg.repeticoes, escala, [&] {
+            std::vector<std::pair<int, int>> totais(lista.size());
+            for (size_t i = 0; i < lista.size(); ++i) {
+                int ferias = 0, faltas = 0;
+                contarAusencias(lista[i], ano, ferias, faltas);
+                totais[i] = {ferias + faltas, lista[i].id};
+            }
+            std::partial_sort(totais.begin(), totais.begin() + std::min<size_t>(20, totais.size()), totais.end(),
+                              [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                                  return a.first != b.first ? a.first > b.first : a.second < b.second;
+                              });
+        });
+
+        std::vector<double> amostras;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            auto inicio = Relogio::now();
+            volatile size_t r = ranking.top(20, CriterioRanking::AUSENCIAS).size();
+            amostras.push_back(nsDesde(inicio));
+            (void)r;
+        }
+        imprimirResultado(escala, "top20_ranking", amostras, 1);
+
+        amostras.clear();
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            int id = lista[distIndice(rng)].id;
+            auto inicio = Relogio::now();
+            ranking.alterarDia(id, TipoMarcacao::LIVRE, TipoMarcacao::FALTA);
+            ranking.alterarDia(id, TipoMarcacao::FALTA, TipoMarcacao::LIVRE);
+            amostras.push_back(nsDesde(inicio));
+        }
+        imprimirResultado(escala, "rankingMarcarDesmarcar", amostras, 2);
+    }
+    {
+        // Dois períodos por colaborador (verão e fim de ano), cada um com duas alternativas,
+        // e cobertura mínima de 60% em todos os departamentos
+        MotorCobertura cobertura;
+        cobertura.construir(lista);
+        std::map<std::string, int> porDepartamento;
+        for (const auto& c : lista) ++porDepartamento[c.departamento];
+        for (const auto& par : porDepartamento) cobertura.definirMinimo(par.first, par.second * 6 / 10);
+
+        std::uniform_int_distribution<int> distSemanaVerao(0, 10), distSemanaInverno(0, 5);
+        const int inicioVerao = dataParaDiaDoAno(1, 6, ano), inicioInverno = dataParaDiaDoAno(1, 10, ano);
+        std::vector<PedidoFerias> pedidos;
+        pedidos.reserve(lista.size() * 4);
+        for (const auto& c : lista) {
+            for (int alternativa = 1; alternativa <= 2; ++alternativa) {
+                int verao = inicioVerao + 7 * distSemanaVerao(rng), inverno = inicioInverno + 7 * distSemanaInverno(rng);
+                pedidos.push_back({c.id, alternativa, verao, verao + 11, 1, 0});
+                pedidos.push_back({c.id, alternativa, inverno, inverno + 4, 2, 0});
+            }
+        }
+        DiasAno naoUteis = diasNaoUteis(ano, "");
+        medirRepetido(escala, "planearFerias", cfg.repeticoes, pedidos.size(), [&] {
+            PlanoFerias plano = planearFerias(lista, pedidos, cobertura, naoUteis, ano);
+            (void)plano;
+        });
+    }
+    {
+        std::string entradas;
+        for (int r = 0; r < cfg.repeticoes; ++r) entradas += "6\n" + std::to_string(ano) + "\n";
+        RedirecionarConsola silencio(entradas);
+        medirRepetido(escala, "relatorioMensal", cfg.repeticoes, escala, [&] { relatorioMensal(lista); });
+    }
+    {
+        const std::string ficheiroAusencias = "bench_ausencias.txt";
+        medirRepetido(escala, "exportarAusenciasEmpresa", cfg.repeticoes, escala,
+                      [&] { exportarAusenciasEmpresa(lista, ano, ficheiroAusencias); });
+        std::remove(ficheiroAusencias.c_str());
+
+        medirRepetido(escala, "exportarRelatoriosDepartamentos", cfg.repeticoes, escala,
+                      [&] { exportarRelatoriosDepartamentos(lista, ano); });
+        std::set<std::string> deptos;
+        for (const auto& c : lista) deptos.insert(c.departamento);
+        for (const auto& d : deptos) std::remove((d + "_relatorio_" + std::to_string(ano) + ".txt").c_str());
+    }
+
+    // --- Marcação (altera a lista, por isso fica no fim) ---
+    {
+        RedirecionarConsola silencio;
+        std::vector<double> amostras;
+        for (size_t i = 0; i < cfg.amostras; ++i) {
+            Colaborador& colab = lista[distIndice(rng)];
+            int mes = distMes(rng), dia = distDia(rng);
+            auto inicio = Relogio::now();
+            marcarDia(colab, dia, mes, ano, TipoMarcacao::FALTA);
+            amostras.push_back(nsDesde(inicio));
+        }
+        imprimirResultado(escala, "marcarDia", amostras, 1);
+    }
+
+    // --- Viragem do ano (esvazia os calendários, por isso é a última) ---
+    {
+        ResumoViragem resumo;
+        std::vector<SaldoViragem> saldos;
+        medirRepetido(escala, "calcularViragem", cfg.repeticoes, escala,
+                      [&] { saldos = calcularViragem(lista, PoliticaViragem(), resumo); });
+        medirRepetido(escala, "aplicarViragem", 1, escala, [&] { aplicarViragem(lista, saldos); });
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ConfigBench cfg;
+    if (!lerArgumentos(argc, argv, cfg)) return 1;
+
+    if (!cfg.ficheiroGerar.empty()) {
+        ParametrosGerador p = cfg.gerador;
+        p.numColaboradores = cfg.escalas.front();
+        std::vector<Colaborador> lista = gerarColaboradores(p);
+        guardarDados(lista, cfg.ficheiroGerar);
+        return 0;
+    }
+
+    std::printf("escala,operacao,amostras,itens_por_amostra,total_ms,itens_por_s,p50_us,p90_us,p99_us,max_us\n");
+    for (size_t escala : cfg.escalas) {
+        if (escala == 0) continue;
+        executarEscala(cfg, escala);
+    }
+    return 0;
+}
@@ -5,7 +5,14 @@
 #include <cmath>
 #include <algorithm>
 #include <limits>
+#include <ctime>
+#include <atomic>
+#include <charconv>
+#include <cctype>
 #include "cores.h" 
+#include "metricas.h"
+#include "arquivo.h"
+#include "ausencias.h"
 
 // ===============================================
 // FUNÇÕES AUXILIARES DE DATA
@@ -68,6 +75,156 @@ int dataParaDiaDoAno(int dia, int mes, int ano) {
     return diaDoAno;
 }
 
+// Converte o dia do ano (1 a 366) de volta para dia e mês
+bool diaDoAnoParaData(int diaDoAno, int ano, int& dia, int& mes) {
+    if (diaDoAno < 1 || diaDoAno > (isBissexto(ano) ? 366 : 365)) return false;
+    mes = 1;
+    while (diaDoAno > diasNoMes(mes, ano)) {
+        diaDoAno -= diasNoMes(mes, ano);
+        ++mes;
+    }
+    dia = diaDoAno;
+    return true;
+}
+
+// Dias desde 01/01/1970 (algoritmo "days from civil" de H. Hinnant, válido para o calendário gregoriano)
+int dataParaSerial(int dia, int mes, int ano) {
+    const int a = ano - (mes <= 2 ? 1 : 0);
+    const int era = (a >= 0 ? a : a - 399) / 400;
+    const int anoDaEra = a - era * 400;
+    const int diaDoAnoMarco = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+    const int diaDaEra = anoDaEra * 365 + anoDaEra / 4 - anoDaEra / 100 + diaDoAnoMarco;
+    return era * 146097 + diaDaEra - 719468;
+}
+
+void serialParaData(int serial, int& dia, int& mes, int& ano) {
+    const int z = serial + 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const int diaDaEra = z - era * 146097;
+    const int anoDaEra = (diaDaEra - diaDaEra / 1460 + diaDaEra / 36524 - diaDaEra / 146096) / 365;
+    const int diaDoAnoMarco = diaDaEra - (365 * anoDaEra + anoDaEra / 4 - anoDaEra / 100);
+    const int mp = (5 * diaDoAnoMarco + 2) / 153;
+    dia = diaDoAnoMarco - (153 * mp + 2) / 5 + 1;
+    mes = mp < 10 ? mp + 3 : mp - 9;
+    ano = anoDaEra + era * 400 + (mes <= 2 ? 1 : 0);
+}
+
+bool lerDataTexto(const std::string& texto, int& dia, int& mes, int& ano) {
+    int campos[3] = {0, 0, 0};
+    int campo = 0, digitos = 0;
+    for (char c : texto) {
+        if (c >= '0' && c <= '9') {
+            if (++digitos > 4) return false;
+            campos[campo] = campos[campo] * 10 + (c - '0');
+        } else if (c == '/' && digitos > 0 && campo < 2) {
+            ++campo;
+            digitos = 0;
+        } else {
+            return false;
+        }
+    }
+    if (campo != 2 || digitos == 0) return false;
+    dia = campos[0];
+    mes = campos[1];
+    ano = campos[2];
+    return dataValida(dia, mes, ano);
+}
+
+int dataTextoParaSerial(const std::string& texto) {
+    int dia = 0, mes = 0, ano = 0;
+    return lerDataTexto(texto, dia, mes, ano) ? dataParaSerial(dia, mes, ano) : SERIAL_INVALIDO;
+}
+
+int serialHoje() {
+    std::time_t agora = std::time(nullptr);
+    std::tm local = *std::localtime(&agora);
+    return dataParaSerial(local.tm_mday, local.tm_mon + 1, local.tm_year + 1900);
+}
+
+int somarMeses(int serial, int meses) {
+    int dia = 0, mes = 0, ano = 0;
+    serialParaData(serial, dia, mes, ano);
+    int total = ano * 12 + (mes - 1) + meses;
+    ano = total / 12;
+    mes = total % 12 + 1;
+    return dataParaSerial(std::min(dia, diasNoMes(mes, ano)), mes, ano);
+}
+
+// Retorna o ano atual do sistema
+// As contagens perguntam o ano a cada chamada (ver calendarioDoAno) e localtime é caro (lê o fuso
+// horário), por isso o ano fica em cache até à meia-noite de 1 de janeiro seguinte
+int obterAnoAtual() {
+    static std::atomic<std::time_t> fimDoAno{0};
+    static std::atomic<int> anoEmCache{0};
+    std::time_t t = std::time(nullptr);
+    if (t < fimDoAno.load(std::memory_order_acquire)) return anoEmCache.load(std::memory_order_relaxed);
+
+    std::tm* tm_local = std::localtime(&t);
+    int ano = tm_local->tm_year + 1900;
+    std::tm proximoAno = {};
+    proximoAno.tm_year = tm_local->tm_year + 1;
+    proximoAno.tm_mday = 1;
+    proximoAno.tm_isdst = -1;
+    anoEmCache.store(ano, std::memory_order_relaxed);
+    fimDoAno.store(std::mktime(&proximoAno), std::memory_order_release);
+    return ano;
+}
+
+// ===============================================
+// DIAS EM UNIDADES
+// ===============================================
+
+// As frações de dia têm uma escrita decimal exata com 3 casas
+static_assert(1000 % UNIDADES_POR_DIA == 0, "UNIDADES_POR_DIA tem de dividir 1000");
+
+std::string formatarDias(long long unidades) {
+    if (unidades % UNIDADES_POR_DIA == 0) return std::to_string(unidades / UNIDADES_POR_DIA); // Dias inteiros
+    std::string texto = unidades < 0 ? "-" : "";
+    const unsigned long long valor = unidades < 0 ? 0ULL - static_cast<unsigned long long>(unidades) : static_cast<unsigned long long>(unidades);
+    texto += std::to_string(valor / UNIDADES_POR_DIA);
+
+    const int milesimas = static_cast<int>(valor % UNIDADES_POR_DIA) * (1000 / UNIDADES_POR_DIA);
+    if (milesimas != 0) {
+        char casas[4] = {static_cast<char>('0' + milesimas / 100), static_cast<char>('0' + milesimas / 10 % 10),
+                         static_cast<char>('0' + milesimas % 10), '\0'};
+        size_t tamanho = 3;
+        while (casas[tamanho - 1] == '0') --tamanho;
+        texto += '.';
+        texto.append(casas, tamanho);
+    }
+    return texto;
+}
+
+bool lerDias(const std::string& texto, int& unidades) {
+    const char* p = texto.data();
+    const char* fim = p + texto.size();
+    const bool negativo = p < fim && *p == '-';
+    if (negativo) ++p;
+    if (p == fim || !std::isdigit(static_cast<unsigned char>(*p))) return false;
+
+    int dias = 0;
+    auto r = std::from_chars(p, fim, dias);
+    if (r.ec != std::errc() || dias > std::numeric_limits<int>::max() / UNIDADES_POR_DIA - 1) return false;
+    p = r.ptr;
+
+    int milesimas = 0;
+    if (p < fim && *p == '.') {
+        ++p;
+        int casas = 0;
+        for (; p < fim && casas < 3 && std::isdigit(static_cast<unsigned char>(*p)); ++p, ++casas) {
+            milesimas = milesimas * 10 + (*p - '0');
+        }
+        if (casas == 0) return false;
+        for (; casas < 3; ++casas) milesimas *= 10;
+    }
+    // Só frações que são um número inteiro de unidades (0.5 sim, 0.3 não)
+    if (p != fim || milesimas % (1000 / UNIDADES_POR_DIA) != 0) return false;
+
+    const int total = dias * UNIDADES_POR_DIA + milesimas / (1000 / UNIDADES_POR_DIA);
+    unidades = negativo ? -total : total;
+    return true;
+}
+
 // Retorna o dia da semana (0=Domingo, 1=Segunda, ..., 6=Sábado) usando o Algoritmo Zeller
 int diaSemana(int dia, int mes, int ano) {
     // Algoritmo Zeller para Geração Gregoriana do Calendário
@@ -101,11 +258,26 @@ int diaSemana(int dia, int mes, int ano) {
 // FUNÇÕES DE MARCAÇÃO
 // ===============================================
 
-// Marcar um dia específico para um colaborador com um tipo de marcação
-void marcarDia(Colaborador& colab, int dia, int mes, int ano, TipoMarcacao tipo) {
+int unidadesDoDia(const Colaborador& colab, int diaDoAno) {
+    auto parcial = colab.parciais.find(diaDoAno);
+    return parcial != colab.parciais.end() ? parcial->second : UNIDADES_POR_DIA;
+}
+
+// Unidades que a marcação de um dia gastou do saldo de férias (0 se não desconta)
+static int unidadesDescontadas(const Colaborador& colab, int diaDoAno) {
+    auto it = colab.calendario.find(diaDoAno);
+    if (it == colab.calendario.end() || !temTipo(MASCARA_DESCONTA_SALDO, it->second)) return 0;
+    return unidadesDoDia(colab, diaDoAno);
+}
+
+// Aplica uma marcação sem escrever na consola. É aqui (e em aplicarDesmarcacao) que o saldo de
+// férias muda: a marcação desconta as suas unidades e devolve as da marcação que substitui.
+ResultadoMarcacao aplicarMarcacao(Colaborador& colab, int dia, int mes, int ano, TipoMarcacao tipo, int unidades) {
     if (!dataValida(dia, mes, ano)) {
-        std::cout << COR_VERMELHA << "ERRO: Data invalida. Nao foi possivel marcar o dia.\n" << RESET_COR;
-        return;
+        return ResultadoMarcacao::DATA_INVALIDA;
+    }
+    if (unidades < 1 || unidades > UNIDADES_POR_DIA) {
+        return ResultadoMarcacao::DURACAO_INVALIDA;
     }
 
     int diaDoAno = dataParaDiaDoAno(dia, mes, ano);
@@ -113,50 +285,94 @@ void marcarDia(Colaborador& colab, int dia, int mes, int ano, TipoMarcacao tipo)
 
     // O fim de semana (Domingo=0, Sábado=6) não deve ser marcável como Férias/Falta
     if (diaDaSemana == 0 || diaDaSemana == 6) {
-        std::cout << COR_AMARELA << "AVISO: O dia " << dia << "/" << mes << " e um Fim de Semana. Nao e necessario marcar Ferias/Falta.\n" << RESET_COR;
         // Se for Fim de Semana, registamos no mapa como FIM_SEMANA
+        colab.saldo_ferias += unidadesDescontadas(colab, diaDoAno);
         colab.calendario[diaDoAno] = TipoMarcacao::FIM_SEMANA;
-        return;
+        colab.parciais.erase(diaDoAno);
+        colab.modificado = true;
+        return ResultadoMarcacao::FIM_SEMANA;
     }
 
+    // Verificação de férias restantes (apenas para os tipos que descontam no saldo); as unidades
+    // da marcação que é substituída voltam ao saldo
+    const int devolvidas = unidadesDescontadas(colab, diaDoAno);
+    const int descontadas = temTipo(MASCARA_DESCONTA_SALDO, tipo) ? unidades : 0;
+    if (descontadas > 0 && colab.saldo_ferias + devolvidas < descontadas) {
+        return ResultadoMarcacao::SEM_FERIAS;
+    }
+    colab.saldo_ferias += devolvidas - descontadas;
+    const bool marcavel = temTipo(MASCARA_MARCAVEL, tipo);
+    colab.calendario[diaDoAno] = marcavel ? tipo : TipoMarcacao::LIVRE;
+    if (marcavel && unidades < UNIDADES_POR_DIA) {
+        colab.parciais[diaDoAno] = static_cast<uint8_t>(unidades);
+    } else if (!colab.parciais.empty()) {
+        colab.parciais.erase(diaDoAno);
+    }
+    colab.modificado = true;
+    return ResultadoMarcacao::OK;
+}
+
+// Aplica uma desmarcação sem escrever na consola (as férias desmarcadas voltam ao saldo)
+ResultadoMarcacao aplicarDesmarcacao(Colaborador& colab, int dia, int mes, int ano) {
+    if (!dataValida(dia, mes, ano)) {
+        return ResultadoMarcacao::DATA_INVALIDA;
+    }
+    int diaDoAno = dataParaDiaDoAno(dia, mes, ano);
+    const int devolvidas = unidadesDescontadas(colab, diaDoAno);
+    if (colab.calendario.erase(diaDoAno) == 0) {
+        return ResultadoMarcacao::NAO_MARCADO;
+    }
+    colab.parciais.erase(diaDoAno);
+    colab.saldo_ferias += devolvidas;
+    colab.modificado = true;
+    return ResultadoMarcacao::OK;
+}
+
+// Marcar um dia específico para um colaborador com um tipo de marcação
+void marcarDia(Colaborador& colab, int dia, int mes, int ano, TipoMarcacao tipo, int unidades) {
     // Se o dia já estiver marcado, avisa
-    if (colab.calendario.count(diaDoAno)) {
-        TipoMarcacao atual = colab.calendario[diaDoAno];
-        if (atual != TipoMarcacao::LIVRE) {
+    if (dataValida(dia, mes, ano)) {
+        auto it = colab.calendario.find(dataParaDiaDoAno(dia, mes, ano));
+        int ds = diaSemana(dia, mes, ano);
+        if (it != colab.calendario.end() && it->second != TipoMarcacao::LIVRE && ds != 0 && ds != 6) {
             std::cout << COR_AMARELA << "AVISO: O dia ja estava marcado. Sobrescrevendo...\n" << RESET_COR;
         }
     }
-    
-    // Verificação de férias restantes (apenas para FERIAS)
-    if (tipo == TipoMarcacao::FERIAS) {
-        if (colab.dias_ferias_restantes > 0) {
-            colab.calendario[diaDoAno] = tipo;
-            std::cout << COR_VERDE << "Dia " << dia << "/" << mes << " marcado como FERIAS.\n" << RESET_COR;
-        } else {
+
+    switch (aplicarMarcacao(colab, dia, mes, ano, tipo, unidades)) {
+        case ResultadoMarcacao::DATA_INVALIDA:
+            std::cout << COR_VERMELHA << "ERRO: Data invalida. Nao foi possivel marcar o dia.\n" << RESET_COR;
+            break;
+        case ResultadoMarcacao::DURACAO_INVALIDA:
+            std::cout << COR_VERMELHA << "ERRO: A duracao tem de ser de 1 a " << UNIDADES_POR_DIA << " horas.\n" << RESET_COR;
+            break;
+        case ResultadoMarcacao::FIM_SEMANA:
+            std::cout << COR_AMARELA << "AVISO: O dia " << dia << "/" << mes << " e um Fim de Semana. Nao e necessario marca-lo.\n" << RESET_COR;
+            break;
+        case ResultadoMarcacao::SEM_FERIAS:
             std::cout << COR_VERMELHA << "ERRO: Nao ha dias de ferias restantes para marcar.\n" << RESET_COR;
-        }
-    } else if (tipo == TipoMarcacao::FALTA) {
-        colab.calendario[diaDoAno] = tipo;
-        std::cout << COR_VERDE << "Dia " << dia << "/" << mes << " marcado como FALTA.\n" << RESET_COR;
-    } else {
-         colab.calendario[diaDoAno] = TipoMarcacao::LIVRE;
-         std::cout << COR_VERDE << "Dia " << dia << "/" << mes << " marcado como LIVRE.\n" << RESET_COR;
+            break;
+        default:
+            std::cout << COR_VERDE << "Dia " << dia << "/" << mes << " marcado como "
+                      << propriedadesMarcacao(temTipo(MASCARA_MARCAVEL, tipo) ? tipo : TipoMarcacao::LIVRE).nome;
+            if (unidades < UNIDADES_POR_DIA) std::cout << " (" << unidades << " de " << UNIDADES_POR_DIA << " horas)";
+            std::cout << ".\n" << RESET_COR;
+            break;
     }
 }
 
 // Desmarcar um dia
 void desmarcarDia(Colaborador& colab, int dia, int mes, int ano) {
-    if (!dataValida(dia, mes, ano)) {
-        std::cout << COR_VERMELHA << "ERRO: Data invalida.\n" << RESET_COR;
-        return;
-    }
-    int diaDoAno = dataParaDiaDoAno(dia, mes, ano);
-
-    if (colab.calendario.count(diaDoAno)) {
-        colab.calendario.erase(diaDoAno);
-        std::cout << COR_VERDE << "Dia " << dia << "/" << mes << " desmarcado (removido do calendario).\n" << RESET_COR;
-    } else {
-        std::cout << COR_AMARELA << "AVISO: O dia " << dia << "/" << mes << " nao estava marcado.\n" << RESET_COR;
+    switch (aplicarDesmarcacao(colab, dia, mes, ano)) {
+        case ResultadoMarcacao::DATA_INVALIDA:
+            std::cout << COR_VERMELHA << "ERRO: Data invalida.\n" << RESET_COR;
+            break;
+        case ResultadoMarcacao::NAO_MARCADO:
+            std::cout << COR_AMARELA << "AVISO: O dia " << dia << "/" << mes << " nao estava marcado.\n" << RESET_COR;
+            break;
+        default:
+            std::cout << COR_VERDE << "Dia " << dia << "/" << mes << " desmarcado (removido do calendario).\n" << RESET_COR;
+            break;
     }
 }
 
@@ -164,32 +380,37 @@ void desmarcarDia(Colaborador& colab, int dia, int mes, int ano) {
 // FUNÇÕES DE VISUALIZAÇÃO E RELATÓRIO
 // ===============================================
 
-// Função para obter o caractere de exibição
-char getCharMarcacao(TipoMarcacao tipo) {
-    switch (tipo) {
-        case TipoMarcacao::FERIAS: return 'F';
-        case TipoMarcacao::FALTA: return 'X';
-        case TipoMarcacao::FIM_SEMANA:
-        case TipoMarcacao::LIVRE:
-        case TipoMarcacao::NAO_MARCADO:
-        default: return ' ';
+// Legenda com os tipos marcáveis, pela ordem da tabela
+std::string legendaMarcacoes() {
+    std::string legenda;
+    for (const auto& p : PROPRIEDADES_MARCACAO) {
+        if (!p.marcavel) continue;
+        if (!legenda.empty()) legenda += ", ";
+        legenda += p.simbolo;
+        legenda += '=';
+        legenda += p.nome;
     }
+    return legenda;
 }
 
-// Função para obter a cor do caractere de exibição
-const char* getCorMarcacao(TipoMarcacao tipo) {
-    switch (tipo) {
-        case TipoMarcacao::FERIAS: return COR_AZUL.c_str();
-        case TipoMarcacao::FALTA: return COR_VERMELHA.c_str();
-        case TipoMarcacao::FIM_SEMANA: return COR_CIANO.c_str();
-        case TipoMarcacao::LIVRE: return COR_VERDE.c_str();
-        case TipoMarcacao::NAO_MARCADO:  
-        default: return RESET_COR.c_str();
+// Visualiza o calendário mensal detalhado do colaborador
+const std::map<int, TipoMarcacao>& calendarioDoAno(const Colaborador& colab, int ano, std::map<int, TipoMarcacao>& arquivado) {
+    if (ano < obterAnoAtual() && lerCalendarioArquivado(colab.id, ano, arquivado)) {
+        return arquivado;
     }
+    return colab.calendario;
+}
 
+const std::map<int, TipoMarcacao>& calendarioComParciais(const Colaborador& colab, int ano, std::map<int, TipoMarcacao>& arquivado,
+                                                         ParciaisDia& parciaisArquivados, const ParciaisDia*& parciais) {
+    if (ano < obterAnoAtual() && lerCalendarioArquivado(colab.id, ano, arquivado, &parciaisArquivados)) {
+        parciais = &parciaisArquivados;
+        return arquivado;
+    }
+    parciais = &colab.parciais;
+    return colab.calendario;
 }
 
-// Visualiza o calendário mensal detalhado do colaborador
 void visualizarCalendario(const Colaborador& colab, int mes, int ano) {
     if (!dataValida(1, mes, ano)) {
         std::cout << COR_VERMELHA << "ERRO: Mes/Ano invalido para visualizacao.\n" << RESET_COR;
@@ -199,6 +420,11 @@ void visualizarCalendario(const Colaborador& colab, int mes, int ano) {
     int totalDias = diasNoMes(mes, ano);
     int primeiroDiaDoMes = diaSemana(1, mes, ano); // 0=Domingo, 1=Segunda
     int diaDoAnoInicial = dataParaDiaDoAno(1, mes, ano);
+    std::map<int, TipoMarcacao> arquivado;
+    ParciaisDia parciaisArquivados;
+    const ParciaisDia* parciais = nullptr;
+    const auto& calendario = calendarioComParciais(colab, ano, arquivado, parciaisArquivados, parciais);
+    const bool comParciais = !parciais->empty(); // Sem dias parciais, nada mais é consultado
 
     std::cout << COR_CIANO << "\n--- Calendario do " << nomeMes(mes) << " do ano " << ano << " ---\n" << RESET_COR;
     std::cout << COR_AZUL << std::setw(4) << "Dom" << std::setw(4) << "Seg" << std::setw(4) << "Ter" 
@@ -220,8 +446,8 @@ void visualizarCalendario(const Colaborador& colab, int mes, int ano) {
         TipoMarcacao tipo = TipoMarcacao::LIVRE;
         
         // Verifica se há marcação
-        auto it = colab.calendario.find(diaDoAno);
-        if (it != colab.calendario.end()) {
+        auto it = calendario.find(diaDoAno);
+        if (it != calendario.end()) {
             tipo = it->second;
         } else {
             // Se não está no mapa, verifica se é Fim de Semana (para o destacar)
@@ -233,8 +459,11 @@ void visualizarCalendario(const Colaborador& colab, int mes, int ano) {
             }
         }
 
-        char marcador = getCharMarcacao(tipo);
-        const char* cor = getCorMarcacao(tipo);
+        char marcador = simboloCalendario(tipo);
+        const std::string& cor = *propriedadesMarcacao(tipo).cor;
+        if (comParciais && marcador != ' ' && parciais->count(diaDoAno) != 0) {
+            marcador = static_cast<char>(std::tolower(static_cast<unsigned char>(marcador))); // Parte do dia
+        }
         
         std::cout << cor << std::setw(2) << diaAtual;
         
@@ -259,20 +488,74 @@ void visualizarCalendario(const Colaborador& colab, int mes, int ano) {
         std::cout << "\n";
     }
     std::cout << "--------------------------------\n";
-    std::cout << "Legenda: F=Ferias, X=Falta \n";
+    std::cout << "Legenda: " << legendaMarcacoes() << " (minuscula = parte do dia)\n";
 }
 
-// Conta o total de ausências (Férias e Faltas) num determinado ano
+// Os dias parciais entre dois dias do ano contam só as unidades que usam: tira-se a parte que falta
+// a cada um às contagens feitas em dias inteiros
+static void descontarParciais(const std::map<int, TipoMarcacao>& calendario, const ParciaisDia& parciais, int inicio, int fim,
+                              int& totalFerias, int& totalFaltas) {
+    auto ate = parciais.upper_bound(fim);
+    for (auto it = parciais.lower_bound(inicio); it != ate; ++it) {
+        auto marcado = calendario.find(it->first);
+        if (marcado == calendario.end()) continue;
+        const int emFalta = UNIDADES_POR_DIA - it->second;
+        totalFerias -= emFalta * contaTipo(MASCARA_FERIAS, marcado->second);
+        totalFaltas -= emFalta * contaTipo(MASCARA_FALTAS, marcado->second);
+    }
+}
+
+int unidadesMarcadas(const Colaborador& colab, MascaraTipos mascara) {
+    int dias = 0;
+    for (const auto& par : colab.calendario) {
+        dias += contaTipo(mascara, par.second);
+    }
+    int unidades = dias * UNIDADES_POR_DIA;
+    for (const auto& parcial : colab.parciais) {
+        auto marcado = colab.calendario.find(parcial.first);
+        if (marcado != colab.calendario.end()) unidades -= (UNIDADES_POR_DIA - parcial.second) * contaTipo(mascara, marcado->second);
+    }
+    return unidades;
+}
+
+// Conta o total de ausências (férias e outras ausências) num determinado ano
 void contarAusencias(const Colaborador& colab, int ano, int& totalFerias, int& totalFaltas) {
     totalFerias = 0;
     totalFaltas = 0;
 
-    for (const auto& par : colab.calendario) {
-        if (par.second == TipoMarcacao::FERIAS) {
-            totalFerias++;
-        } else if (par.second == TipoMarcacao::FALTA) {
-            totalFaltas++;
-        }
+    std::map<int, TipoMarcacao> arquivado;
+    ParciaisDia parciaisArquivados;
+    const ParciaisDia* parciais = nullptr;
+    const auto& calendario = calendarioComParciais(colab, ano, arquivado, parciaisArquivados, parciais);
+    for (const auto& par : calendario) {
+        totalFerias += contaTipo(MASCARA_FERIAS, par.second);
+        totalFaltas += contaTipo(MASCARA_FALTAS, par.second);
+    }
+    totalFerias *= UNIDADES_POR_DIA;
+    totalFaltas *= UNIDADES_POR_DIA;
+    if (!parciais->empty()) {
+        descontarParciais(calendario, *parciais, 1, 366, totalFerias, totalFaltas);
+    }
+}
+
+// Conta as ausências entre dois dias do ano (inclusive)
+void contarAusenciasIntervalo(const Colaborador& colab, int diaDoAnoInicio, int diaDoAnoFim, int ano, int& totalFerias, int& totalFaltas) {
+    totalFerias = 0;
+    totalFaltas = 0;
+
+    std::map<int, TipoMarcacao> arquivado;
+    ParciaisDia parciaisArquivados;
+    const ParciaisDia* parciais = nullptr;
+    const auto& calendario = calendarioComParciais(colab, ano, arquivado, parciaisArquivados, parciais);
+    auto fim = calendario.upper_bound(diaDoAnoFim);
+    for (auto it = calendario.lower_bound(diaDoAnoInicio); it != fim; ++it) {
+        totalFerias += contaTipo(MASCARA_FERIAS, it->second);
+        totalFaltas += contaTipo(MASCARA_FALTAS, it->second);
+    }
+    totalFerias *= UNIDADES_POR_DIA;
+    totalFaltas *= UNIDADES_POR_DIA;
+    if (!parciais->empty()) {
+        descontarParciais(calendario, *parciais, diaDoAnoInicio, diaDoAnoFim, totalFerias, totalFaltas);
     }
 }
 
@@ -284,20 +567,7 @@ void contarAusenciasMes(const Colaborador& colab, int mes, int ano, int& totalFe
     if (!dataValida(1, mes, ano)) return;
 
     int diaDoAnoInicial = dataParaDiaDoAno(1, mes, ano);
-    int totalDias = diasNoMes(mes, ano);
-
-    for (int diaDoMes = 1; diaDoMes <= totalDias; ++diaDoMes) {
-        int diaDoAno = diaDoAnoInicial + diaDoMes - 1;
-        
-        auto it = colab.calendario.find(diaDoAno);
-        if (it != colab.calendario.end()) {
-            if (it->second == TipoMarcacao::FERIAS) {
-                totalFerias++;
-            } else if (it->second == TipoMarcacao::FALTA) {
-                totalFaltas++;
-            }
-        }
-    }
+    contarAusenciasIntervalo(colab, diaDoAnoInicial, diaDoAnoInicial + diasNoMes(mes, ano) - 1, ano, totalFerias, totalFaltas);
 }
 
 // Conta o total de ausências num determinado mês e ano (alias)
@@ -306,9 +576,20 @@ void contarAusenciasMensal(const Colaborador& colab, int mes, int ano, int& tota
 }
 
 // Verificar Conflito de Férias
-bool verificarConflitoFerias(const Colaborador& colab, int dia, int mes, int ano, const std::vector<Colaborador>& todosColaboradores) {
+bool verificarConflitoFerias(const Colaborador& colab, int dia, int mes, int ano, const std::vector<Colaborador>& todosColaboradores,
+                             const IndiceAusencias* indice) {
+    MEDIR_ESCOPO(Metrica::VERIFICAR_CONFLITO);
     if (!dataValida(dia, mes, ano)) return false;
     int diaDoAno = dataParaDiaDoAno(dia, mes, ano);
+
+    // O índice diz quantos colegas do departamento estão de férias no dia (o próprio não conta).
+    // "Férias" é MASCARA_FERIAS, tal como nas contagens do índice, e um dia parcial conta como um.
+    if (indice != nullptr) {
+        auto proprio = colab.calendario.find(diaDoAno);
+        int doProprio = proprio != colab.calendario.end() ? contaTipo(MASCARA_FERIAS, proprio->second) : 0;
+        if (indice->feriasNoDia(colab.departamento, diaDoAno) - doProprio <= 0) return false;
+    }
+
     // Verificar se outros colaboradores do mesmo departamento já têm férias marcadas neste dia
     for (const auto& outroColab : todosColaboradores) {
         // Ignorar o próprio colaborador
@@ -318,7 +599,8 @@ bool verificarConflitoFerias(const Colaborador& colab, int dia, int mes, int ano
         if (outroColab.departamento == colab.departamento) {
             // Verificar se este colaborador tem férias marcadas no mesmo dia
             auto it = outroColab.calendario.find(diaDoAno);
-            if (it != outroColab.calendario.end() && it->second == TipoMarcacao::FERIAS) {
+            if (it != outroColab.calendario.end() && temTipo(MASCARA_FERIAS, it->second)) {
+                CONTAR_EVENTO(Contador::CONFLITOS_ENCONTRADOS, 1);
                 std::cout << COR_AMARELA << "AVISO: O colaborador '" << outroColab.nome 
                           << "' do mesmo departamento ja tem ferias marcadas neste dia.\n" << RESET_COR;
                 std::cout << COR_AZUL << "Deseja proceder? (S/N): " << RESET_COR;
@@ -6,19 +6,27 @@
 #include <vector>
 #include <iostream>
 #include <iomanip>
-
-// --- Enumeração para Tipo de Marcação ---
-
-enum class TipoMarcacao {
-    LIVRE,       //' ' - Dia normal de trabalho
-    FERIAS,     // 'F' - Dia de férias
-    FALTA,      // 'X' - Dia de falta
-    FIM_SEMANA, // '' - Fim de semana (normalmente não é marcável pelo utilizador)
-    NAO_MARCADO // 'U' - Não marcado (usado internamente)
+#include "marcacoes.h"
+
+// --- Tipo de Marcação (marcacoes.h) ---
+
+// Dias marcados só em parte (meio dia, algumas horas): dia do ano -> unidades usadas
+// (1 a UNIDADES_POR_DIA - 1). Um dia do calendário sem entrada aqui é um dia inteiro.
+using ParciaisDia = std::map<int, uint8_t>;
+
+// Resultado de uma marcação (usado quando não há consola, ex: modo servidor)
+enum class ResultadoMarcacao {
+    OK,
+    DATA_INVALIDA,
+    FIM_SEMANA,     // O dia foi registado como FIM_SEMANA
+    SEM_FERIAS,     // Não há dias de férias restantes
+    NAO_MARCADO,    // Desmarcar um dia que não estava marcado
+    DURACAO_INVALIDA // Unidades fora de 1 a UNIDADES_POR_DIA
 };
 
 // Declaração antecipada da estrutura Colaborador para uso nas funções
 struct Colaborador;
+struct IndiceAusencias; // ausencias.h
 
 // --- Funções de Datas e Conversão ---
 
@@ -39,21 +47,83 @@ bool dataValida(int dia, int mes, int ano);
 // Converte a data (dia, mês, ano) no dia do ano (1 a 366)
 int dataParaDiaDoAno(int dia, int mes, int ano);
 
+// Converte o dia do ano (1 a 366) de volta para dia e mês (retorna false se não existir nesse ano)
+bool diaDoAnoParaData(int diaDoAno, int ano, int& dia, int& mes);
+
+// Datas em série: dias desde 01/01/1970. Comparar/ordenar datas passa a ser comparar inteiros.
+const int SERIAL_INVALIDO = -(1 << 30);
+int dataParaSerial(int dia, int mes, int ano);
+void serialParaData(int serial, int& dia, int& mes, int& ano);
+
+// Lê "dd/mm/aaaa" (o formato das formações e notas). Retorna false se o texto não for uma data válida.
+bool lerDataTexto(const std::string& texto, int& dia, int& mes, int& ano);
+
+// "dd/mm/aaaa" -> data em série (SERIAL_INVALIDO se não for uma data válida)
+int dataTextoParaSerial(const std::string& texto);
+
+// Data de hoje em série (hora local)
+int serialHoje();
+
+// Soma meses a uma data em série; o dia passa ao último do mês se não existir (31/01 + 1 = 28/02 ou 29/02)
+int somarMeses(int serial, int meses);
+
+// Retorna o ano atual do sistema
+int obterAnoAtual();
+
+// --- Dias em Unidades ---
+
+// Unidades -> dias com as casas decimais precisas ("22", "21.5", "0.125")
+std::string formatarDias(long long unidades);
+
+// "21.5" -> unidades. Retorna false se o texto não for um número de dias múltiplo de uma unidade.
+bool lerDias(const std::string& texto, int& unidades);
+
 // --- Funções de Marcação e Visualização ---
 
 // Marcar um dia específico para um colaborador com um tipo de marcação
-// (Principal ponto para validar se o dia é um Fim de Semana)
-void marcarDia(Colaborador& colab, int dia, int mes, int ano, TipoMarcacao tipo);
+// (Principal ponto para validar se o dia é um Fim de Semana). Com menos de UNIDADES_POR_DIA
+// unidades o dia fica marcado só em parte (meio dia, algumas horas).
+void marcarDia(Colaborador& colab, int dia, int mes, int ano, TipoMarcacao tipo, int unidades = UNIDADES_POR_DIA);
 
 // Desmarcar um dia, voltando-o a LIVRE
 void desmarcarDia(Colaborador& colab, int dia, int mes, int ano);
 
+// Versões sem output de marcarDia/desmarcarDia: aplicam as mesmas regras e retornam o resultado
+ResultadoMarcacao aplicarMarcacao(Colaborador& colab, int dia, int mes, int ano, TipoMarcacao tipo,
+                                  int unidades = UNIDADES_POR_DIA);
+ResultadoMarcacao aplicarDesmarcacao(Colaborador& colab, int dia, int mes, int ano);
+
+// Calendário do colaborador num ano: o do ano atual (e seguintes) está em memória; o de um ano
+// fechado vem do arquivo (arquivo.h) e é copiado para 'arquivado'. Sem arquivo, usa o de memória.
+const std::map<int, TipoMarcacao>& calendarioDoAno(const Colaborador& colab, int ano, std::map<int, TipoMarcacao>& arquivado);
+
+// Como calendarioDoAno, com os dias parciais desse calendário: os do colaborador ou, para um ano
+// arquivado, os do arquivo (copiados para 'parciaisArquivados')
+const std::map<int, TipoMarcacao>& calendarioComParciais(const Colaborador& colab, int ano, std::map<int, TipoMarcacao>& arquivado,
+                                                         ParciaisDia& parciaisArquivados, const ParciaisDia*& parciais);
+
+// Unidades marcadas num dia do calendário em memória (UNIDADES_POR_DIA se não for um dia parcial)
+int unidadesDoDia(const Colaborador& colab, int diaDoAno);
+
 // Visualiza o calendário mensal detalhado do colaborador
 void visualizarCalendario(const Colaborador& colab, int mes, int ano);
 
-// Conta o total de ausências (Férias e Faltas) num determinado ano
+// "F=Ferias, X=Falta, ..." com os tipos marcáveis (legenda do calendário e mensagens de erro)
+std::string legendaMarcacoes();
+
+// Unidades do calendário em memória com um tipo da máscara (os dias parciais contam só o que usam)
+int unidadesMarcadas(const Colaborador& colab, MascaraTipos mascara);
+
+// As contagens de ausências são em unidades (UNIDADES_POR_DIA por dia inteiro). Os dias inteiros
+// são contados de uma vez; só os dias parciais do ano em memória são vistos um a um.
+
+// Conta o total de ausências num determinado ano: férias e as outras ausências (faltas, baixas, licenças)
 void contarAusencias(const Colaborador& colab, int ano, int& totalFerias, int& totalFaltas);
 
+// Conta as ausências entre dois dias do ano (inclusive), por pesquisa no calendário:
+// O(log n + ausências no intervalo), sem percorrer os dias um a um
+void contarAusenciasIntervalo(const Colaborador& colab, int diaDoAnoInicio, int diaDoAnoFim, int ano, int& totalFerias, int& totalFaltas);
+
 // Conta o total de ausências num determinado mês e ano
 void contarAusenciasMes(const Colaborador& colab, int mes, int ano, int& totalFerias, int& totalFaltas);
 
@@ -61,6 +131,8 @@ void contarAusenciasMes(const Colaborador& colab, int mes, int ano, int& totalFe
 void contarAusenciasMensal(const Colaborador& colab, int mes, int ano, int& totalFerias, int& totalFaltas);
 
 // Verificar Conflito de Férias - verifica se outros colaboradores do mesmo departamento já têm férias marcadas
-bool verificarConflitoFerias(const Colaborador& colab, int dia, int mes, int ano, const std::vector<Colaborador>& todosColaboradores);
+// Com um índice de ausências atualizado, um dia sem férias no departamento é respondido sem percorrer a lista.
+bool verificarConflitoFerias(const Colaborador& colab, int dia, int mes, int ano, const std::vector<Colaborador>& todosColaboradores,
+                             const IndiceAusencias* indice = nullptr);
 
 #endif // CALENDARIO_H
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "cifra.h"
+#include "io.h"
+
+Cifra cifraCesar(int chave) {
+    Cifra cifra;
+    cifra.nome = "cesar";
+    cifra.cifrar = [chave](const std::string& texto) { return encriptar(texto, chave); };
+    cifra.decifrar = [chave](const std::string& texto) { return desencriptar(texto, chave); };
+    cifra.preservaEstrutura = true;
+    return cifra;
+}
+
+static Cifra& cifraAtiva() {
+    static Cifra cifra = cifraCesar(CHAVE_CESAR);
+    return cifra;
+}
+
+const Cifra& cifraDados() {
+    return cifraAtiva();
+}
+
+void definirCifraDados(const Cifra& cifra) {
+    cifraAtiva() = cifra;
+}
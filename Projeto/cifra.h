@@ -0,0 +1,30 @@
+#ifndef CIFRA_H
+#define CIFRA_H
+
+#include <string>
+#include <functional>
+
+// ===============================================
+// CIFRA DOS NOMES E DEPARTAMENTOS
+// ===============================================
+// Os nomes e departamentos são gravados cifrados (rh_data.txt, manifesto dos fragmentos, regras de
+// cobertura) com a cifra de dados. Uma cifra "preserva a estrutura" quando cada letra é cifrada
+// sozinha, sem depender da posição, e as maiúsculas continuam maiúsculas (César): aí
+// cifrar(a) == cifrar(b) se e só se a == b, e "x contém y" equivale a "cifrar(x) contém cifrar(y)",
+// por isso as pesquisas por nome podem correr sobre o texto cifrado, cifrando só a consulta.
+// Com uma cifra sem essa propriedade as pesquisas têm de decifrar (ver NomesCifrados em indice.h).
+
+struct Cifra {
+    std::string nome;
+    std::function<std::string(const std::string&)> cifrar;
+    std::function<std::string(const std::string&)> decifrar;
+    bool preservaEstrutura = false;
+};
+
+Cifra cifraCesar(int chave);
+
+// Cifra dos ficheiros de dados (César com CHAVE_CESAR, a menos que seja trocada no arranque)
+const Cifra& cifraDados();
+void definirCifraDados(const Cifra& cifra);
+
+#endif // CIFRA_H
@@ -0,0 +1,143 @@
+// Cliente do modo servidor do Mini-Sistema RH.
+//
+// Compilação:
+//   g++ -std=c++17 -O2 cliente.cpp cores.cpp -o cliente.exe
+//
+// Uso:
+//   ./cliente.exe [--socket rh.sock]                   -> modo interativo (um pedido por linha)
+//   ./cliente.exe [--socket rh.sock] "MARCAR;3;15;12;2025;F"  -> envia um pedido e sai
+//
+// Os pedidos seguem o protocolo descrito em servidor.h.
+
+#include "cores.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+#ifdef _WIN32
+
+int main() {
+    std::cerr << COR_VERMELHA << "ERRO: O cliente (socket Unix) nao esta disponivel em Windows.\n" << RESET_COR;
+    return 1;
+}
+
+#else
+
+// Leitura de linhas a partir do socket
+struct LigacaoServidor {
+    int fd = -1;
+    std::string pendente;
+
+    bool ligar(const std::string& caminho) {
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+        sockaddr_un endereco;
+        std::memset(&endereco, 0, sizeof(endereco));
+        endereco.sun_family = AF_UNIX;
+        std::strncpy(endereco.sun_path, caminho.c_str(), sizeof(endereco.sun_path) - 1);
+        return ::connect(fd, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) == 0;
+    }
+
+    bool enviar(const std::string& linha) {
+        std::string dados = linha + "\n";
+        size_t enviado = 0;
+        while (enviado < dados.size()) {
+            ssize_t n = ::send(fd, dados.data() + enviado, dados.size() - enviado, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            enviado += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    bool lerLinha(std::string& linha) {
+        size_t pos;
+        while ((pos = pendente.find('\n')) == std::string::npos) {
+            char buffer[4096];
+            ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) return false;
+            pendente.append(buffer, static_cast<size_t>(n));
+        }
+        linha = pendente.substr(0, pos);
+        pendente.erase(0, pos + 1);
+        return true;
+    }
+
+    ~LigacaoServidor() {
+        if (fd >= 0) ::close(fd);
+    }
+};
+
+// Envia um pedido e mostra a resposta. Retorna false se a ligação caiu.
+static bool executarPedido(LigacaoServidor& ligacao, const std::string& pedido, bool& erro) {
+    std::string cabecalho;
+    if (!ligacao.enviar(pedido) || !ligacao.lerLinha(cabecalho)) {
+        std::cerr << COR_VERMELHA << "ERRO: Ligacao ao servidor perdida.\n" << RESET_COR;
+        return false;
+    }
+
+    if (cabecalho.compare(0, 3, "OK ") != 0) {
+        erro = true;
+        std::cout << COR_VERMELHA << cabecalho << RESET_COR << "\n";
+        return true;
+    }
+
+    size_t numLinhas = std::stoul(cabecalho.substr(3));
+    for (size_t i = 0; i < numLinhas; ++i) {
+        std::string linha;
+        if (!ligacao.lerLinha(linha)) return false;
+        if (linha.compare(0, 6, "AVISO;") == 0) {
+            std::cout << COR_AMARELA << linha << RESET_COR << "\n";
+        } else {
+            std::cout << linha << "\n";
+        }
+    }
+    std::cout << COR_VERDE << "OK (" << numLinhas << " linhas)" << RESET_COR << "\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string caminho = "rh.sock";
+    std::vector<std::string> pedidos;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            caminho = argv[++i];
+        } else {
+            pedidos.push_back(arg);
+        }
+    }
+
+    LigacaoServidor ligacao;
+    if (!ligacao.ligar(caminho)) {
+        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel ligar ao servidor em " << caminho
+                  << " (inicie-o com main.exe --servidor).\n" << RESET_COR;
+        return 1;
+    }
+
+    bool erro = false;
+    if (!pedidos.empty()) {
+        for (const auto& pedido : pedidos) {
+            if (!executarPedido(ligacao, pedido, erro)) return 1;
+        }
+        return erro ? 2 : 0;
+    }
+
+    // Modo interativo
+    std::cout << COR_AZUL << "Ligado a " << caminho << ". Escreva SAIR para terminar.\n" << RESET_COR;
+    std::string linha;
+    while (std::cout << "rh> " && std::getline(std::cin, linha)) {
+        if (linha.empty()) continue;
+        if (!executarPedido(ligacao, linha, erro)) return 1;
+        if (linha == "SAIR" || linha == "sair" || linha == "DESLIGAR" || linha == "desligar") break;
+    }
+    return 0;
+}
+
+#endif
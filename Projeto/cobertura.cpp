@@ -0,0 +1,266 @@
+#include "cobertura.h"
+#include "calendario.h"
+#include "io.h"
+#include "cifra.h"
+#include "cores.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+
+const std::string FICHEIRO_COBERTURA = "rh_cobertura.txt";
+
+static bool eAusencia(TipoMarcacao tipo) {
+    return temTipo(MASCARA_AUSENCIA, tipo);
+}
+
+// Sábado ou domingo (dias sem mínimo de presentes)
+static bool eFimDeSemana(int diaDoAno, int ano) {
+    int dia = 0, mes = 0;
+    if (!diaDoAnoParaData(diaDoAno, ano, dia, mes)) return true;
+    int semana = diaSemana(dia, mes, ano);
+    return semana == 0 || semana == 6;
+}
+
+std::string descreverViolacao(const ViolacaoCobertura& violacao, int ano) {
+    int dia = 0, mes = 0;
+    diaDoAnoParaData(violacao.diaDoAno, ano, dia, mes);
+    std::ostringstream texto;
+    texto << violacao.departamento << " em " << std::setw(2) << std::setfill('0') << dia << "/"
+          << std::setw(2) << mes << "/" << ano << ": " << violacao.presentes << " presentes (minimo "
+          << violacao.minimo << ")";
+    return texto.str();
+}
+
+// ===============================================
+// REGRAS
+// ===============================================
+
+bool MotorCobertura::lerRegras(const std::string& nomeFicheiro) {
+    std::ifstream ficheiro(nomeFicheiro);
+    if (!ficheiro.is_open()) return false;
+
+    minimos.clear();
+    std::string linha;
+    while (std::getline(ficheiro, linha)) {
+        size_t separador = linha.rfind(';');
+        if (linha.empty() || separador == std::string::npos) continue;
+        try {
+            int minimo = std::stoi(linha.substr(separador + 1));
+            if (minimo > 0) minimos[cifraDados().decifrar(linha.substr(0, separador))] = minimo;
+        } catch (const std::exception&) {
+            std::cerr << COR_AMARELA << "[AVISO] Regra de cobertura invalida ignorada: " << linha << "\n" << RESET_COR;
+        }
+    }
+    return true;
+}
+
+bool MotorCobertura::gravarRegras(const std::string& nomeFicheiro) const {
+    const std::string temporario = nomeFicheiro + ".tmp";
+    {
+        std::ofstream ficheiro(temporario);
+        if (!ficheiro.is_open()) return false;
+        for (const auto& par : minimos) {
+            ficheiro << cifraDados().cifrar(par.first) << ";" << par.second << "\n";
+        }
+        if (!ficheiro) return false;
+    }
+    return publicarFicheiro(temporario, nomeFicheiro);
+}
+
+void MotorCobertura::definirMinimo(const std::string& departamento, int minimo) {
+    if (minimo <= 0) {
+        minimos.erase(departamento);
+    } else {
+        minimos[departamento] = minimo;
+    }
+}
+
+int MotorCobertura::minimoDe(const std::string& departamento) const {
+    auto it = minimos.find(departamento);
+    return it == minimos.end() ? 0 : it->second;
+}
+
+// ===============================================
+// CONTADORES
+// ===============================================
+
+void MotorCobertura::construir(const std::vector<Colaborador>& lista) {
+    porDepartamento.clear();
+    for (const auto& colab : lista) adicionarColaborador(colab);
+}
+
+void MotorCobertura::alterarDia(const std::string& departamento, int diaDoAno, TipoMarcacao antes, TipoMarcacao depois) {
+    if (diaDoAno < 1 || diaDoAno > 366 || eAusencia(antes) == eAusencia(depois)) return;
+    porDepartamento[departamento].ausentes[diaDoAno] += eAusencia(depois) ? 1 : -1;
+}
+
+void MotorCobertura::adicionarColaborador(const Colaborador& colab) {
+    ContagensDepartamento& contagens = porDepartamento[colab.departamento];
+    ++contagens.colaboradores;
+    for (const auto& par : colab.calendario) {
+        if (par.first >= 1 && par.first <= 366 && eAusencia(par.second)) ++contagens.ausentes[par.first];
+    }
+}
+
+void MotorCobertura::removerColaborador(const Colaborador& colab) {
+    auto it = porDepartamento.find(colab.departamento);
+    if (it == porDepartamento.end()) return;
+    --it->second.colaboradores;
+    for (const auto& par : colab.calendario) {
+        if (par.first >= 1 && par.first <= 366 && eAusencia(par.second)) --it->second.ausentes[par.first];
+    }
+}
+
+int MotorCobertura::colaboradores(const std::string& departamento) const {
+    auto it = porDepartamento.find(departamento);
+    return it == porDepartamento.end() ? 0 : it->second.colaboradores;
+}
+
+int MotorCobertura::presentes(const std::string& departamento, int diaDoAno) const {
+    auto it = porDepartamento.find(departamento);
+    if (it == porDepartamento.end() || diaDoAno < 1 || diaDoAno > 366) return 0;
+    return it->second.colaboradores - it->second.ausentes[diaDoAno];
+}
+
+// ===============================================
+// VERIFICAÇÃO E CAPACIDADE
+// ===============================================
+
+std::vector<ViolacaoCobertura> MotorCobertura::verificarAusencia(const Colaborador& colab, int inicio, int fim, int ano) const {
+    std::vector<ViolacaoCobertura> violacoes;
+    int minimo = minimoDe(colab.departamento);
+    if (minimo <= 0) return violacoes;
+
+    auto it = porDepartamento.find(colab.departamento);
+    const int colaboradoresDepto = it == porDepartamento.end() ? 0 : it->second.colaboradores;
+    for (int dia = std::max(inicio, 1); dia <= std::min(fim, 366); ++dia) {
+        if (eFimDeSemana(dia, ano)) continue;
+        auto marcado = colab.calendario.find(dia);
+        if (marcado != colab.calendario.end() && eAusencia(marcado->second)) continue; // Já conta como ausente
+
+        int ausentes = it == porDepartamento.end() ? 0 : it->second.ausentes[dia];
+        int presentesDepois = colaboradoresDepto - ausentes - 1;
+        if (presentesDepois < minimo) {
+            violacoes.push_back({colab.departamento, dia, presentesDepois, minimo});
+        }
+    }
+    return violacoes;
+}
+
+int MotorCobertura::capacidadeRestante(const std::string& departamento, int diaDoAno, int ano) const {
+    int presentesDia = presentes(departamento, diaDoAno);
+    if (eFimDeSemana(diaDoAno, ano)) return presentesDia;
+    return presentesDia - minimoDe(departamento);
+}
+
+std::vector<int> MotorCobertura::calendarioCapacidade(const std::string& departamento, int ano) const {
+    int diasNoAno = dataParaDiaDoAno(31, 12, ano);
+    std::vector<int> capacidade(static_cast<size_t>(diasNoAno));
+    for (int dia = 1; dia <= diasNoAno; ++dia) {
+        capacidade[static_cast<size_t>(dia - 1)] = capacidadeRestante(departamento, dia, ano);
+    }
+    return capacidade;
+}
+
+void mostrarCapacidadeMes(const MotorCobertura& motor, const std::string& departamento, int mes, int ano) {
+    if (!dataValida(1, mes, ano)) {
+        std::cout << COR_VERMELHA << "ERRO: Mes/Ano invalido.\n" << RESET_COR;
+        return;
+    }
+    std::vector<int> capacidade = motor.calendarioCapacidade(departamento, ano);
+    int minimo = motor.minimoDe(departamento);
+    int primeiroDia = dataParaDiaDoAno(1, mes, ano);
+
+    std::cout << COR_CIANO << "\n--- Capacidade de " << departamento << " em " << nomeMes(mes) << " " << ano << " ("
+              << motor.colaboradores(departamento) << " colaboradores, minimo " << minimo << " presentes) ---\n" << RESET_COR;
+    std::cout << COR_AZUL << std::setw(5) << "Dom" << std::setw(5) << "Seg" << std::setw(5) << "Ter" << std::setw(5) << "Qua"
+              << std::setw(5) << "Qui" << std::setw(5) << "Sex" << std::setw(5) << "Sab" << RESET_COR << "\n";
+
+    int coluna = diaSemana(1, mes, ano);
+    for (int i = 0; i < coluna; ++i) std::cout << std::setw(5) << "";
+    for (int dia = 1; dia <= diasNoMes(mes, ano); ++dia) {
+        if (coluna == 0 || coluna == 6) {
+            std::cout << COR_CIANO << std::setw(5) << "--" << RESET_COR;
+        } else {
+            int valor = capacidade[static_cast<size_t>(primeiroDia + dia - 2)];
+            const std::string& cor = valor <= 0 ? COR_VERMELHA : (valor == 1 ? COR_AMARELA : COR_VERDE);
+            std::cout << cor << std::setw(5) << valor << RESET_COR;
+        }
+        if (coluna == 6) std::cout << "\n";
+        coluna = (coluna + 1) % 7;
+    }
+    if (coluna != 0) std::cout << "\n";
+    std::cout << "Numero de colaboradores que ainda podem ficar ausentes em cada dia util (0 = no minimo).\n";
+}
+
+// Lê uma linha com um número inteiro. Retorna false se não for um número.
+static bool lerInteiro(const std::string& pergunta, int& valor) {
+    std::string texto;
+    std::cout << pergunta;
+    std::getline(std::cin, texto);
+    try {
+        valor = std::stoi(texto);
+    } catch (const std::exception&) {
+        std::cout << COR_VERMELHA << "ERRO: Valor invalido.\n" << RESET_COR;
+        return false;
+    }
+    return true;
+}
+
+void menuCobertura(MotorCobertura& motor) {
+    std::cout << COR_AZUL << "\n--- Cobertura Minima (presentes em dias uteis) ---\n" << RESET_COR;
+    if (motor.minimos.empty()) {
+        std::cout << "Nenhum departamento tem regra de cobertura.\n";
+    } else {
+        std::cout << std::left << std::setw(20) << "Departamento" << std::right << std::setw(14) << "Colaboradores"
+                  << std::setw(10) << "Minimo" << "\n";
+        for (const auto& par : motor.minimos) {
+            std::cout << std::left << std::setw(20) << par.first << std::right << std::setw(14) << motor.colaboradores(par.first)
+                      << std::setw(10) << par.second << "\n";
+        }
+        std::cout << std::left;
+    }
+
+    std::cout << " 1. Definir Minimo de um Departamento (0 remove a regra)\n";
+    std::cout << " 2. Capacidade Restante de um Departamento num Mes\n";
+    int op = 0;
+    if (!lerInteiro(COR_AMARELA + " Opcao: " + RESET_COR, op)) return;
+
+    std::string departamento;
+    std::cout << "Departamento: ";
+    std::getline(std::cin, departamento);
+    if (departamento.empty()) {
+        std::cout << COR_VERMELHA << "ERRO: Departamento obrigatorio.\n" << RESET_COR;
+        return;
+    }
+
+    if (op == 1) {
+        int minimo = 0;
+        if (!lerInteiro("Minimo de presentes nos dias uteis: ", minimo)) return;
+        if (minimo < 0) {
+            std::cout << COR_VERMELHA << "ERRO: O minimo nao pode ser negativo.\n" << RESET_COR;
+            return;
+        }
+        if (minimo > motor.colaboradores(departamento)) {
+            std::cout << COR_AMARELA << "AVISO: O departamento so tem " << motor.colaboradores(departamento)
+                      << " colaboradores; nenhuma ferias podera ser marcada.\n" << RESET_COR;
+        }
+        motor.definirMinimo(departamento, minimo);
+        if (motor.gravarRegras(FICHEIRO_COBERTURA)) {
+            std::cout << COR_VERDE << "Regra guardada em " << FICHEIRO_COBERTURA << ".\n" << RESET_COR;
+        } else {
+            std::cout << COR_VERMELHA << "ERRO: Nao foi possivel gravar " << FICHEIRO_COBERTURA << ".\n" << RESET_COR;
+        }
+    } else if (op == 2) {
+        int mes = 0, ano = 0;
+        if (!lerInteiro("Mes (mm): ", mes) || !lerInteiro("Ano (aaaa): ", ano)) return;
+        if (motor.colaboradores(departamento) == 0) {
+            std::cout << COR_VERMELHA << "ERRO: Departamento sem colaboradores: '" << departamento << "'.\n" << RESET_COR;
+            return;
+        }
+        mostrarCapacidadeMes(motor, departamento, mes, ano);
+    } else {
+        std::cout << COR_VERMELHA << "Opcao invalida.\n" << RESET_COR;
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef COBERTURA_H
+#define COBERTURA_H
+
+#include "colaborador.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <array>
+
+// ===============================================
+// COBERTURA MÍNIMA POR DEPARTAMENTO
+// ===============================================
+// Regras do tipo "pelo menos 4 presentes nos dias úteis" por departamento, guardadas em
+// rh_cobertura.txt (uma linha <DepartamentoCifrado>;<minimo>). O motor mantém, por departamento,
+// o número de colaboradores e o número de ausentes (férias ou falta) em cada dia do ano, atualizados
+// a cada marcação. Verificar uma ausência de N dias custa O(N) e devolve as violações, sem perguntas.
+// Os fins de semana não têm mínimo.
+
+extern const std::string FICHEIRO_COBERTURA;
+
+struct ViolacaoCobertura {
+    std::string departamento;
+    int diaDoAno = 0;
+    int presentes = 0; // Presentes no dia se a ausência pedida for marcada
+    int minimo = 0;
+};
+
+// "Vendas em 03/02/2026: 3 presentes (minimo 4)"
+std::string descreverViolacao(const ViolacaoCobertura& violacao, int ano);
+
+struct MotorCobertura {
+    // --- Regras ---
+    std::map<std::string, int> minimos; // Departamento -> mínimo de presentes nos dias úteis
+
+    bool lerRegras(const std::string& nomeFicheiro);
+    bool gravarRegras(const std::string& nomeFicheiro) const;
+    void definirMinimo(const std::string& departamento, int minimo); // 0 remove a regra
+    int minimoDe(const std::string& departamento) const;              // 0 se não houver regra
+
+    // --- Contadores ---
+    void construir(const std::vector<Colaborador>& lista);
+    void alterarDia(const std::string& departamento, int diaDoAno, TipoMarcacao antes, TipoMarcacao depois);
+    void adicionarColaborador(const Colaborador& colab);
+    void removerColaborador(const Colaborador& colab);
+
+    int colaboradores(const std::string& departamento) const;
+    int presentes(const std::string& departamento, int diaDoAno) const;
+
+    // Violações se 'colab' ficar ausente nos dias inicio..fim do ano (dias úteis em que ainda não
+    // está ausente). Vazio = a ausência pode ser marcada.
+    std::vector<ViolacaoCobertura> verificarAusencia(const Colaborador& colab, int inicio, int fim, int ano) const;
+
+    // Quantos colaboradores ainda podem ficar ausentes no dia sem violar o mínimo.
+    // Sem regra para o departamento, ou ao fim de semana, é o número de presentes.
+    int capacidadeRestante(const std::string& departamento, int diaDoAno, int ano) const;
+
+    // Capacidade restante de cada dia do ano (posição 0 = 1 de janeiro)
+    std::vector<int> calendarioCapacidade(const std::string& departamento, int ano) const;
+
+private:
+    struct ContagensDepartamento {
+        int colaboradores = 0;
+        std::array<int, 367> ausentes{}; // Índice = dia do ano (posição 0 não usada)
+    };
+    std::map<std::string, ContagensDepartamento> porDepartamento;
+};
+
+// Mostra a capacidade restante de um departamento num mês, em formato de calendário
+void mostrarCapacidadeMes(const MotorCobertura& motor, const std::string& departamento, int mes, int ano);
+
+// Opção do menu: lista as regras, define o mínimo de um departamento ou mostra a sua capacidade
+void menuCobertura(MotorCobertura& motor);
+
+#endif // COBERTURA_H
@@ -9,14 +9,28 @@
 #include <iomanip>
 #include "cores.h"
 #include "io.h"
+#include "metricas.h"
+#include "autosave.h"
+#include "notas.h"
+#include "validades.h"
+#include "duplicados.h"
+#include "ranking.h"
+#include "ausencias.h"
 
 // ===============================================
 // FUNÇÕES DE UTILIDADE
 // ===============================================
 
+// Limite inferior para novos IDs (IDs já usados em dados que não estão carregados)
+static int proximoIdMinimo = 1;
+
+void definirProximoIdMinimo(int id) {
+    proximoIdMinimo = id;
+}
+
 // Retorna o próximo ID disponível
 int getProximoId(const std::vector<Colaborador>& lista) {
-    int maxId = 0;
+    int maxId = proximoIdMinimo - 1;
     for (const auto& colab : lista) {
         if (colab.id > maxId) {
             maxId = colab.id;
@@ -27,18 +41,8 @@ int getProximoId(const std::vector<Colaborador>& lista) {
 
 // Verifica se o nome já existe na lista
 bool verificarDuplicado(const std::vector<Colaborador>& lista, const std::string& nome) {
-    for (const auto& colab : lista) {
-        // Ignora a capitalização para a verificação de duplicado
-        std::string nome_lower = nome;
-        std::string colab_nome_lower = colab.nome;
-        std::transform(nome_lower.begin(), nome_lower.end(), nome_lower.begin(), ::tolower);
-        std::transform(colab_nome_lower.begin(), colab_nome_lower.end(), colab_nome_lower.begin(), ::tolower);
-
-        if (colab_nome_lower == nome_lower) {
-            return true;
-        }
-    }
-    return false;
+    // Ignora maiúsculas, acentos e espaços repetidos (distância 0 depois de normalizar)
+    return !procurarNomesSemelhantes(lista, nome, 0).empty();
 }
 
 // Retorna a data atual como string dd/mm/aaaa
@@ -64,9 +68,17 @@ void adicionarColaborador(std::vector<Colaborador>& lista) {
     std::cout << "Nome do novo colaborador: ";
     std::getline(std::cin >> std::ws, nome);
 
-    if (verificarDuplicado(lista, nome)) {
+    std::vector<NomeSemelhante> semelhantes = procurarNomesSemelhantes(lista, nome);
+    if (!semelhantes.empty()) {
         char confirmacao;
-        std::cout << COR_VERMELHA << "ERRO: Colaborador com o nome '" << nome << "' ja existe. Deseja adicionar mesmo assim? (S/N): " << RESET_COR;
+        std::cout << COR_VERMELHA << "ERRO: Ja existem colaboradores com nome igual ou semelhante a '" << nome << "':\n" << RESET_COR;
+        for (size_t i = 0; i < semelhantes.size() && i < 5; ++i) {
+            int indice = encontrarColaborador(lista, std::to_string(semelhantes[i].id), true);
+            if (indice < 0) continue;
+            std::cout << "  - " << lista[static_cast<size_t>(indice)].nome << " (ID: " << semelhantes[i].id << ")"
+                      << (semelhantes[i].distancia == 0 ? " [igual]" : "") << "\n";
+        }
+        std::cout << COR_VERMELHA << "Deseja adicionar mesmo assim? (S/N): " << RESET_COR;
         std::cin >> confirmacao;
         std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
         if (std::tolower(confirmacao) != 's') {
@@ -84,9 +96,12 @@ void adicionarColaborador(std::vector<Colaborador>& lista) {
     novoColab.id = getProximoId(lista);
     novoColab.nome = nome;
     novoColab.departamento = departamento;
-    novoColab.dias_ferias_restantes = 22; // Valor default
+    novoColab.saldo_ferias = 22 * UNIDADES_POR_DIA; // Valor default
+    novoColab.modificado = true;
 
     lista.push_back(novoColab);
+    registarNome(novoColab);
+    registarColaboradorRanking(novoColab);
     std::cout << COR_VERDE << "Colaborador '" << nome << "' (ID: " << novoColab.id << ") do departamento '" << departamento << "' adicionado com sucesso.\n" << RESET_COR;
 
 }
@@ -124,7 +139,13 @@ void removerColaborador(std::vector<Colaborador>& lista) {
     if (std::tolower(confirmacao) == 's') {
         std::string nomeRemovido = colab.nome;
         int idRemovido = colab.id;
+        desindexarColaborador(colab);
+        retirarFormacoesColaborador(colab);
+        retirarNome(colab);
+        retirarColaboradorRanking(colab);
+        retirarColaboradorAusencias(colab);
         lista.erase(lista.begin() + indice);
+        registarRemocao(idRemovido);
         std::cout << COR_VERDE << "Colaborador '" << nomeRemovido << "' (ID: " << idRemovido 
                   << ") removido com sucesso.\n" << RESET_COR;
     } else {
@@ -152,6 +173,7 @@ void listarColaboradores(const std::vector<Colaborador>& lista) {
 
 // Encontra o índice (por nome ou ID) do colaborador na lista
 int encontrarColaborador(const std::vector<Colaborador>& lista, const std::string& query, bool isID) {
+    MEDIR_ESCOPO(Metrica::ENCONTRAR_COLABORADOR);
     if (isID) {
         try {
             int id = std::stoi(query);
@@ -200,14 +222,17 @@ void procurarColaborador(const std::vector<Colaborador>& lista) {
         return;
     }
 
-    const Colaborador& colab = lista[static_cast<size_t>(indice)];
+    mostrarColaborador(lista[static_cast<size_t>(indice)]);
+}
 
+// Mostra os dados básicos e o calendário do mês atual
+void mostrarColaborador(const Colaborador& colab) {
     // Mostrar dados básicos
     std::cout << "\n" << COR_CIANO << "============================================\n";
     std::cout << "Dados do Colaborador: " << colab.nome << RESET_COR << " (ID: " << colab.id << ")\n";
     std::cout << COR_CIANO << "============================================\n" << RESET_COR;
     std::cout << "Departamento: " << colab.departamento << "\n";
-    std::cout << "Ferias Restantes (Ano): " << colab.dias_ferias_restantes << " dias\n";
+    std::cout << "Ferias Restantes (Ano): " << formatarDias(colab.saldo_ferias) << " dias\n";
     std::cout << "Total de Formacoes: " << colab.formacoes.size() << "\n";
     std::cout << "Total de Notas: " << colab.notas.size() << "\n";
     std::cout << "--------------------------------------------\n";
@@ -269,6 +294,8 @@ void adicionarFormacao(Colaborador& colab) {
     novaForm.data_conclusao = data;
 
     colab.formacoes.push_back(novaForm);
+    colab.modificado = true;
+    registarFormacao(colab, novaForm);
     std::cout << COR_VERDE << "Formacao '" << nome << "' adicionada com sucesso (ID: " << novaForm.id_curso << ").\n" << RESET_COR;
 
 }
@@ -299,6 +326,8 @@ void editarFormacao(Colaborador& colab) {
         std::cout << "Editar Data de Conclusao (Atual: " << it->data_conclusao << "): ";
         std::getline(std::cin, nova_data);
         if (!nova_data.empty()) it->data_conclusao = nova_data;
+        colab.modificado = true;
+        registarFormacao(colab, *it); // Nova data de expiração (ou deixa de expirar)
         
         std::cout << COR_VERDE << "Formacao ID " << id_curso << " editada com sucesso.\n" << RESET_COR;
     } else {
@@ -325,6 +354,8 @@ void removerFormacao(Colaborador& colab) {
 
     if (it != colab.formacoes.end()) {
         colab.formacoes.erase(it, colab.formacoes.end());
+        colab.modificado = true;
+        retirarFormacao(colab, id_curso);
         std::cout << COR_VERDE << "Formacao ID " << id_curso << " removida com sucesso.\n" << RESET_COR;
     } else {
         std::cout << COR_VERMELHA << "ERRO: ID de formacao nao encontrado.\n" << RESET_COR;
@@ -407,6 +438,8 @@ void adicionarNota(Colaborador& colab) {
     novaNota.data_criacao = getDataAtual();
 
     colab.notas.push_back(novaNota);
+    colab.modificado = true;
+    indexarNota(colab, novaNota);
     std::cout << COR_VERDE << "Nota adicionada com sucesso (ID: " << novaNota.id_nota << ", Data: " << novaNota.data_criacao << ").\n" << RESET_COR;
 
 }
@@ -431,7 +464,11 @@ void editarNota(Colaborador& colab) {
         std::string novo_texto;
         std::cout << "Editar Texto (Atual: " << it->texto << "): ";
         std::getline(std::cin, novo_texto);
-        if (!novo_texto.empty()) it->texto = novo_texto;
+        if (!novo_texto.empty()) {
+            it->texto = novo_texto;
+            indexarNota(colab, *it); // Substitui a versão indexada
+        }
+        colab.modificado = true;
 
         std::cout << COR_VERDE << "Nota ID " << id_nota << " editada com sucesso.\n" << RESET_COR;
     } else {
@@ -458,6 +495,8 @@ void removerNota(Colaborador& colab) {
 
     if (it != colab.notas.end()) {
         colab.notas.erase(it, colab.notas.end());
+        colab.modificado = true;
+        desindexarNota(colab, id_nota);
         std::cout << COR_VERDE << "Nota ID " << id_nota << " removida com sucesso.\n" << RESET_COR;
     } else {
         std::cout << COR_VERMELHA << "ERRO: ID de nota nao encontrado.\n" << RESET_COR;
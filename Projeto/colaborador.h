@@ -36,19 +36,33 @@ struct Colaborador {
 
     // Calendário existente (int = DiaDoAno, TipoMarcacao = Férias/Falta)
     std::map<int, TipoMarcacao> calendario;
+    ParciaisDia parciais; // Dias do calendário marcados só em parte (vazio para quase todos)
 
     //  Listas de Formacoes e Notas 
     std::vector<Formacao> formacoes;
     std::vector<Nota> notas;
 
-    // Campo para o Dashboard
-    int dias_ferias_restantes = 22; // Assumindo 22 dias por ano
+    // Campo para o Dashboard: saldo de férias por gozar, em unidades (UNIDADES_POR_DIA por dia).
+    // aplicarMarcacao/aplicarDesmarcacao descontam e devolvem as férias marcadas.
+    int saldo_ferias = 22 * UNIDADES_POR_DIA; // Assumindo 22 dias por ano
+
+    // Alterado desde a última gravação (usado pelo autosave, não é guardado no ficheiro)
+    bool modificado = false;
 };
 
 // ===============================================
 // DECLARAÇÕES DE FUNÇÕES
 // ===============================================
 
+// Retorna o próximo ID disponível
+int getProximoId(const std::vector<Colaborador>& lista);
+
+// Garante que getProximoId nunca devolve menos do que 'id' (ex: só alguns departamentos carregados)
+void definirProximoIdMinimo(int id);
+
+// Verifica se o nome já existe na lista (sem distinguir maiúsculas/minúsculas)
+bool verificarDuplicado(const std::vector<Colaborador>& lista, const std::string& nome);
+
 // Adiciona um novo colaborador à lista
 void adicionarColaborador(std::vector<Colaborador>& lista);
 
@@ -64,6 +78,9 @@ int encontrarColaborador(const std::vector<Colaborador>& lista, const std::strin
 // Procura, mostra dados básicos e o calendário do mês atual
 void procurarColaborador(const std::vector<Colaborador>& lista);
 
+// Mostra os dados básicos e o calendário do mês atual de um colaborador
+void mostrarColaborador(const Colaborador& colab);
+
 // Menu de Gestão do Colaborador (Formações/Notas)
 void menuGestaoColaborador(std::vector<Colaborador>& lista);
 
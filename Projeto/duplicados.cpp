@@ -0,0 +1,307 @@
+#include "duplicados.h"
+#include "notas.h"
+#include "paralelo.h"
+#include "metricas.h"
+#include "cores.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+
+// ===============================================
+// NORMALIZAÇÃO E DISTÂNCIA DE EDIÇÃO
+// ===============================================
+
+std::string normalizarNome(const std::string& nome) {
+    std::string normalizado;
+    for (const auto& palavra : dividirPalavras(nome)) {
+        if (!normalizado.empty()) normalizado += ' ';
+        normalizado += palavra;
+    }
+    return normalizado;
+}
+
+int limiteDistancia(size_t tamanhoMenor, int maxima) {
+    return std::min(maxima, static_cast<int>(tamanhoMenor / 5));
+}
+
+PadraoEdicao::PadraoEdicao(const std::string& texto) : padrao(texto) {
+    std::memset(mascaras, 0, sizeof(mascaras));
+    for (size_t i = 0; i < padrao.size() && i < 64; ++i) {
+        mascaras[static_cast<unsigned char>(padrao[i])] |= uint64_t(1) << i;
+    }
+}
+
+// Programação dinâmica clássica (só para padrões com mais de 64 caracteres)
+static int distanciaClassica(const std::string& a, const std::string& b, int limite) {
+    std::vector<int> anterior(b.size() + 1), atual(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); ++j) anterior[j] = static_cast<int>(j);
+    for (size_t i = 1; i <= a.size(); ++i) {
+        atual[0] = static_cast<int>(i);
+        int menor = atual[0];
+        for (size_t j = 1; j <= b.size(); ++j) {
+            int custo = a[i - 1] == b[j - 1] ? 0 : 1;
+            atual[j] = std::min({anterior[j] + 1, atual[j - 1] + 1, anterior[j - 1] + custo});
+            menor = std::min(menor, atual[j]);
+        }
+        if (menor > limite) return limite + 1;
+        std::swap(anterior, atual);
+    }
+    return std::min(anterior[b.size()], limite + 1);
+}
+
+int PadraoEdicao::distancia(const std::string& texto, int limite) const {
+    const size_t m = padrao.size(), n = texto.size();
+    if (static_cast<int>(m > n ? m - n : n - m) > limite) return limite + 1;
+    if (m == 0) return static_cast<int>(n);
+    if (m > 64) return distanciaClassica(padrao, texto, limite);
+
+    // Myers (1999) na versão de Hyyrö para a distância global: pv/mv são as diferenças verticais
+    // (+1/-1) da coluna atual, e 'pontos' é o valor da última linha
+    const uint64_t ultimo = uint64_t(1) << (m - 1);
+    uint64_t pv = ~uint64_t(0), mv = 0;
+    int pontos = static_cast<int>(m);
+    for (size_t j = 0; j < n; ++j) {
+        const uint64_t eq = mascaras[static_cast<unsigned char>(texto[j])];
+        const uint64_t xv = eq | mv;
+        const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & ultimo) {
+            ++pontos;
+        } else if (mh & ultimo) {
+            --pontos;
+        }
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        // Cada coluna que falta só pode baixar a distância em 1
+        if (pontos - static_cast<int>(n - j - 1) > limite) return limite + 1;
+    }
+    return pontos <= limite ? pontos : limite + 1;
+}
+
+// ===============================================
+// BLOCOS
+// ===============================================
+
+// Duas chaves por nome: início e fim do primeiro e do último nome ("vanessa silva" -> "<va|si", ">sa|va")
+static void chavesBloco(const std::string& normalizado, std::string chaves[2]) {
+    chaves[0].clear();
+    chaves[1].clear();
+    if (normalizado.empty()) return;
+    size_t espaco = normalizado.find(' ');
+    std::string primeiro = normalizado.substr(0, espaco);
+    std::string ultimo = espaco == std::string::npos ? primeiro : normalizado.substr(normalizado.rfind(' ') + 1);
+    auto fim2 = [](const std::string& p) { return p.size() <= 2 ? p : p.substr(p.size() - 2); };
+    chaves[0] = "<" + primeiro.substr(0, 2) + "|" + ultimo.substr(0, 2);
+    chaves[1] = ">" + fim2(primeiro) + "|" + fim2(ultimo);
+}
+
+// ===============================================
+// DETEÇÃO EM LOTE
+// ===============================================
+
+std::vector<ParDuplicado> detetarDuplicados(const std::vector<Colaborador>& lista, int distanciaMaxima) {
+    MEDIR_ESCOPO(Metrica::DETETAR_DUPLICADOS);
+    std::vector<std::string> normalizados(lista.size());
+    executarBlocos(lista.size(), [&](size_t inicio, size_t fim, unsigned) {
+        for (size_t i = inicio; i < fim; ++i) normalizados[i] = normalizarNome(lista[i].nome);
+    });
+
+    std::unordered_map<std::string, std::vector<uint32_t>> blocos;
+    std::string chaves[2];
+    for (size_t i = 0; i < lista.size(); ++i) {
+        chavesBloco(normalizados[i], chaves);
+        if (chaves[0].empty()) continue;
+        blocos[chaves[0]].push_back(static_cast<uint32_t>(i));
+        if (chaves[1] != chaves[0]) blocos[chaves[1]].push_back(static_cast<uint32_t>(i));
+    }
+    std::vector<std::vector<uint32_t>*> comPares;
+    for (auto& par : blocos) {
+        if (par.second.size() > 1) comPares.push_back(&par.second);
+    }
+
+    // Cada bloco é ordenado por tamanho do nome: a partir de certa distância os tamanhos já
+    // diferem mais do que o limite e o resto do bloco não precisa de ser visto
+    std::vector<std::vector<ParDuplicado>> porBloco(comPares.size());
+    executarParalelo(comPares.size(), [&](size_t b) {
+        std::vector<uint32_t>& membros = *comPares[b];
+        std::sort(membros.begin(), membros.end(), [&](uint32_t x, uint32_t y) {
+            return normalizados[x].size() != normalizados[y].size() ? normalizados[x].size() < normalizados[y].size() : x < y;
+        });
+        for (size_t i = 0; i < membros.size(); ++i) {
+            const std::string& nome = normalizados[membros[i]];
+            const int limite = limiteDistancia(nome.size(), distanciaMaxima);
+            const PadraoEdicao padrao(nome);
+            for (size_t j = i + 1; j < membros.size(); ++j) {
+                const std::string& outro = normalizados[membros[j]];
+                if (static_cast<int>(outro.size() - nome.size()) > limite) break;
+                int distancia = padrao.distancia(outro, limite);
+                if (distancia <= limite) {
+                    porBloco[b].push_back({std::min(membros[i], membros[j]), std::max(membros[i], membros[j]), distancia});
+                }
+            }
+        }
+    });
+
+    // Um par pode aparecer nos dois blocos
+    std::vector<ParDuplicado> pares;
+    for (const auto& parte : porBloco) pares.insert(pares.end(), parte.begin(), parte.end());
+    std::sort(pares.begin(), pares.end(), [](const ParDuplicado& x, const ParDuplicado& y) {
+        if (x.distancia != y.distancia) return x.distancia < y.distancia;
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+    pares.erase(std::unique(pares.begin(), pares.end(), [](const ParDuplicado& x, const ParDuplicado& y) {
+        return x.a == y.a && x.b == y.b;
+    }), pares.end());
+    return pares;
+}
+
+// ===============================================
+// ÍNDICE PARA NOMES NOVOS
+// ===============================================
+
+void IndiceNomes::construir(const std::vector<Colaborador>& lista) {
+    nomes.clear();
+    blocos.clear();
+    porId.clear();
+    for (const auto& colab : lista) acrescentar(colab);
+}
+
+void IndiceNomes::acrescentar(const Colaborador& colab) {
+    retirar(colab.id);
+    const uint32_t posicao = static_cast<uint32_t>(nomes.size());
+    nomes.push_back({colab.id, normalizarNome(colab.nome), true});
+    porId[colab.id] = posicao;
+
+    std::string chaves[2];
+    chavesBloco(nomes.back().normalizado, chaves);
+    if (chaves[0].empty()) return;
+    blocos[chaves[0]].push_back(posicao);
+    if (chaves[1] != chaves[0]) blocos[chaves[1]].push_back(posicao);
+}
+
+void IndiceNomes::retirar(int id) {
+    auto it = porId.find(id);
+    if (it == porId.end()) return;
+    nomes[it->second].ativo = false; // Fica nos blocos, mas é ignorado
+    porId.erase(it);
+}
+
+std::vector<NomeSemelhante> IndiceNomes::semelhantes(const std::string& nome, int distanciaMaxima) const {
+    std::vector<NomeSemelhante> resultado;
+    const std::string normalizado = normalizarNome(nome);
+    std::string chaves[2];
+    chavesBloco(normalizado, chaves);
+    if (chaves[0].empty()) return resultado;
+
+    const PadraoEdicao padrao(normalizado);
+    std::vector<uint32_t> vistos;
+    for (const auto& chave : chaves) {
+        auto bloco = blocos.find(chave);
+        if (bloco == blocos.end()) continue;
+        for (uint32_t posicao : bloco->second) {
+            const NomeIndexado& outro = nomes[posicao];
+            if (!outro.ativo || std::find(vistos.begin(), vistos.end(), posicao) != vistos.end()) continue;
+            const int limite = limiteDistancia(std::min(normalizado.size(), outro.normalizado.size()), distanciaMaxima);
+            int distancia = padrao.distancia(outro.normalizado, limite);
+            if (distancia <= limite) {
+                resultado.push_back({outro.id, distancia});
+                vistos.push_back(posicao);
+            }
+        }
+    }
+    std::sort(resultado.begin(), resultado.end(), [](const NomeSemelhante& x, const NomeSemelhante& y) {
+        return x.distancia != y.distancia ? x.distancia < y.distancia : x.id < y.id;
+    });
+    return resultado;
+}
+
+static IndiceNomes* indiceAtivo = nullptr;
+
+void ativarIndiceNomes(IndiceNomes* indice) {
+    indiceAtivo = indice;
+}
+
+void registarNome(const Colaborador& colab) {
+    if (indiceAtivo != nullptr) indiceAtivo->acrescentar(colab);
+}
+
+void retirarNome(const Colaborador& colab) {
+    if (indiceAtivo != nullptr) indiceAtivo->retirar(colab.id);
+}
+
+std::vector<NomeSemelhante> procurarNomesSemelhantes(const std::vector<Colaborador>& lista, const std::string& nome,
+                                                     int distanciaMaxima) {
+    if (indiceAtivo != nullptr) return indiceAtivo->semelhantes(nome, distanciaMaxima);
+
+    std::vector<NomeSemelhante> resultado;
+    const std::string normalizado = normalizarNome(nome);
+    if (normalizado.empty()) return resultado;
+    const PadraoEdicao padrao(normalizado);
+    for (const auto& colab : lista) {
+        const std::string outro = normalizarNome(colab.nome);
+        const int limite = limiteDistancia(std::min(normalizado.size(), outro.size()), distanciaMaxima);
+        int distancia = padrao.distancia(outro, limite);
+        if (distancia <= limite) resultado.push_back({colab.id, distancia});
+    }
+    std::sort(resultado.begin(), resultado.end(), [](const NomeSemelhante& x, const NomeSemelhante& y) {
+        return x.distancia != y.distancia ? x.distancia < y.distancia : x.id < y.id;
+    });
+    return resultado;
+}
+
+// ===============================================
+// MENU
+// ===============================================
+
+void menuDuplicados(const std::vector<Colaborador>& lista) {
+    std::cout << COR_AZUL << "\n--- Detetar Nomes Duplicados ---\n" << RESET_COR;
+    std::cout << "Os nomes sao comparados sem maiusculas, acentos nem espacos repetidos.\n";
+    std::cout << "Distancia maxima (letras diferentes, ENTER = " << DISTANCIA_DUPLICADOS << "): ";
+    std::string texto;
+    std::getline(std::cin, texto);
+    int distanciaMaxima = DISTANCIA_DUPLICADOS;
+    if (!texto.empty()) {
+        try {
+            distanciaMaxima = std::stoi(texto);
+        } catch (const std::exception&) {
+            distanciaMaxima = -1;
+        }
+        if (distanciaMaxima < 0 || distanciaMaxima > 10) {
+            std::cout << COR_VERMELHA << "ERRO: Distancia invalida (0 a 10).\n" << RESET_COR;
+            return;
+        }
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<ParDuplicado> pares = detetarDuplicados(lista, distanciaMaxima);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+
+    if (pares.empty()) {
+        std::cout << COR_VERDE << "Nenhum nome duplicado ou semelhante em " << lista.size() << " colaboradores.\n" << RESET_COR;
+        return;
+    }
+    const size_t limite = 50;
+    std::cout << COR_CIANO << std::left << std::setw(7) << "ID" << std::setw(28) << "Nome" << std::setw(7) << "ID"
+              << std::setw(28) << "Nome" << "Distancia" << RESET_COR << "\n";
+    for (size_t i = 0; i < pares.size() && i < limite; ++i) {
+        const Colaborador& a = lista[pares[i].a];
+        const Colaborador& b = lista[pares[i].b];
+        std::cout << std::left << std::setw(7) << a.id << std::setw(28) << a.nome.substr(0, 27) << std::setw(7) << b.id
+                  << std::setw(28) << b.nome.substr(0, 27);
+        if (pares[i].distancia == 0) {
+            std::cout << COR_VERMELHA << "igual" << RESET_COR << "\n";
+        } else {
+            std::cout << pares[i].distancia << "\n";
+        }
+    }
+    if (pares.size() > limite) {
+        std::cout << "... e mais " << pares.size() - limite << " pares.\n";
+    }
+    std::cout << COR_AMARELA << pares.size() << " pares em " << lista.size() << " colaboradores (" << std::fixed
+              << std::setprecision(1) << ms << " ms).\n" << RESET_COR << std::defaultfloat << std::setprecision(6);
+}
@@ -0,0 +1,89 @@
+#ifndef DUPLICADOS_H
+#define DUPLICADOS_H
+
+#include "colaborador.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// ===============================================
+// NOMES DUPLICADOS E SEMELHANTES
+// ===============================================
+// Os nomes são comparados normalizados (minúsculas, sem acentos, um espaço entre palavras) e com
+// distância de edição pequena ("Vanesa Silva" / "Vanessa Silva" = 1). A distância é calculada com
+// o algoritmo bit-paralelo de Myers: o nome mais curto (até 64 caracteres) cabe numa palavra de 64
+// bits e cada carácter do outro nome custa meia dúzia de operações.
+//
+// Para não comparar todos os pares, cada nome tem duas chaves de bloco: as duas primeiras letras do
+// primeiro e do último nome, e as duas últimas letras dos mesmos. Só os nomes com uma chave em comum
+// são comparados, por isso um erro só escapa se afetar o início e o fim dos nomes ao mesmo tempo.
+// A deteção em lote distribui os blocos pelas threads; o IndiceNomes mantém os blocos para verificar
+// um nome novo sem percorrer a lista.
+
+const int DISTANCIA_DUPLICADOS = 2; // Distância máxima por omissão (nomes com 10 ou mais letras)
+
+// Minúsculas, sem acentos, só letras/dígitos e um espaço entre palavras
+std::string normalizarNome(const std::string& nome);
+
+// Distância máxima aceite entre dois nomes normalizados: 1 por cada 5 letras do mais curto, até 'maxima'
+int limiteDistancia(size_t tamanhoMenor, int maxima);
+
+// Padrão pré-processado para o algoritmo de Myers (reutilizado contra vários textos)
+struct PadraoEdicao {
+    explicit PadraoEdicao(const std::string& padrao);
+
+    // Distância de edição até ao texto, ou limite + 1 se for maior que limite
+    int distancia(const std::string& texto, int limite) const;
+
+    std::string padrao;
+    uint64_t mascaras[256]; // Bit i ligado se padrao[i] for o carácter
+};
+
+struct ParDuplicado {
+    uint32_t a = 0; // Posições na lista (a < b)
+    uint32_t b = 0;
+    int distancia = 0;
+};
+
+// Pares de nomes semelhantes na lista inteira, por distância e posição
+std::vector<ParDuplicado> detetarDuplicados(const std::vector<Colaborador>& lista, int distanciaMaxima = DISTANCIA_DUPLICADOS);
+
+struct NomeSemelhante {
+    int id = 0;
+    int distancia = 0;
+};
+
+struct IndiceNomes {
+    void construir(const std::vector<Colaborador>& lista);
+    void acrescentar(const Colaborador& colab);
+    void retirar(int id);
+
+    // Colaboradores com nome igual ou semelhante, por distância
+    std::vector<NomeSemelhante> semelhantes(const std::string& nome, int distanciaMaxima = DISTANCIA_DUPLICADOS) const;
+
+private:
+    struct NomeIndexado {
+        int id = 0;
+        std::string normalizado;
+        bool ativo = true;
+    };
+
+    std::vector<NomeIndexado> nomes;
+    std::unordered_map<std::string, std::vector<uint32_t>> blocos;
+    std::unordered_map<int, uint32_t> porId;
+};
+
+// Ganchos de adicionar/remover colaborador: atualizam o índice ativo (se houver)
+void ativarIndiceNomes(IndiceNomes* indice);
+void registarNome(const Colaborador& colab);
+void retirarNome(const Colaborador& colab);
+
+// Nomes semelhantes a 'nome' (pelo índice ativo ou, sem índice, comparando com toda a lista)
+std::vector<NomeSemelhante> procurarNomesSemelhantes(const std::vector<Colaborador>& lista, const std::string& nome,
+                                                     int distanciaMaxima = DISTANCIA_DUPLICADOS);
+
+// Opção do menu: deteção em lote com a distância escolhida
+void menuDuplicados(const std::vector<Colaborador>& lista);
+
+#endif // DUPLICADOS_H
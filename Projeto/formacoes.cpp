@@ -0,0 +1,221 @@
+#include "formacoes.h"
+#include "calendario.h"
+#include "cores.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+
+std::string chaveCurso(const std::string& nome) {
+    std::string chave;
+    chave.reserve(nome.size());
+    bool espaco = false;
+    for (char c : nome) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            espaco = !chave.empty();
+            continue;
+        }
+        if (espaco) chave += ' ';
+        espaco = false;
+        chave += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return chave;
+}
+
+static std::string textoSerial(int serial) {
+    if (serial == SERIAL_INVALIDO) return "(sem data)";
+    int dia = 0, mes = 0, ano = 0;
+    serialParaData(serial, dia, mes, ano);
+    std::ostringstream texto;
+    texto << std::setw(2) << std::setfill('0') << dia << "/" << std::setw(2) << mes << "/" << ano;
+    return texto.str();
+}
+
+// ===============================================
+// CONSTRUÇÃO
+// ===============================================
+
+void IndiceFormacoes::limpar() {
+    colaboradores.clear();
+    cursos.clear();
+    registos.clear();
+    porCurso.clear();
+    porData.clear();
+    semData = 0;
+    cursoPorChave.clear();
+}
+
+void IndiceFormacoes::acrescentar(const std::vector<Colaborador>& parte) {
+    for (const auto& colab : parte) {
+        if (colab.formacoes.empty()) continue;
+        const uint32_t posicao = static_cast<uint32_t>(colaboradores.size());
+        colaboradores.push_back({colab.id, colab.nome, colab.departamento});
+
+        for (const auto& formacao : colab.formacoes) {
+            auto [it, novo] = cursoPorChave.try_emplace(chaveCurso(formacao.nome_curso), static_cast<uint32_t>(cursos.size()));
+            if (novo) {
+                cursos.push_back(formacao.nome_curso);
+                porCurso.emplace_back();
+            }
+            RegistoFormacao registo;
+            registo.colaborador = posicao;
+            registo.curso = it->second;
+            registo.idCurso = formacao.id_curso;
+            registo.data = dataTextoParaSerial(formacao.data_conclusao);
+
+            const uint32_t r = static_cast<uint32_t>(registos.size());
+            registos.push_back(registo);
+            porCurso[it->second].push_back(r);
+            if (registo.data == SERIAL_INVALIDO) {
+                ++semData;
+            } else {
+                porData.push_back(r);
+            }
+        }
+    }
+}
+
+void IndiceFormacoes::finalizar() {
+    auto porDataDoRegisto = [this](uint32_t a, uint32_t b) { return registos[a].data < registos[b].data; };
+    for (auto& lista : porCurso) std::stable_sort(lista.begin(), lista.end(), porDataDoRegisto);
+    std::stable_sort(porData.begin(), porData.end(), porDataDoRegisto);
+}
+
+void IndiceFormacoes::construir(const std::vector<Colaborador>& lista) {
+    limpar();
+    acrescentar(lista);
+    finalizar();
+}
+
+IndiceFormacoes construirIndiceFormacoes(const PercorrerEmpresa& empresa) {
+    IndiceFormacoes indice;
+    empresa([&](const std::vector<Colaborador>& parte) { indice.acrescentar(parte); });
+    indice.finalizar();
+    return indice;
+}
+
+// ===============================================
+// PESQUISAS
+// ===============================================
+
+long IndiceFormacoes::procurarCurso(const std::string& nome) const {
+    auto it = cursoPorChave.find(chaveCurso(nome));
+    return it == cursoPorChave.end() ? -1 : static_cast<long>(it->second);
+}
+
+// Sublista [inicio, fim] de uma lista de registos ordenada por data
+static std::vector<uint32_t> intervaloPorData(const std::vector<RegistoFormacao>& registos, const std::vector<uint32_t>& lista,
+                                              int inicio, int fim) {
+    auto primeiro = std::lower_bound(lista.begin(), lista.end(), inicio,
+                                     [&](uint32_t r, int data) { return registos[r].data < data; });
+    auto ultimo = std::upper_bound(primeiro, lista.end(), fim,
+                                   [&](int data, uint32_t r) { return data < registos[r].data; });
+    return std::vector<uint32_t>(primeiro, ultimo);
+}
+
+std::vector<uint32_t> IndiceFormacoes::concluidos(uint32_t curso, int inicio, int fim) const {
+    if (curso >= porCurso.size()) return {};
+    return intervaloPorData(registos, porCurso[curso], inicio, fim);
+}
+
+std::vector<uint32_t> IndiceFormacoes::concluidosEntre(int inicio, int fim) const {
+    return intervaloPorData(registos, porData, inicio, fim);
+}
+
+// ===============================================
+// APRESENTAÇÃO E MENU
+// ===============================================
+
+void mostrarRegistosFormacao(const IndiceFormacoes& indice, const std::vector<uint32_t>& registos, size_t limite) {
+    if (registos.empty()) {
+        std::cout << COR_AMARELA << "Nenhuma formacao encontrada.\n" << RESET_COR;
+        return;
+    }
+    std::cout << COR_CIANO << std::left << std::setw(7) << "ID" << std::setw(28) << "Nome" << std::setw(16) << "Departamento"
+              << std::setw(30) << "Curso" << "Conclusao" << RESET_COR << "\n";
+    for (size_t i = 0; i < registos.size() && i < limite; ++i) {
+        const RegistoFormacao& registo = indice.registos[registos[i]];
+        const ColaboradorFormacao& colab = indice.colaboradores[registo.colaborador];
+        std::cout << std::left << std::setw(7) << colab.id << std::setw(28) << colab.nome.substr(0, 27)
+                  << std::setw(16) << colab.departamento.substr(0, 15) << std::setw(30) << indice.cursos[registo.curso].substr(0, 29)
+                  << textoSerial(registo.data) << "\n";
+    }
+    if (registos.size() > limite) {
+        std::cout << "... e mais " << registos.size() - limite << " formacoes.\n";
+    }
+    std::cout << COR_VERDE << registos.size() << " formacoes encontradas.\n" << RESET_COR;
+}
+
+// Lê uma data dd/mm/aaaa. Retorna SERIAL_INVALIDO se a data não for válida.
+static int pedirData(const std::string& pergunta) {
+    std::string texto;
+    std::cout << pergunta;
+    std::getline(std::cin, texto);
+    int serial = dataTextoParaSerial(texto);
+    if (serial == SERIAL_INVALIDO) std::cout << COR_VERMELHA << "ERRO: Data invalida (use dd/mm/aaaa).\n" << RESET_COR;
+    return serial;
+}
+
+void menuPesquisaFormacoes(const IndiceFormacoes& indice) {
+    std::cout << COR_AZUL << "\n--- Pesquisar Formacoes (Empresa) ---\n" << RESET_COR;
+    std::cout << indice.registos.size() << " formacoes de " << indice.colaboradores.size() << " colaboradores em "
+              << indice.cursos.size() << " cursos";
+    if (indice.semData > 0) std::cout << " (" << indice.semData << " sem data valida)";
+    std::cout << ".\n";
+    std::cout << " 1. Quem Concluiu um Curso\n";
+    std::cout << " 2. Certificacoes com Mais de N Anos\n";
+    std::cout << " 3. Formacoes Concluidas entre Duas Datas\n";
+    std::cout << COR_AMARELA << " Opcao: " << RESET_COR;
+
+    std::string texto;
+    std::getline(std::cin, texto);
+    if (texto == "1" || texto == "2") {
+        std::string curso;
+        std::cout << (texto == "1" ? "Nome do curso: " : "Nome do curso (ENTER = todos): ");
+        std::getline(std::cin, curso);
+        long posicaoCurso = curso.empty() ? -1 : indice.procurarCurso(curso);
+        if (!curso.empty() && posicaoCurso < 0) {
+            std::cout << COR_AMARELA << "Ninguem concluiu o curso '" << curso << "'.\n" << RESET_COR;
+            return;
+        }
+        if (texto == "1") {
+            if (curso.empty()) {
+                std::cout << COR_VERMELHA << "ERRO: Nome do curso obrigatorio.\n" << RESET_COR;
+                return;
+            }
+            mostrarRegistosFormacao(indice, indice.concluidos(static_cast<uint32_t>(posicaoCurso)));
+            return;
+        }
+
+        int anos = 0;
+        std::cout << "Numero de anos: ";
+        std::getline(std::cin, texto);
+        try {
+            anos = std::stoi(texto);
+        } catch (const std::exception&) {
+            anos = -1;
+        }
+        if (anos < 0) {
+            std::cout << COR_VERMELHA << "ERRO: Numero de anos invalido.\n" << RESET_COR;
+            return;
+        }
+        // Concluídas antes de hoje menos N anos (29/02 passa a 28/02 num ano comum)
+        const int limite = somarMeses(serialHoje(), -12 * anos) - 1;
+        std::cout << "Concluidas ate " << textoSerial(limite) << ":\n";
+        mostrarRegistosFormacao(indice, posicaoCurso < 0 ? indice.concluidosEntre(SERIAL_INVALIDO + 1, limite)
+                                                        : indice.concluidos(static_cast<uint32_t>(posicaoCurso), SERIAL_INVALIDO + 1, limite));
+    } else if (texto == "3") {
+        int inicio = pedirData("Data inicial (dd/mm/aaaa): ");
+        if (inicio == SERIAL_INVALIDO) return;
+        int fim = pedirData("Data final (dd/mm/aaaa): ");
+        if (fim == SERIAL_INVALIDO) return;
+        if (inicio > fim) {
+            std::cout << COR_VERMELHA << "ERRO: A data inicial e posterior a data final.\n" << RESET_COR;
+            return;
+        }
+        mostrarRegistosFormacao(indice, indice.concluidosEntre(inicio, fim));
+    } else {
+        std::cout << COR_VERMELHA << "Opcao invalida.\n" << RESET_COR;
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef FORMACOES_H
+#define FORMACOES_H
+
+#include "colaborador.h"
+#include "reports.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// ===============================================
+// ÍNDICE DE FORMAÇÕES DA EMPRESA
+// ===============================================
+// Responde a "quem concluiu o curso X" e "que formações foram concluídas antes de/entre datas"
+// sem percorrer os colaboradores nem voltar a ler as datas:
+//   - cada formação é um registo com a data de conclusão já convertida para data em série;
+//   - por curso (nome sem distinguir maiúsculas nem espaços repetidos) há uma lista de registos
+//     ordenada por data, por isso "curso X antes de D" é uma pesquisa binária + os resultados;
+//   - um índice secundário com todos os registos ordenados por data serve os intervalos.
+// O índice é uma fotografia: é reconstruído depois de alterar colaboradores ou formações.
+
+// Chave do curso: minúsculas, sem espaços nas pontas e com um só espaço entre palavras
+std::string chaveCurso(const std::string& nome);
+
+struct ColaboradorFormacao {
+    int id = 0;
+    std::string nome;
+    std::string departamento;
+};
+
+struct RegistoFormacao {
+    uint32_t colaborador = 0; // Índice em IndiceFormacoes::colaboradores
+    uint32_t curso = 0;       // Índice em IndiceFormacoes::cursos
+    int idCurso = 0;
+    int data = 0;             // Data em série (SERIAL_INVALIDO se data_conclusao não for dd/mm/aaaa)
+};
+
+struct IndiceFormacoes {
+    std::vector<ColaboradorFormacao> colaboradores;
+    std::vector<std::string> cursos;             // Nome como aparece na primeira formação do curso
+    std::vector<RegistoFormacao> registos;
+    std::vector<std::vector<uint32_t>> porCurso; // Curso -> registos, por data
+    std::vector<uint32_t> porData;               // Registos com data válida, por data
+    size_t semData = 0;                          // Registos com data inválida (só aparecem por curso)
+
+    void limpar();
+    void acrescentar(const std::vector<Colaborador>& parte); // Chamar finalizar() no fim
+    void finalizar();                                        // Ordena as listas por data
+    void construir(const std::vector<Colaborador>& lista);   // limpar + acrescentar + finalizar
+
+    // Índice do curso (-1 se ninguém o concluiu)
+    long procurarCurso(const std::string& nome) const;
+
+    // Registos de um curso com data em [inicio, fim] (os sem data só entram sem limites)
+    std::vector<uint32_t> concluidos(uint32_t curso, int inicio = SERIAL_INVALIDO, int fim = 1 << 30) const;
+
+    // Registos de todos os cursos com data em [inicio, fim]
+    std::vector<uint32_t> concluidosEntre(int inicio, int fim) const;
+
+private:
+    std::unordered_map<std::string, uint32_t> cursoPorChave;
+};
+
+IndiceFormacoes construirIndiceFormacoes(const PercorrerEmpresa& empresa);
+
+// Tabela ID / Nome / Departamento / Curso / Conclusão (no máximo 'limite' linhas)
+void mostrarRegistosFormacao(const IndiceFormacoes& indice, const std::vector<uint32_t>& registos, size_t limite = 50);
+
+// Opção do menu: pesquisa por curso, por antiguidade da certificação ou por intervalo de datas
+void menuPesquisaFormacoes(const IndiceFormacoes& indice);
+
+#endif // FORMACOES_H
@@ -0,0 +1,247 @@
+#include "fragmentos.h"
+#include "io.h"
+#include "cifra.h"
+#include "cores.h"
+#include "metricas.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <algorithm>
+#include <cstdio>
+
+const std::string MANIFESTO_POR_OMISSAO = "rh_manifesto.txt";
+
+// ===============================================
+// MANIFESTO
+// ===============================================
+
+bool ArmazemFragmentado::lerManifesto(const std::string& nomeFicheiro) {
+    std::ifstream ficheiro(nomeFicheiro);
+    if (!ficheiro.is_open()) return false;
+
+    std::string linha;
+    if (!std::getline(ficheiro, linha) || linha.compare(0, 11, "#manifesto;") != 0) {
+        std::cerr << COR_VERMELHA << "ERRO: " << nomeFicheiro << " nao e um manifesto valido.\n" << RESET_COR;
+        return false;
+    }
+    ficheiroManifesto = nomeFicheiro;
+    fragmentos.clear();
+    try {
+        proximoId = std::stoi(linha.substr(11));
+    } catch (const std::exception& e) {
+        proximoId = 1;
+    }
+
+    while (std::getline(ficheiro, linha)) {
+        if (linha.empty()) continue;
+        std::stringstream ss(linha);
+        std::string deptoCifrado, nome, num;
+        std::getline(ss, deptoCifrado, ';');
+        std::getline(ss, nome, ';');
+        std::getline(ss, num, ';');
+        if (nome.empty()) continue;
+
+        EntradaManifesto entrada;
+        entrada.departamento = cifraDados().decifrar(deptoCifrado);
+        entrada.ficheiro = nome;
+        try {
+            entrada.colaboradores = static_cast<size_t>(std::stoul(num));
+        } catch (const std::exception& e) {
+            entrada.colaboradores = 0;
+        }
+        fragmentos.push_back(entrada);
+    }
+    return true;
+}
+
+bool ArmazemFragmentado::escreverManifesto() const {
+    const std::string temporario = ficheiroManifesto + ".tmp";
+    {
+        std::ofstream ficheiro(temporario, std::ios::binary);
+        if (!ficheiro.is_open()) return false;
+        ficheiro << "#manifesto;" << proximoId << "\n";
+        for (const auto& f : fragmentos) {
+            ficheiro << cifraDados().cifrar(f.departamento) << ";" << f.ficheiro << ";" << f.colaboradores << "\n";
+        }
+        if (!ficheiro) return false;
+    }
+    return publicarFicheiro(temporario, ficheiroManifesto);
+}
+
+bool ArmazemFragmentado::noAmbito(const std::string& departamento) const {
+    return ambito.empty() || ambito.count(departamento) > 0;
+}
+
+const EntradaManifesto* ArmazemFragmentado::procurar(const std::string& departamento) const {
+    for (const auto& f : fragmentos) {
+        if (f.departamento == departamento) return &f;
+    }
+    return nullptr;
+}
+
+size_t ArmazemFragmentado::totalColaboradores() const {
+    size_t total = 0;
+    for (const auto& f : fragmentos) total += f.colaboradores;
+    return total;
+}
+
+// Nome livre para o fragmento de um departamento novo (rh_depto_001.txt, ...)
+static std::string novoNomeFragmento(const ArmazemFragmentado& armazem) {
+    for (size_t n = armazem.fragmentos.size() + 1;; ++n) {
+        std::ostringstream nome;
+        nome << "rh_depto_" << std::setw(3) << std::setfill('0') << n << ".txt";
+        bool usado = std::any_of(armazem.fragmentos.begin(), armazem.fragmentos.end(),
+                                 [&](const EntradaManifesto& f) { return f.ficheiro == nome.str(); });
+        if (!usado) return nome.str();
+    }
+}
+
+// Posições dos colaboradores da lista agrupadas por departamento
+static std::map<std::string, std::vector<size_t>> agruparPorDepartamento(const std::vector<Colaborador>& lista) {
+    std::map<std::string, std::vector<size_t>> grupos;
+    for (size_t i = 0; i < lista.size(); ++i) grupos[lista[i].departamento].push_back(i);
+    return grupos;
+}
+
+// ===============================================
+// GRAVAÇÃO E CARGA
+// ===============================================
+
+// Grava os fragmentos sem mensagens. Retorna o número de fragmentos gravados (ou -1 se algum falhar).
+static int gravarFragmentos(ArmazemFragmentado& armazem, const std::vector<Colaborador>& lista) {
+    auto grupos = agruparPorDepartamento(lista);
+    int gravados = 0;
+
+    for (const auto& grupo : grupos) {
+        std::vector<Colaborador> parte;
+        const EntradaManifesto* existente = armazem.procurar(grupo.first);
+        if (existente != nullptr && !armazem.noAmbito(grupo.first)) {
+            // Departamento não carregado: manter o que já está no disco e juntar os novos
+            lerFicheiroDados(parte, existente->ficheiro);
+        }
+        for (size_t i : grupo.second) parte.push_back(lista[i]);
+
+        std::string nome;
+        if (existente != nullptr) {
+            nome = existente->ficheiro;
+        } else {
+            nome = novoNomeFragmento(armazem);
+            armazem.fragmentos.push_back({grupo.first, nome, 0});
+        }
+        if (!escreverFicheiroDados(parte, nome)) return -1;
+        for (auto& f : armazem.fragmentos) {
+            if (f.departamento == grupo.first) f.colaboradores = parte.size();
+        }
+        ++gravados;
+    }
+
+    // Departamentos do âmbito que ficaram sem colaboradores (todos removidos)
+    for (auto& f : armazem.fragmentos) {
+        if (armazem.noAmbito(f.departamento) && grupos.count(f.departamento) == 0 && f.colaboradores > 0) {
+            if (!escreverFicheiroDados({}, f.ficheiro)) return -1;
+            f.colaboradores = 0;
+            ++gravados;
+        }
+    }
+
+    armazem.proximoId = std::max(armazem.proximoId, getProximoId(lista));
+    if (!armazem.escreverManifesto()) return -1;
+    // Tudo o que estava no journal do autosave está agora nos fragmentos
+    std::remove(nomeJournal(armazem.ficheiroManifesto).c_str());
+    return gravados;
+}
+
+void guardarFragmentos(ArmazemFragmentado& armazem, const std::vector<Colaborador>& lista) {
+    MEDIR_ESCOPO(Metrica::GUARDAR_DADOS);
+    int gravados = gravarFragmentos(armazem, lista);
+    if (gravados < 0) {
+        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel gravar os fragmentos de " << armazem.ficheiroManifesto << ".\n" << RESET_COR;
+        return;
+    }
+    CONTAR_EVENTO(Contador::COLABORADORES_GUARDADOS, lista.size());
+    std::cout << COR_VERDE << "[INFO] " << lista.size() << " colaboradores guardados em " << gravados
+              << " fragmentos de departamento (" << armazem.ficheiroManifesto << ").\n" << RESET_COR;
+}
+
+bool criarFragmentos(const std::vector<Colaborador>& lista, const std::string& ficheiroManifesto) {
+    ArmazemFragmentado armazem;
+    armazem.ficheiroManifesto = ficheiroManifesto;
+    int gravados = gravarFragmentos(armazem, lista);
+    if (gravados < 0) {
+        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel criar os fragmentos.\n" << RESET_COR;
+        return false;
+    }
+    std::cout << COR_VERDE << "[INFO] " << lista.size() << " colaboradores divididos em " << gravados
+              << " fragmentos de departamento (" << ficheiroManifesto << ").\n" << RESET_COR;
+    return true;
+}
+
+void carregarFragmentos(ArmazemFragmentado& armazem, std::vector<Colaborador>& lista) {
+    MEDIR_ESCOPO(Metrica::CARREGAR_DADOS);
+    lista.clear();
+
+    // Recuperação: o journal pode ter alterações de qualquer departamento
+    if (std::ifstream(nomeJournal(armazem.ficheiroManifesto)).is_open()) {
+        std::set<std::string> ambito;
+        std::swap(ambito, armazem.ambito);
+        std::vector<Colaborador> todos;
+        for (const auto& f : armazem.fragmentos) lerFicheiroDados(todos, f.ficheiro);
+        size_t recuperadas = aplicarJournal(todos, armazem.ficheiroManifesto);
+        if (gravarFragmentos(armazem, todos) >= 0) {
+            std::cout << COR_AMARELA << "[INFO] " << recuperadas << " alteracoes recuperadas do autosave ("
+                      << nomeJournal(armazem.ficheiroManifesto) << ").\n" << RESET_COR;
+        }
+        std::swap(ambito, armazem.ambito);
+    }
+
+    size_t carregados = 0;
+    for (const auto& f : armazem.fragmentos) {
+        if (!armazem.noAmbito(f.departamento)) continue;
+        if (!lerFicheiroDados(lista, f.ficheiro)) {
+            std::cerr << COR_AMARELA << "[AVISO] Fragmento " << f.ficheiro << " (" << f.departamento << ") nao encontrado.\n" << RESET_COR;
+            continue;
+        }
+        ++carregados;
+    }
+    for (const auto& depto : armazem.ambito) {
+        if (armazem.procurar(depto) == nullptr) {
+            std::cerr << COR_AMARELA << "[AVISO] Departamento '" << depto << "' nao existe no manifesto.\n" << RESET_COR;
+        }
+    }
+
+    armazem.proximoId = std::max(armazem.proximoId, getProximoId(lista));
+    CONTAR_EVENTO(Contador::COLABORADORES_CARREGADOS, lista.size());
+    std::cout << COR_VERDE << "[INFO] " << lista.size() << " colaboradores carregados de " << carregados << " de "
+              << armazem.fragmentos.size() << " departamentos (" << armazem.totalColaboradores() << " na empresa).\n" << RESET_COR;
+}
+
+// ===============================================
+// PERCORRER A EMPRESA
+// ===============================================
+
+void percorrerFragmentos(const ArmazemFragmentado& armazem, const std::vector<Colaborador>& lista,
+                         const VisitarParte& visitar) {
+    auto grupos = agruparPorDepartamento(lista);
+
+    for (const auto& f : armazem.fragmentos) {
+        std::vector<Colaborador> parte;
+        if (!armazem.noAmbito(f.departamento)) {
+            lerFicheiroDados(parte, f.ficheiro); // Fora do âmbito: vem do disco
+        }
+        auto it = grupos.find(f.departamento);
+        if (it != grupos.end()) {
+            for (size_t i : it->second) parte.push_back(lista[i]);
+            grupos.erase(it);
+        }
+        if (!parte.empty()) visitar(parte);
+    }
+
+    // Departamentos criados nesta sessão (ainda não estão no manifesto)
+    for (const auto& grupo : grupos) {
+        std::vector<Colaborador> parte;
+        for (size_t i : grupo.second) parte.push_back(lista[i]);
+        visitar(parte);
+    }
+}
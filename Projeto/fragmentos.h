@@ -0,0 +1,58 @@
+#ifndef FRAGMENTOS_H
+#define FRAGMENTOS_H
+
+#include "colaborador.h"
+#include "reports.h"
+#include <string>
+#include <vector>
+#include <set>
+
+// ===============================================
+// FRAGMENTOS POR DEPARTAMENTO
+// ===============================================
+// Em vez de um único rh_data.txt, cada departamento tem o seu ficheiro (rh_depto_NNN.txt, no
+// mesmo formato, com índice) e um manifesto lista os fragmentos:
+//   #manifesto;<proximoId>
+//   <DepartamentoCifrado>;<ficheiro>;<numColaboradores>
+// O programa pode arrancar só com alguns departamentos (o "âmbito"). As operações da empresa
+// inteira percorrem os fragmentos um de cada vez: os do âmbito a partir da lista em memória
+// (com as alterações ainda não gravadas), os restantes lidos do disco e libertados a seguir.
+
+extern const std::string MANIFESTO_POR_OMISSAO;
+
+struct EntradaManifesto {
+    std::string departamento;
+    std::string ficheiro;
+    size_t colaboradores = 0;
+};
+
+struct ArmazemFragmentado {
+    std::string ficheiroManifesto;
+    std::vector<EntradaManifesto> fragmentos;
+    int proximoId = 1;             // Próximo ID livre na empresa inteira
+    std::set<std::string> ambito;  // Departamentos carregados (vazio = todos)
+
+    bool lerManifesto(const std::string& nomeFicheiro);
+    bool escreverManifesto() const;
+
+    bool noAmbito(const std::string& departamento) const;
+    const EntradaManifesto* procurar(const std::string& departamento) const;
+    size_t totalColaboradores() const;
+};
+
+// Divide uma lista (ex: o rh_data.txt completo) em fragmentos e escreve o manifesto
+bool criarFragmentos(const std::vector<Colaborador>& lista, const std::string& ficheiroManifesto);
+
+// Carrega os fragmentos do âmbito para a lista. Se houver um journal do autosave por aplicar,
+// carrega primeiro a empresa inteira, aplica-o e volta a gravar todos os fragmentos.
+void carregarFragmentos(ArmazemFragmentado& armazem, std::vector<Colaborador>& lista);
+
+// Grava os departamentos presentes na lista e o manifesto. Os departamentos do âmbito são
+// substituídos; colaboradores novos em departamentos fora do âmbito são juntados ao fragmento existente.
+void guardarFragmentos(ArmazemFragmentado& armazem, const std::vector<Colaborador>& lista);
+
+// Percorre a empresa um departamento de cada vez (ver PercorrerEmpresa em reports.h)
+void percorrerFragmentos(const ArmazemFragmentado& armazem, const std::vector<Colaborador>& lista,
+                         const VisitarParte& visitar);
+
+#endif // FRAGMENTOS_H
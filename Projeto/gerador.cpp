@@ -0,0 +1,102 @@
+#include "gerador.h"
+#include "calendario.h"
+#include <random>
+#include <algorithm>
+
+// Gera uma palavra aleatória capitalizada (ex: "Qarlevo")
+static std::string gerarPalavra(std::mt19937& rng, int tamanhoMin, int tamanhoMax) {
+    std::uniform_int_distribution<int> distTamanho(tamanhoMin, std::max(tamanhoMin, tamanhoMax));
+    std::uniform_int_distribution<int> distLetra(0, 25);
+    int tamanho = std::max(1, distTamanho(rng));
+
+    std::string palavra;
+    palavra.reserve(static_cast<size_t>(tamanho));
+    palavra += char('A' + distLetra(rng));
+    for (int i = 1; i < tamanho; ++i) {
+        palavra += char('a' + distLetra(rng));
+    }
+    return palavra;
+}
+
+// Formata uma data dd/mm/aaaa (usada nas formações e notas geradas)
+static std::string formatarData(int dia, int mes, int ano) {
+    std::string s;
+    s += char('0' + dia / 10);
+    s += char('0' + dia % 10);
+    s += '/';
+    s += char('0' + mes / 10);
+    s += char('0' + mes % 10);
+    s += '/';
+    s += std::to_string(ano);
+    return s;
+}
+
+std::vector<Colaborador> gerarColaboradores(const ParametrosGerador& p) {
+    std::mt19937 rng(p.semente);
+    std::uniform_real_distribution<double> distProb(0.0, 1.0);
+    std::uniform_int_distribution<int> distDepto(1, std::max(1, p.numDepartamentos));
+    std::uniform_int_distribution<int> distMes(1, 12);
+    std::uniform_int_distribution<int> distDia(1, 28);
+
+    // Dias úteis do ano (calculados uma só vez)
+    std::vector<int> diasUteis;
+    for (int mes = 1; mes <= 12; ++mes) {
+        for (int dia = 1; dia <= diasNoMes(mes, p.ano); ++dia) {
+            int ds = diaSemana(dia, mes, p.ano);
+            if (ds != 0 && ds != 6) {
+                diasUteis.push_back(dataParaDiaDoAno(dia, mes, p.ano));
+            }
+        }
+    }
+
+    std::vector<Colaborador> lista;
+    lista.reserve(p.numColaboradores);
+
+    for (size_t i = 0; i < p.numColaboradores; ++i) {
+        Colaborador colab;
+        colab.id = static_cast<int>(i + 1);
+        colab.nome = gerarPalavra(rng, p.tamanhoNomeMin, p.tamanhoNomeMax) + " " +
+                     gerarPalavra(rng, p.tamanhoNomeMin, p.tamanhoNomeMax);
+
+        int d = distDepto(rng);
+        colab.departamento = "Depto" + std::string(d < 10 ? "0" : "") + std::to_string(d);
+
+        // Cada bloco começa com probabilidade densidade/diasPorBloco, para manter a densidade total
+        const size_t bloco = static_cast<size_t>(std::max(1, p.diasPorBloco));
+        const double probInicio = p.densidadeAusencias / static_cast<double>(bloco);
+        int ferias = 0;
+        for (size_t d = 0; d < diasUteis.size(); ++d) {
+            if (distProb(rng) >= probInicio) continue;
+            bool falta = distProb(rng) < p.fracaoFaltas;
+            for (size_t k = d; k < diasUteis.size() && k < d + bloco; ++k) {
+                if (falta || ferias >= 22) {
+                    colab.calendario[diasUteis[k]] = TipoMarcacao::FALTA;
+                } else {
+                    colab.calendario[diasUteis[k]] = TipoMarcacao::FERIAS;
+                    ++ferias;
+                }
+            }
+            d += bloco - 1;
+        }
+        colab.saldo_ferias = (22 - ferias) * UNIDADES_POR_DIA;
+
+        for (int f = 0; f < p.formacoesPorColaborador; ++f) {
+            Formacao form;
+            form.id_curso = f + 1;
+            form.nome_curso = "Curso " + gerarPalavra(rng, p.tamanhoNomeMin, p.tamanhoNomeMax);
+            form.data_conclusao = formatarData(distDia(rng), distMes(rng), p.ano - 1);
+            colab.formacoes.push_back(form);
+        }
+        for (int n = 0; n < p.notasPorColaborador; ++n) {
+            Nota nota;
+            nota.id_nota = n + 1;
+            nota.texto = "Observacao sobre " + gerarPalavra(rng, p.tamanhoNomeMin, p.tamanhoNomeMax) +
+                         " e " + gerarPalavra(rng, p.tamanhoNomeMin, p.tamanhoNomeMax);
+            nota.data_criacao = formatarData(distDia(rng), distMes(rng), p.ano);
+            colab.notas.push_back(nota);
+        }
+
+        lista.push_back(std::move(colab));
+    }
+    return lista;
+}
@@ -0,0 +1,28 @@
+#ifndef GERADOR_H
+#define GERADOR_H
+
+#include "colaborador.h"
+#include <vector>
+#include <string>
+
+// --- Gerador de Dados Sintéticos (para benchmarks e testes de carga) ---
+
+// Parâmetros configuráveis do conjunto de dados gerado
+struct ParametrosGerador {
+    size_t numColaboradores = 1000;
+    int numDepartamentos = 10;
+    double densidadeAusencias = 0.05; // Fração dos dias úteis do ano com Férias/Falta
+    double fracaoFaltas = 0.2;        // Das ausências, quantas são Faltas (o resto são Férias)
+    int diasPorBloco = 1;             // Ausências em blocos de N dias úteis seguidos (1 = dias soltos)
+    int tamanhoNomeMin = 4;           // Tamanho mínimo de cada palavra do nome
+    int tamanhoNomeMax = 10;          // Tamanho máximo de cada palavra do nome
+    int notasPorColaborador = 2;
+    int formacoesPorColaborador = 1;
+    int ano = 2025;                   // Ano usado para saber quais dias são fins de semana
+    unsigned semente = 42;            // Mesma semente = mesmo conjunto de dados
+};
+
+// Gera uma lista de colaboradores sintéticos com IDs sequenciais (1..N)
+std::vector<Colaborador> gerarColaboradores(const ParametrosGerador& parametros);
+
+#endif // GERADOR_H
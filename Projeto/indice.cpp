@@ -0,0 +1,256 @@
+#include "indice.h"
+#include "io.h"
+#include "cifra.h"
+#include <charconv>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+const std::string MARCA_INDICE = "#indice";
+
+// "IIIIIIIIII;HHHHHHHHHHHHHHHH;OOOOOOOOOOOO;CCCCCCCC\n"
+static const size_t TAMANHO_ENTRADA = 10 + 1 + 16 + 1 + 12 + 1 + 8 + 1;
+// "#rodape;" + 3 campos de 20 dígitos separados por ';' + '\n'
+static const size_t TAMANHO_RODAPE = 8 + 20 + 1 + 20 + 1 + 20 + 1;
+
+uint64_t hashNome(const std::string& nome) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : nome) {
+        h ^= static_cast<uint64_t>(std::tolower(c));
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// ===============================================
+// ESCRITA DO ÍNDICE
+// ===============================================
+
+void ConstrutorIndice::registar(const Colaborador& colab, uint64_t offset, size_t comprimento) {
+    entradas.push_back({colab.id, hashNome(colab.nome), offset, static_cast<uint32_t>(comprimento)});
+}
+
+static void escreverEntrada(std::string& destino, const EntradaIndice& e) {
+    char linha[TAMANHO_ENTRADA + 1];
+    std::snprintf(linha, sizeof(linha), "%010d;%016llx;%012llu;%08u\n",
+                  e.id, static_cast<unsigned long long>(e.hash),
+                  static_cast<unsigned long long>(e.offset), static_cast<unsigned>(e.comprimento));
+    destino.append(linha, TAMANHO_ENTRADA);
+}
+
+std::string ConstrutorIndice::gerar(uint64_t inicio) {
+    std::string texto = MARCA_INDICE + "\n";
+    texto.reserve(texto.size() + 2 * entradas.size() * TAMANHO_ENTRADA + TAMANHO_RODAPE);
+
+    uint64_t inicioPorId = inicio + texto.size();
+    std::sort(entradas.begin(), entradas.end(),
+              [](const EntradaIndice& a, const EntradaIndice& b) { return a.id < b.id; });
+    for (const auto& e : entradas) escreverEntrada(texto, e);
+
+    uint64_t inicioPorNome = inicio + texto.size();
+    std::sort(entradas.begin(), entradas.end(), [](const EntradaIndice& a, const EntradaIndice& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.offset < b.offset;
+    });
+    for (const auto& e : entradas) escreverEntrada(texto, e);
+
+    char rodape[TAMANHO_RODAPE + 1];
+    std::snprintf(rodape, sizeof(rodape), "#rodape;%020llu;%020llu;%020llu\n",
+                  static_cast<unsigned long long>(entradas.size()),
+                  static_cast<unsigned long long>(inicioPorId),
+                  static_cast<unsigned long long>(inicioPorNome));
+    texto.append(rodape, TAMANHO_RODAPE);
+    return texto;
+}
+
+// ===============================================
+// LEITURA A PEDIDO
+// ===============================================
+
+bool FicheiroIndexado::abrir(const std::string& nomeFicheiro) {
+    fechar();
+
+    // Alterações no journal ainda não estão no ficheiro principal
+    if (std::ifstream(nomeJournal(nomeFicheiro)).is_open()) return false;
+
+    ficheiro.open(nomeFicheiro, std::ios::binary | std::ios::ate);
+    if (!ficheiro.is_open()) return false;
+
+    std::streamoff tamanho = ficheiro.tellg();
+    if (tamanho < static_cast<std::streamoff>(TAMANHO_RODAPE)) { fechar(); return false; }
+
+    char rodape[TAMANHO_RODAPE + 1] = {};
+    ficheiro.seekg(tamanho - static_cast<std::streamoff>(TAMANHO_RODAPE));
+    ficheiro.read(rodape, static_cast<std::streamsize>(TAMANHO_RODAPE));
+
+    unsigned long long n = 0, porId = 0, porNome = 0;
+    if (!ficheiro || std::strncmp(rodape, "#rodape;", 8) != 0 ||
+        std::sscanf(rodape + 8, "%20llu;%20llu;%20llu", &n, &porId, &porNome) != 3 ||
+        porNome + n * TAMANHO_ENTRADA > static_cast<unsigned long long>(tamanho)) {
+        fechar();
+        return false;
+    }
+    numEntradas = static_cast<size_t>(n);
+    inicioPorId = porId;
+    inicioPorNome = porNome;
+
+    std::string primeira;
+    ficheiro.seekg(0);
+    std::getline(ficheiro, primeira);
+    versao = std::max(lerVersaoDados(primeira), 1);
+    return true;
+}
+
+void FicheiroIndexado::fechar() {
+    if (ficheiro.is_open()) ficheiro.close();
+    ficheiro.clear();
+    numEntradas = 0;
+    cache.clear();
+    posicaoCache.clear();
+}
+
+bool FicheiroIndexado::lerEntrada(uint64_t inicioSecao, size_t posicao, EntradaIndice& entrada) {
+    char linha[TAMANHO_ENTRADA + 1] = {};
+    ficheiro.clear();
+    ficheiro.seekg(static_cast<std::streamoff>(inicioSecao + posicao * TAMANHO_ENTRADA));
+    ficheiro.read(linha, static_cast<std::streamsize>(TAMANHO_ENTRADA));
+    if (!ficheiro) return false;
+
+    unsigned long long hash = 0, offset = 0;
+    unsigned comprimento = 0;
+    if (std::sscanf(linha, "%10d;%16llx;%12llu;%8u", &entrada.id, &hash, &offset, &comprimento) != 4) return false;
+    entrada.hash = hash;
+    entrada.offset = offset;
+    entrada.comprimento = comprimento;
+    return true;
+}
+
+const Colaborador* FicheiroIndexado::materializar(const EntradaIndice& entrada) {
+    auto it = posicaoCache.find(entrada.id);
+    if (it != posicaoCache.end()) {
+        cache.splice(cache.begin(), cache, it->second);
+        return &cache.front();
+    }
+
+    std::string linha(entrada.comprimento, '\0');
+    ficheiro.clear();
+    ficheiro.seekg(static_cast<std::streamoff>(entrada.offset));
+    ficheiro.read(&linha[0], static_cast<std::streamsize>(linha.size()));
+    if (!ficheiro) return nullptr;
+
+    try {
+        cache.push_front(desserializarColaborador(linha, versao));
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+    posicaoCache[entrada.id] = cache.begin();
+
+    while (cache.size() > std::max<size_t>(capacidadeCache, 1)) {
+        posicaoCache.erase(cache.back().id);
+        cache.pop_back();
+    }
+    return &cache.front();
+}
+
+const Colaborador* FicheiroIndexado::procurarPorId(int id) {
+    if (!aberto()) return nullptr;
+    auto it = posicaoCache.find(id);
+    if (it != posicaoCache.end()) {
+        cache.splice(cache.begin(), cache, it->second);
+        return &cache.front();
+    }
+
+    size_t esquerda = 0, direita = numEntradas;
+    EntradaIndice entrada;
+    while (esquerda < direita) {
+        size_t meio = esquerda + (direita - esquerda) / 2;
+        if (!lerEntrada(inicioPorId, meio, entrada)) return nullptr;
+        if (entrada.id == id) return materializar(entrada);
+        if (entrada.id < id) esquerda = meio + 1; else direita = meio;
+    }
+    return nullptr;
+}
+
+const Colaborador* FicheiroIndexado::procurarPorNome(const std::string& nome) {
+    if (!aberto()) return nullptr;
+    uint64_t alvo = hashNome(nome);
+
+    // Primeira entrada com hash >= alvo
+    size_t esquerda = 0, direita = numEntradas;
+    EntradaIndice entrada;
+    while (esquerda < direita) {
+        size_t meio = esquerda + (direita - esquerda) / 2;
+        if (!lerEntrada(inicioPorNome, meio, entrada)) return nullptr;
+        if (entrada.hash < alvo) esquerda = meio + 1; else direita = meio;
+    }
+
+    // Colisões de hash: confirmar o nome em cada candidato
+    std::string nomeMinusculas = nome;
+    std::transform(nomeMinusculas.begin(), nomeMinusculas.end(), nomeMinusculas.begin(), ::tolower);
+    for (size_t i = esquerda; i < numEntradas; ++i) {
+        if (!lerEntrada(inicioPorNome, i, entrada) || entrada.hash != alvo) break;
+        const Colaborador* colab = materializar(entrada);
+        if (colab == nullptr) continue;
+        std::string candidato = colab->nome;
+        std::transform(candidato.begin(), candidato.end(), candidato.begin(), ::tolower);
+        if (candidato == nomeMinusculas) return colab;
+    }
+    return nullptr;
+}
+
+// ===============================================
+// NOMES CIFRADOS
+// ===============================================
+
+bool NomesCifrados::carregar(const std::string& nomeFicheiro) {
+    std::ifstream ficheiro(nomeFicheiro);
+    if (!ficheiro.is_open()) return false;
+
+    ids.clear();
+    cifrados.clear();
+    claros.clear();
+    // Com César, minúsculas do texto cifrado = texto cifrado das minúsculas: guardar já em minúsculas
+    minusculas = cifraDados().preservaEstrutura;
+    std::string linha;
+    while (std::getline(ficheiro, linha)) {
+        if (linha == MARCA_INDICE) break;
+        if (lerVersaoDados(linha) != 0) continue;
+        // Nome;Depto;ID;... - o resto da linha não é lido
+        size_t fimNome = linha.find(';');
+        size_t fimDepto = fimNome == std::string::npos ? std::string::npos : linha.find(';', fimNome + 1);
+        if (fimDepto == std::string::npos) continue;
+        int id = 0;
+        if (std::from_chars(linha.data() + fimDepto + 1, linha.data() + linha.size(), id).ec != std::errc()) continue;
+        ids.push_back(id);
+        cifrados.push_back(linha.substr(0, fimNome));
+        if (minusculas) std::transform(cifrados.back().begin(), cifrados.back().end(), cifrados.back().begin(), ::tolower);
+    }
+    lido = true;
+    return true;
+}
+
+std::vector<int> NomesCifrados::procurar(const std::string& parte, size_t limite) {
+    std::vector<int> resultado;
+    std::string consulta = parte;
+    std::transform(consulta.begin(), consulta.end(), consulta.begin(), ::tolower);
+    const Cifra& cifra = cifraDados();
+
+    if (cifra.preservaEstrutura && minusculas) {
+        // A consulta cifrada continua em minúsculas, tal como os nomes cifrados guardados
+        const std::string consultaCifrada = cifra.cifrar(consulta);
+        for (size_t i = 0; i < cifrados.size() && resultado.size() < limite; ++i) {
+            if (cifrados[i].find(consultaCifrada) != std::string::npos) resultado.push_back(ids[i]);
+        }
+        return resultado;
+    }
+
+    // Sem estrutura: os nomes são decifrados à medida que a pesquisa avança e ficam em cache
+    for (size_t i = 0; i < cifrados.size() && resultado.size() < limite; ++i) {
+        if (i == claros.size()) {
+            claros.push_back(cifra.decifrar(cifrados[i]));
+            std::transform(claros.back().begin(), claros.back().end(), claros.back().begin(), ::tolower);
+        }
+        if (claros[i].find(consulta) != std::string::npos) resultado.push_back(ids[i]);
+    }
+    return resultado;
+}
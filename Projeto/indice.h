@@ -0,0 +1,104 @@
+#ifndef INDICE_H
+#define INDICE_H
+
+#include "colaborador.h"
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <fstream>
+#include <cstdint>
+
+// ===============================================
+// ÍNDICE DO FICHEIRO DE DADOS (CARGA A PEDIDO)
+// ===============================================
+// O rh_data.txt continua a ter uma linha por colaborador. A seguir às linhas de dados, o
+// guardarDados acrescenta um índice em três partes:
+//   #indice                                          (o carregarDados pára aqui)
+//   entradas ordenadas por ID                         "IIIIIIIIII;HHHHHHHHHHHHHHHH;OOOOOOOOOOOO;CCCCCCCC"
+//   entradas ordenadas pelo hash do nome              (mesmo formato)
+//   #rodape;<numEntradas>;<inicioPorId>;<inicioPorNome>  (largura fixa, últimos bytes do ficheiro)
+// As entradas têm largura fixa, por isso as pesquisas são binárias diretamente no ficheiro:
+// abrir lê apenas o rodapé (tempo constante) e cada pesquisa lê O(log n) entradas e uma linha.
+// Os colaboradores lidos ficam numa cache LRU de registos já desencriptados.
+
+extern const std::string MARCA_INDICE;
+
+// Hash (FNV-1a) do nome em minúsculas, usado na secção ordenada por nome
+uint64_t hashNome(const std::string& nome);
+
+struct EntradaIndice {
+    int id = 0;
+    uint64_t hash = 0;
+    uint64_t offset = 0;      // Início da linha do colaborador no ficheiro
+    uint32_t comprimento = 0; // Tamanho da linha (sem o '\n')
+};
+
+// Acumula as entradas enquanto as linhas de dados são escritas
+struct ConstrutorIndice {
+    std::vector<EntradaIndice> entradas;
+
+    void registar(const Colaborador& colab, uint64_t offset, size_t comprimento);
+    void limpar() { entradas.clear(); }
+
+    // Texto do índice (marca, duas secções e rodapé) para escrever a partir de 'inicio'
+    std::string gerar(uint64_t inicio);
+};
+
+// Acesso a pedido a um ficheiro com índice
+struct FicheiroIndexado {
+    // Abre o ficheiro lendo só o rodapé. Retorna false se não houver índice
+    // ou se existir um journal do autosave por aplicar (nesse caso é preciso a carga completa).
+    bool abrir(const std::string& nomeFicheiro);
+    void fechar();
+    bool aberto() const { return ficheiro.is_open(); }
+    size_t size() const { return numEntradas; }
+
+    // Os ponteiros devolvidos são válidos até à próxima pesquisa (a cache pode libertar o registo)
+    const Colaborador* procurarPorId(int id);
+    const Colaborador* procurarPorNome(const std::string& nome); // Nome completo, sem distinguir maiúsculas
+
+    size_t capacidadeCache = 256;
+
+private:
+    bool lerEntrada(uint64_t inicioSecao, size_t posicao, EntradaIndice& entrada);
+    const Colaborador* materializar(const EntradaIndice& entrada);
+
+    std::ifstream ficheiro;
+    size_t numEntradas = 0;
+    uint64_t inicioPorId = 0;
+    uint64_t inicioPorNome = 0;
+    int versao = 1; // Versão do ficheiro de dados (io.h), lida da primeira linha
+
+    // Cache LRU (mais recente à frente)
+    std::list<Colaborador> cache;
+    std::unordered_map<int, std::list<Colaborador>::iterator> posicaoCache;
+};
+
+// ===============================================
+// PESQUISA POR PARTE DO NOME SEM DECIFRAR A LISTA
+// ===============================================
+// Na carga a pedido, procurar por parte do nome obrigava a carregar e decifrar a lista inteira.
+// NomesCifrados lê do ficheiro só o ID e o nome cifrado de cada colaborador (sem decifrar nem
+// descodificar calendários). Se a cifra de dados preservar a estrutura (cifra.h), a consulta é
+// cifrada uma vez e procurada nos nomes cifrados, e nenhum nome fica em claro na memória; senão,
+// cada nome é decifrado na primeira pesquisa e guardado em cache. Só o colaborador escolhido é
+// decifrado por inteiro (FicheiroIndexado::procurarPorId). Trocar a cifra obriga a carregar de novo.
+struct NomesCifrados {
+    bool carregar(const std::string& nomeFicheiro);
+    bool carregado() const { return lido; }
+    size_t size() const { return ids.size(); }
+    size_t decifrados() const { return claros.size(); } // Nomes em claro na cache
+
+    // IDs dos colaboradores cujo nome contém 'parte' (sem distinguir maiúsculas), pela ordem do ficheiro
+    std::vector<int> procurar(const std::string& parte, size_t limite = 1);
+
+private:
+    std::vector<int> ids;
+    std::vector<std::string> cifrados;
+    std::vector<std::string> claros; // Minúsculas, pela ordem do ficheiro; só com cifra que não preserva a estrutura
+    bool minusculas = false;         // Nomes cifrados guardados em minúsculas (cifra que preserva a estrutura)
+    bool lido = false;
+};
+
+#endif // INDICE_H
@@ -1,6 +1,8 @@
 #include "io.h" 
 #include "colaborador.h"
 #include "calendario.h"
+#include "indice.h"
+#include "cifra.h"
 #include <fstream>
 #include <sstream>
 #include <vector>
@@ -9,7 +11,12 @@
 #include <string>
 #include <map>
 #include <cstdlib> // Necessário para system()
+#include <charconv>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
 #include "cores.h"
+#include "metricas.h"
 
 // Constante para a chave da Cifra de César
 const int CHAVE_CESAR = 3; 
@@ -17,6 +24,7 @@ const int CHAVE_CESAR = 3;
 // --- Implementação das Funções de Cifra de César ---
 
 std::string encriptar(const std::string& texto, int chave) {
+    MEDIR_ESCOPO(Metrica::ENCRIPTAR);
     std::string resultado = texto;
     for (char& c : resultado) {
         if (std::isalpha(c)) { 
@@ -28,6 +36,7 @@ std::string encriptar(const std::string& texto, int chave) {
 }
 
 std::string desencriptar(const std::string& texto, int chave) {
+    MEDIR_ESCOPO(Metrica::DESENCRIPTAR);
     std::string resultado = texto;
     for (char& c : resultado) {
         if (std::isalpha(c)) { 
@@ -42,19 +51,13 @@ std::string desencriptar(const std::string& texto, int chave) {
 
 // Função para converter TipoMarcacao para string
 std::string tipoParaString(TipoMarcacao tipo) {
-    switch (tipo) {
-        case TipoMarcacao::FERIAS: return "F";
-        case TipoMarcacao::FALTA: return "X";
-        case TipoMarcacao::FIM_SEMANA: return "S"; // Incluir FIM_SEMANA para consistência, embora não seja usual guardar
-        default: return " ";
-    }
+    return std::string(1, propriedadesMarcacao(tipo).simbolo);
 }
 
-// Função para converter string para TipoMarcacao
+// Função para converter string para TipoMarcacao (LIVRE se não for o símbolo de um tipo marcável)
 TipoMarcacao stringParaTipo(const std::string& str) {
-    if (str == "F") return TipoMarcacao::FERIAS;
-    if (str == "X") return TipoMarcacao::FALTA;
-    return TipoMarcacao::LIVRE;
+    TipoMarcacao tipo = str.size() == 1 ? tipoDoSimbolo(str[0]) : TipoMarcacao::NAO_MARCADO;
+    return tipo == TipoMarcacao::NAO_MARCADO ? TipoMarcacao::LIVRE : tipo;
 }
 
 // --- Funções de Ficheiros (Guardar e Carregar) ---
@@ -67,100 +70,388 @@ std::string getNextToken(std::stringstream& ss, char delimitador) {
     return "";
 }
 
-void guardarDados(const std::vector<Colaborador>& colaboradores, const std::string& nomeFicheiro, const std::string& chave) {
-    std::ofstream ficheiro(nomeFicheiro);
-    if (!ficheiro.is_open()) {
-        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel abrir o ficheiro " << nomeFicheiro << " para escrita.\n" << RESET_COR;
-        return;
+// --- Codificação do Calendário (intervalos) ---
+
+static void acrescentarInt(std::string& destino, int valor) {
+    char digitos[16];
+    auto resultado = std::to_chars(digitos, digitos + sizeof(digitos), valor);
+    destino.append(digitos, resultado.ptr);
+}
+
+void codificarCalendario(const std::map<int, TipoMarcacao>& calendario, std::string& destino, const ParciaisDia* parciais) {
+    // Os dias parciais são poucos e percorridos a par do calendário (os dias são pedidos por ordem)
+    const bool comParciais = parciais != nullptr && !parciais->empty();
+    ParciaisDia::const_iterator parcial;
+    if (comParciais) parcial = parciais->begin();
+    auto unidadesDoDia = [&](int dia) -> int {
+        if (!comParciais) return 0;
+        while (parcial != parciais->end() && parcial->first < dia) ++parcial;
+        return parcial != parciais->end() && parcial->first == dia ? parcial->second : 0;
+    };
+
+    bool primeiro = true;
+    auto it = calendario.begin();
+    while (it != calendario.end()) {
+        TipoMarcacao tipo = it->second;
+        // Apenas guardamos os tipos marcáveis (dias 1 a 366)
+        if (!temTipo(MASCARA_MARCAVEL, tipo) || it->first < 1 || it->first > 366) {
+            ++it;
+            continue;
+        }
+
+        // Estender o intervalo enquanto os dias forem seguidos, inteiros e do mesmo tipo
+        int inicio = it->first;
+        int fim = inicio;
+        const int unidades = unidadesDoDia(inicio);
+        ++it;
+        while (unidades == 0 && it != calendario.end() && it->first == fim + 1 && it->second == tipo && it->first <= 366 &&
+               unidadesDoDia(it->first) == 0) {
+            ++fim;
+            ++it;
+        }
+
+        if (!primeiro) destino += ',';
+        primeiro = false;
+        acrescentarInt(destino, inicio);
+        if (fim > inicio) {
+            destino += '-';
+            acrescentarInt(destino, fim);
+        }
+        destino += ':';
+        destino += propriedadesMarcacao(tipo).simbolo;
+        if (unidades != 0) acrescentarInt(destino, unidades);
     }
+}
 
-    // A chave de encriptação é CHAVE_CESAR
-    int chave_atual = CHAVE_CESAR; 
-    
-    for (const auto& colab : colaboradores) {
-        // Encriptar Nome e Departamento
-        std::string nomeCifrado = encriptar(colab.nome, chave_atual);
-        std::string deptoCifrado = encriptar(colab.departamento, chave_atual);
-
-        // Serializar o Calendário
-        std::string calendarioStr;
-        // O calendário pode ir até 366 dias.
-        // Se o mapa não tiver o dia, assumimos LIVRE (' ')
-        for (int dia = 1; dia <= 366; ++dia) { 
-            auto it = colab.calendario.find(dia);
-            TipoMarcacao tipo = (it != colab.calendario.end()) ? it->second : TipoMarcacao::LIVRE;
-            
-            // Apenas guardamos FÉRIAS ou FALTA para economizar espaço e evitar guardar ' '
-            if (tipo == TipoMarcacao::FERIAS || tipo == TipoMarcacao::FALTA) {
-                 calendarioStr += std::to_string(dia) + ":" + tipoParaString(tipo) + ",";
+void descodificarCalendario(const char* inicio, const char* fim, std::map<int, TipoMarcacao>& calendario, ParciaisDia* parciais) {
+    const char* p = inicio;
+    while (p < fim) {
+        int primeiroDia = 0, ultimoDia = 0;
+        auto r = std::from_chars(p, fim, primeiroDia);
+        if (r.ec != std::errc()) throw std::invalid_argument("calendario invalido");
+        p = r.ptr;
+        ultimoDia = primeiroDia;
+        if (p < fim && *p == '-') {
+            r = std::from_chars(p + 1, fim, ultimoDia);
+            if (r.ec != std::errc()) throw std::invalid_argument("calendario invalido");
+            p = r.ptr;
+        }
+        if (p >= fim || *p != ':' || p + 1 >= fim || primeiroDia < 1 || ultimoDia < primeiroDia || ultimoDia > 366) {
+            throw std::invalid_argument("calendario invalido");
+        }
+        char letra = p[1];
+        p += 2;
+        TipoMarcacao tipo = tipoDoSimbolo(letra);
+        if (tipo == TipoMarcacao::NAO_MARCADO) tipo = TipoMarcacao::LIVRE; // Símbolo desconhecido
+
+        // Dia parcial: as unidades seguem o tipo
+        if (p < fim && *p >= '0' && *p <= '9') {
+            int unidades = 0;
+            r = std::from_chars(p, fim, unidades);
+            if (r.ec != std::errc() || unidades < 1 || unidades >= UNIDADES_POR_DIA || ultimoDia != primeiroDia) {
+                throw std::invalid_argument("calendario invalido");
             }
+            p = r.ptr;
+            if (parciais != nullptr && tipo != TipoMarcacao::LIVRE) {
+                parciais->emplace_hint(parciais->end(), primeiroDia, static_cast<uint8_t>(unidades));
+            }
+        }
+
+        // Os intervalos vêm por ordem crescente: inserir sempre no fim do mapa é O(1)
+        for (int dia = primeiroDia; dia <= ultimoDia; ++dia) {
+            calendario.emplace_hint(calendario.end(), dia, tipo)->second = tipo;
         }
 
-        // Remover a última vírgula se existir
-        if (!calendarioStr.empty() && calendarioStr.back() == ',') {
-            calendarioStr.pop_back();
+        if (p < fim) {
+            if (*p != ',') throw std::invalid_argument("calendario invalido");
+            ++p;
         }
+    }
+}
+
+const int VERSAO_FICHEIRO_DADOS = 2;
+static const std::string MARCA_VERSAO_DADOS = "#rh_data;";
+
+std::string linhaVersaoDados() {
+    return MARCA_VERSAO_DADOS + std::to_string(VERSAO_FICHEIRO_DADOS);
+}
+
+int lerVersaoDados(const std::string& linha) {
+    if (linha.compare(0, MARCA_VERSAO_DADOS.size(), MARCA_VERSAO_DADOS) != 0) return 0;
+    int versao = 0;
+    const char* inicio = linha.data() + MARCA_VERSAO_DADOS.size();
+    const char* fim = linha.data() + linha.size();
+    if (fim > inicio && fim[-1] == '\r') --fim; // Ficheiro gravado em Windows
+    auto r = std::from_chars(inicio, fim, versao);
+    return r.ec == std::errc() && r.ptr == fim && versao > 0 ? versao : 0;
+}
+
+// Serializa um colaborador numa linha (sem o '\n'): Nome;Depto;ID;DiasFerias;Calendario
+std::string serializarColaborador(const Colaborador& colab) {
+    // Encriptar Nome e Departamento (cifra de dados: César com CHAVE_CESAR)
+    const Cifra& cifra = cifraDados();
+    std::string nomeCifrado = cifra.cifrar(colab.nome);
+    std::string deptoCifrado = cifra.cifrar(colab.departamento);
+
+    std::string linha = nomeCifrado + ";" + deptoCifrado + ";" + std::to_string(colab.id) + ";" +
+                        formatarDias(colab.saldo_ferias) + ";";
+
+    // Serializar o Calendário em intervalos (ex: 329-340:F, 352:F4 para meio dia)
+    codificarCalendario(colab.calendario, linha, &colab.parciais);
+    return linha;
+}
+
+// Reconstrói um colaborador a partir de uma linha do ficheiro (lança exceção se for inválida)
+Colaborador desserializarColaborador(const std::string& linha, int versao) {
+    const Cifra& cifra = cifraDados();
+
+    std::stringstream ss(linha);
+    std::string nomeCifrado = getNextToken(ss, ';');
+    std::string deptoCifrado = getNextToken(ss, ';');
+    std::string idStr = getNextToken(ss, ';');
+    std::string diasFeriasStr = getNextToken(ss, ';');
+    std::string calendarioEncodedStr = getNextToken(ss, ';');
+
+    Colaborador colab;
+    
+    // Desencriptar Nome e Departamento
+    colab.nome = cifra.decifrar(nomeCifrado);
+    colab.departamento = cifra.decifrar(deptoCifrado);
+    colab.id = std::stoi(idStr);
+    // Saldo em dias, com casas decimais para as frações ("21.5")
+    if (diasFeriasStr.empty()) {
+        colab.saldo_ferias = 22 * UNIDADES_POR_DIA;
+    } else if (!lerDias(diasFeriasStr, colab.saldo_ferias)) {
+        throw std::invalid_argument("saldo de ferias invalido");
+    }
+
+    // Deserializar o Calendário (Formato: Inicio-Fim:Tipo, Dia:Tipo ou Dia:TipoUnidades, separados por ',')
+    descodificarCalendario(calendarioEncodedStr.data(), calendarioEncodedStr.data() + calendarioEncodedStr.size(), colab.calendario,
+                           &colab.parciais);
+
+    // Versão 1: as férias marcadas ainda não tinham saído do saldo
+    if (versao < 2) {
+        colab.saldo_ferias -= unidadesMarcadas(colab, MASCARA_DESCONTA_SALDO);
+    }
+    return colab;
+}
 
+const std::string MARCA_FIM_JOURNAL = "#fim;2";
+static const std::string MARCA_FIM_JOURNAL_ANTIGA = "#fim"; // Lotes da versão 1 do ficheiro de dados
+
+std::string nomeJournal(const std::string& nomeFicheiro) {
+    return nomeFicheiro + ".journal";
+}
+
+// Substitui o ficheiro de destino pelo temporário (rename atómico em POSIX)
+bool publicarFicheiro(const std::string& temporario, const std::string& destino) {
+#ifdef _WIN32
+    std::remove(destino.c_str()); // Em Windows o rename não substitui um ficheiro existente
+#endif
+    return std::rename(temporario.c_str(), destino.c_str()) == 0;
+}
+
+bool escreverFicheiroDados(const std::vector<Colaborador>& colaboradores, const std::string& nomeFicheiro) {
+    // Escreve primeiro num ficheiro temporário: se algo falhar, o ficheiro anterior fica intacto
+    const std::string temporario = nomeFicheiro + ".tmp";
+    std::ofstream ficheiro(temporario, std::ios::binary); // Binário: os offsets do índice contam bytes
+    if (!ficheiro.is_open()) return false;
+
+    // Versão, linhas de dados e o índice (ver indice.h) para a carga a pedido
+    std::string dados = linhaVersaoDados() + "\n";
+    ConstrutorIndice indice;
+    for (const auto& colab : colaboradores) {
         // Escrever a linha: Nome;Depto;ID;DiasFerias;Calendario
-        ficheiro << nomeCifrado << ";"
-                 << deptoCifrado << ";"
-                 << colab.id << ";"
-                 << colab.dias_ferias_restantes << ";"
-                 << calendarioStr << "\n";
+        std::string linha = serializarColaborador(colab);
+        indice.registar(colab, dados.size(), linha.size());
+        dados += linha;
+        dados += '\n';
     }
+    dados += indice.gerar(dados.size());
+    ficheiro.write(dados.data(), static_cast<std::streamsize>(dados.size()));
+    ficheiro.close();
 
-    std::cout << COR_VERDE << "[INFO] Dados de " << colaboradores.size() << " colaboradores guardados com sucesso em " << nomeFicheiro << ".\n" << RESET_COR;
+    return ficheiro && publicarFicheiro(temporario, nomeFicheiro);
 }
-// Função para carregar dados de colaboradores a partir de um ficheiro
-void carregarDados(std::vector<Colaborador>& lista, const std::string& nomeFicheiro) {
-    lista.clear();
-    std::ifstream ficheiro(nomeFicheiro);
-    if (!ficheiro.is_open()) {
-        std::cerr << COR_AMARELA << "[AVISO] Nao foi possivel abrir o ficheiro " << nomeFicheiro << " para leitura. O ficheiro pode nao existir ainda.\n" << RESET_COR;
+
+void guardarDados(const std::vector<Colaborador>& colaboradores, const std::string& nomeFicheiro, const std::string& chave) {
+    MEDIR_ESCOPO(Metrica::GUARDAR_DADOS);
+
+    if (!escreverFicheiroDados(colaboradores, nomeFicheiro)) {
+        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel gravar " << nomeFicheiro << ".\n" << RESET_COR;
         return;
     }
+    // O ficheiro completo já inclui tudo o que estava no journal do autosave
+    std::remove(nomeJournal(nomeFicheiro).c_str());
+
+    CONTAR_EVENTO(Contador::COLABORADORES_GUARDADOS, colaboradores.size());
+    std::cout << COR_VERDE << "[INFO] Dados de " << colaboradores.size() << " colaboradores guardados com sucesso em " << nomeFicheiro << ".\n" << RESET_COR;
+}
+
+// Aplica o journal do autosave (alterações feitas depois da última gravação completa).
+// Cada linha é um colaborador completo (substitui o do mesmo ID) ou "-ID" (remoção).
+// Só os lotes terminados por MARCA_FIM_JOURNAL são aplicados (o último pode estar cortado).
+size_t aplicarJournal(std::vector<Colaborador>& lista, const std::string& nomeFicheiro) {
+    std::ifstream journal(nomeJournal(nomeFicheiro));
+    if (!journal.is_open()) return 0;
 
-    int chave_atual = CHAVE_CESAR;
+    std::map<int, size_t> posicaoPorId;
+    auto reindexar = [&]() {
+        posicaoPorId.clear();
+        for (size_t i = 0; i < lista.size(); ++i) posicaoPorId[lista[i].id] = i;
+    };
+    reindexar();
+
+    size_t aplicadas = 0;
+    std::vector<std::string> lote;
     std::string linha;
-    while (std::getline(ficheiro, linha)) {
-        
-        std::stringstream ss(linha);
-        std::string nomeCifrado = getNextToken(ss, ';');
-        std::string deptoCifrado = getNextToken(ss, ';');
-        std::string idStr = getNextToken(ss, ';');
-        std::string diasFeriasStr = getNextToken(ss, ';');
-        std::string calendarioEncodedStr = getNextToken(ss, ';');
-        
-        try {
-            Colaborador colab;
-            
-            // Desencriptar Nome e Departamento
-            colab.nome = desencriptar(nomeCifrado, chave_atual);
-            colab.departamento = desencriptar(deptoCifrado, chave_atual);
-            colab.id = std::stoi(idStr);
-            colab.dias_ferias_restantes = diasFeriasStr.empty() ? 22 : std::stoi(diasFeriasStr);
-
-            // Deserializar o Calendário (Formato: Dia:Tipo,Dia:Tipo,...)
-            std::stringstream ssCalendario(calendarioEncodedStr);
-            std::string marcacaoEncoded;
-            
-            while (std::getline(ssCalendario, marcacaoEncoded, ',')) {
-                size_t pos_delimitador = marcacaoEncoded.find(':');
-                if (pos_delimitador != std::string::npos) {
-                    int diaDoAno = std::stoi(marcacaoEncoded.substr(0, pos_delimitador));
-                    std::string tipoStr = marcacaoEncoded.substr(pos_delimitador + 1);
-                    colab.calendario[diaDoAno] = stringParaTipo(tipoStr);
+    while (std::getline(journal, linha)) {
+        if (linha != MARCA_FIM_JOURNAL && linha != MARCA_FIM_JOURNAL_ANTIGA) {
+            if (!linha.empty()) lote.push_back(linha);
+            continue;
+        }
+        const int versao = linha == MARCA_FIM_JOURNAL ? VERSAO_FICHEIRO_DADOS : 1;
+        for (const auto& registo : lote) {
+            try {
+                if (registo[0] == '-') {
+                    auto it = posicaoPorId.find(std::stoi(registo.substr(1)));
+                    if (it != posicaoPorId.end()) {
+                        lista.erase(lista.begin() + static_cast<std::ptrdiff_t>(it->second));
+                        reindexar();
+                    }
+                } else {
+                    Colaborador colab = desserializarColaborador(registo, versao);
+                    auto it = posicaoPorId.find(colab.id);
+                    if (it != posicaoPorId.end()) {
+                        lista[it->second] = std::move(colab);
+                    } else {
+                        posicaoPorId[colab.id] = lista.size();
+                        lista.push_back(std::move(colab));
+                    }
                 }
+                ++aplicadas;
+            } catch (const std::exception& e) {
+                CONTAR_EVENTO(Contador::LINHAS_INVALIDAS, 1);
+                std::cerr << COR_VERMELHA << "[ERRO] Erro ao aplicar o journal: " << e.what() << " -> Linha ignorada.\n" << RESET_COR;
             }
+        }
+        lote.clear();
+    }
+    if (!lote.empty()) {
+        std::cerr << COR_AMARELA << "[AVISO] Ultimo lote do journal incompleto (" << lote.size() << " linhas ignoradas).\n" << RESET_COR;
+    }
+    return aplicadas;
+}
+
+bool lerFicheiroDados(std::vector<Colaborador>& lista, const std::string& nomeFicheiro) {
+    std::ifstream ficheiro(nomeFicheiro);
+    if (!ficheiro.is_open()) return false;
 
-            lista.push_back(colab);
+    // Sem a linha da versão, o ficheiro é da versão 1 e a primeira linha já é um colaborador
+    std::string linha;
+    int versao = 1;
+    bool primeira = true;
+    while (std::getline(ficheiro, linha)) {
+        if (primeira) {
+            primeira = false;
+            if (int v = lerVersaoDados(linha)) {
+                versao = v;
+                continue;
+            }
+        }
+        if (linha == MARCA_INDICE) break; // O resto do ficheiro é o índice da carga a pedido
+        try {
+            lista.push_back(desserializarColaborador(linha, versao));
         } catch (const std::exception& e) {
+             CONTAR_EVENTO(Contador::LINHAS_INVALIDAS, 1);
              std::cerr << COR_VERMELHA << "[ERRO] Erro ao carregar linha: " << e.what() << " -> Linha ignorada.\n" << RESET_COR;
         }
     }
+    return true;
+}
+
+// Função para carregar dados de colaboradores a partir de um ficheiro
+void carregarDados(std::vector<Colaborador>& lista, const std::string& nomeFicheiro) {
+    MEDIR_ESCOPO(Metrica::CARREGAR_DADOS);
+    lista.clear();
+    if (!lerFicheiroDados(lista, nomeFicheiro)) {
+        std::cerr << COR_AMARELA << "[AVISO] Nao foi possivel abrir o ficheiro " << nomeFicheiro << " para leitura. O ficheiro pode nao existir ainda.\n" << RESET_COR;
+    }
+
+    size_t recuperadas = aplicarJournal(lista, nomeFicheiro);
+    if (recuperadas > 0) {
+        std::cout << COR_AMARELA << "[INFO] " << recuperadas << " alteracoes recuperadas do autosave (" << nomeJournal(nomeFicheiro) << ").\n" << RESET_COR;
+    }
+
+    CONTAR_EVENTO(Contador::COLABORADORES_CARREGADOS, lista.size());
     std::cout << COR_VERDE << "[INFO] " << lista.size() << " colaboradores carregados com sucesso.\n" << RESET_COR;
 }
 
+// --- Implementação da Escrita com Buffer ---
+
+BufferEscrita::BufferEscrita(const std::string& nomeFicheiro, size_t capacidade)
+    : ficheiro(nomeFicheiro, std::ios::binary), buffer(capacidade < 64 ? 64 : capacidade) {}
+
+BufferEscrita::~BufferEscrita() {
+    despejar();
+}
+
+void BufferEscrita::despejar() {
+    if (usado > 0 && ficheiro.is_open()) {
+        ficheiro.write(buffer.data(), static_cast<std::streamsize>(usado));
+    }
+    usado = 0;
+}
+
+void BufferEscrita::escrever(const char* texto, size_t tamanho) {
+    if (usado + tamanho > buffer.size()) {
+        despejar();
+        // Texto maior que o buffer inteiro: escreve diretamente
+        if (tamanho > buffer.size()) {
+            ficheiro.write(texto, static_cast<std::streamsize>(tamanho));
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + usado, texto, tamanho);
+    usado += tamanho;
+}
+
+void BufferEscrita::escrever(const std::string& texto) {
+    escrever(texto.data(), texto.size());
+}
+
+void BufferEscrita::escreverChar(char c) {
+    if (usado == buffer.size()) despejar();
+    buffer[usado++] = c;
+}
+
+void BufferEscrita::escreverInt(long long valor) {
+    if (usado + 24 > buffer.size()) despejar();
+    auto res = std::to_chars(buffer.data() + usado, buffer.data() + buffer.size(), valor);
+    usado = static_cast<size_t>(res.ptr - buffer.data());
+}
+
+void BufferEscrita::escreverDias(long long unidades) {
+    if (unidades % UNIDADES_POR_DIA == 0) {
+        escreverInt(unidades / UNIDADES_POR_DIA);
+    } else {
+        escrever(formatarDias(unidades));
+    }
+}
+
+void BufferEscrita::escreverData(int dia, int mes, int ano) {
+    if (usado + 16 > buffer.size()) despejar();
+    char* p = buffer.data() + usado;
+    *p++ = char('0' + (dia / 10) % 10);
+    *p++ = char('0' + dia % 10);
+    *p++ = '/';
+    *p++ = char('0' + (mes / 10) % 10);
+    *p++ = char('0' + mes % 10);
+    *p++ = '/';
+    p = std::to_chars(p, buffer.data() + buffer.size(), ano).ptr;
+    usado = static_cast<size_t>(p - buffer.data());
+}
+
 // Função para limpar a consola
 void limparConsola() {
     #ifdef _WIN32
@@ -3,6 +3,8 @@
 
 #include <string>
 #include <vector>
+#include <fstream>
+#include <map>
 #include "colaborador.h" // Necessário para a estrutura Colaborador
 #include "calendario.h" // Necessário para TipoMarcacao
 
@@ -17,12 +19,71 @@ std::string desencriptar(const std::string& texto, int chave);
 std::string tipoParaString(TipoMarcacao tipo);
 TipoMarcacao stringParaTipo(const std::string& str);
 
+// --- Codificação do Calendário ---
+// Dias seguidos com o mesmo tipo são um intervalo: "329-340:F,350:X" (só os tipos marcáveis).
+// Um dia isolado fica "dia:tipo", por isso os ficheiros antigos continuam a ser lidos. Um dia
+// parcial nunca entra num intervalo e leva as unidades depois do tipo: "352:F4" é meio dia de férias.
+// Sem 'parciais' ao descodificar, os dias parciais são lidos como dias inteiros.
+void codificarCalendario(const std::map<int, TipoMarcacao>& calendario, std::string& destino,
+                         const ParciaisDia* parciais = nullptr);
+void descodificarCalendario(const char* inicio, const char* fim, std::map<int, TipoMarcacao>& calendario,
+                            ParciaisDia* parciais = nullptr); // Lança exceção se for inválido
+
 // --- Funções de Ficheiros (Guardar e Carregar) ---
+// O ficheiro de dados começa pela linha "#rh_data;<versao>". Até à versão 1 (ficheiros sem essa
+// linha e lotes do journal terminados pela marca antiga "#fim") o saldo de férias não descontava
+// os dias marcados; ao ler um registo dessa versão, as férias do calendário são descontadas.
+extern const int VERSAO_FICHEIRO_DADOS;
+std::string linhaVersaoDados();
+int lerVersaoDados(const std::string& linha); // 0 se a linha não for a da versão
+
+// Linha de um colaborador no ficheiro (Nome;Depto;ID;DiasFerias;Calendario, sem '\n')
+std::string serializarColaborador(const Colaborador& colab);
+// Lança exceção se a linha for inválida. 'versao' é a do ficheiro de onde a linha vem.
+Colaborador desserializarColaborador(const std::string& linha, int versao = VERSAO_FICHEIRO_DADOS);
+
+// Journal do autosave (alterações desde a última gravação completa).
+// Cada lote termina com MARCA_FIM_JOURNAL; lotes incompletos são ignorados ao carregar.
+extern const std::string MARCA_FIM_JOURNAL;
+std::string nomeJournal(const std::string& nomeFicheiro);
+
+// Substitui o destino pelo ficheiro temporário (rename atómico). Retorna false se falhar.
+bool publicarFicheiro(const std::string& temporario, const std::string& destino);
+
 void guardarDados(const std::vector<Colaborador>& colaboradores, const std::string& nomeFicheiro, const std::string& chave = "");
 void carregarDados(std::vector<Colaborador>& colaboradores, const std::string& nomeFicheiro);
 
-// Função para exportar dados 
-void exportarDados(const std::vector<Colaborador>& colaboradores);
+// Versões sem mensagens na consola (usadas pelos fragmentos de departamento e pelo autosave).
+// escreverFicheiroDados grava com índice (temporário + rename); lerFicheiroDados acrescenta à lista
+// e não aplica o journal. Retornam false se o ficheiro não puder ser aberto/gravado.
+bool escreverFicheiroDados(const std::vector<Colaborador>& colaboradores, const std::string& nomeFicheiro);
+bool lerFicheiroDados(std::vector<Colaborador>& lista, const std::string& nomeFicheiro);
+
+// Reaplica o journal do autosave sobre a lista. Retorna o número de alterações aplicadas.
+size_t aplicarJournal(std::vector<Colaborador>& lista, const std::string& nomeFicheiro);
+
+// --- Escrita com Buffer (exportações grandes) ---
+
+// Acumula o texto num buffer grande em memória e só escreve no ficheiro quando enche,
+// formatando os números com std::to_chars (sem std::setw/std::setfill por campo).
+struct BufferEscrita {
+    explicit BufferEscrita(const std::string& nomeFicheiro, size_t capacidade = 1 << 20);
+    ~BufferEscrita(); // Despeja o que faltar
+
+    bool aberto() const { return ficheiro.is_open(); }
+
+    void escrever(const std::string& texto);
+    void escrever(const char* texto, size_t tamanho);
+    void escreverChar(char c);
+    void escreverInt(long long valor);
+    void escreverData(int dia, int mes, int ano); // dd/mm/aaaa
+    void escreverDias(long long unidades);        // Como formatarDias ("21.5"); dias inteiros sem std::string
+    void despejar();
+
+    std::ofstream ficheiro;
+    std::vector<char> buffer;
+    size_t usado = 0;
+};
 
 // Função para limpar a consola
 void limparConsola();
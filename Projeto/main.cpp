@@ -3,24 +3,47 @@
 #include "io.h"
 #include "reports.h"
 #include "cores.h"
+#include "metricas.h"
+#include "memoria.h"
+#include "servidor.h"
+#include "autosave.h"
+#include "indice.h"
+#include "fragmentos.h"
+#include "arquivo.h"
+#include "mapacalor.h"
+#include "cobertura.h"
+#include "planeador.h"
+#include "formacoes.h"
+#include "notas.h"
+#include "validades.h"
+#include "duplicados.h"
+#include "padroes.h"
+#include "ranking.h"
+#include "viragem.h"
 
 #include <ctime>
+#include <fstream>
 #include <limits>
 #include <cstdlib>
 #include <iostream>
 #include <cstddef>
 #include <sstream>
 #include <algorithm>
+#include <cctype>
 #include <vector>
 #include <string>
 
 
+// Última opção do menu principal (as mensagens de input inválido indicam o intervalo 0 a esta)
+static const int ULTIMA_OPCAO_MENU = 22;
+
 // Apresenta o menu principal 
 void mostrarMenu();
 
 // Função de ligação entre o menu e a marcação
-void menuGerirMarcacoes(std::vector<Colaborador>& lista);
+void menuGerirMarcacoes(std::vector<Colaborador>& lista, MotorCobertura& cobertura, const IndiceAusencias& ausencias);
 void menuVisualizarCalendario(const std::vector<Colaborador>& lista);
+void pedirMesEVisualizarCalendario(const Colaborador& colab);
 
 // Apresenta o menu principal 
 void mostrarMenu() {
@@ -38,14 +61,25 @@ void mostrarMenu() {
     std::cout << " 9. Relatorio Mensal (Ausencias por Colaborador)\n";
     std::cout << " 10. Estatisticas de Departamento\n"; 
     std::cout << "11. Exportar Dados (Calendario/Relatorio)\n"; 
+    std::cout << "12. Uso de Memoria (Diagnostico)\n";
+    std::cout << "13. Ausencias por Intervalo (Departamentos)\n";
+    std::cout << "14. Mapa de Ausencias (Departamento x Dia)\n";
+    std::cout << "15. Cobertura Minima (Regras e Capacidade)\n";
+    std::cout << "16. Planear Ferias em Lote (Pedidos)\n";
+    std::cout << "17. Pesquisar Formacoes (Empresa)\n";
+    std::cout << "18. Pesquisar Notas Internas (Texto)\n";
+    std::cout << "19. Renovacao de Formacoes (Validades)\n";
+    std::cout << "20. Detetar Nomes Duplicados\n";
+    std::cout << "21. Padroes de Ausencia (Fator de Bradford)\n";
+    std::cout << "22. Rankings de Ausencias (Top-K)\n";
     std::cout << "--------------------------------------------\n";
     std::cout << COR_ROXO << "0. Guardar e Sair\n" << RESET_COR;
     std::cout << "--------------------------------------------\n";
-    std::cout << "Escolha uma opcao (1 - 11 em que 0 - Sair): ";
+    std::cout << "Escolha uma opcao (1 - " << ULTIMA_OPCAO_MENU << " em que 0 - Sair): ";
 }
 
 // Função de ligação entre o menu e a marcação 
-void menuGerirMarcacoes(std::vector<Colaborador>& lista) {
+void menuGerirMarcacoes(std::vector<Colaborador>& lista, MotorCobertura& cobertura, const IndiceAusencias& ausencias) {
     if (lista.empty()) {
         std::cout << COR_AMARELA << "AVISO: Nao ha colaboradores para gerir marcacoes.\n" << RESET_COR;
         return;
@@ -74,6 +108,8 @@ void menuGerirMarcacoes(std::vector<Colaborador>& lista) {
     std::cout << " 1. Marcar Ferias (F)\n";
     std::cout << " 2. Marcar Falta (X)\n";
     std::cout << " 3. Desmarcar (Remover)\n";
+    std::cout << " 4. Outra Marcacao (Baixa, Formacao, Teletrabalho, Licenca Parental)\n";
+    std::cout << " 5. Marcar Parte do Dia (Meio Dia ou Horas)\n";
     std::cout << COR_AMARELA << " Opcao: " << RESET_COR;
 
     // Lê a opção primeiro
@@ -84,7 +120,7 @@ void menuGerirMarcacoes(std::vector<Colaborador>& lista) {
         return;
     }
 
-    if (op < 1 || op > 3) {
+    if (op < 1 || op > 5) {
         std::cout << COR_VERMELHA << "Opcao invalida.\n" << RESET_COR;
         std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
         return;
@@ -98,22 +134,67 @@ void menuGerirMarcacoes(std::vector<Colaborador>& lista) {
         return;
     }
 
+    // Estado do dia antes da alteração, para atualizar os contadores de cobertura
+    int diaDoAno = dataValida(dia, mes, ano) ? dataParaDiaDoAno(dia, mes, ano) : 0;
+    auto marcado = colab.calendario.find(diaDoAno);
+    TipoMarcacao antes = marcado == colab.calendario.end() ? TipoMarcacao::LIVRE : marcado->second;
+    int unidadesAntes = unidadesDoDia(colab, diaDoAno);
+
     if (op == 3) {
         desmarcarDia(colab, dia, mes, ano);
-    } else if (op == 1 || op == 2) {
-        TipoMarcacao tipoMarcacao = (op == 1) 
-            ? TipoMarcacao::FERIAS 
-            : TipoMarcacao::FALTA;
-
-        // Verificar Conflito de Férias 
-        if (tipoMarcacao == TipoMarcacao::FERIAS) {
-            bool conflito = verificarConflitoFerias(colab, dia, mes, ano, lista);
+    } else {
+        TipoMarcacao tipoMarcacao = (op == 1) ? TipoMarcacao::FERIAS : TipoMarcacao::FALTA;
+        int unidades = UNIDADES_POR_DIA;
+        if (op == 4 || op == 5) {
+            char simbolo = ' ';
+            std::cout << "Tipo (" << legendaMarcacoes() << "): ";
+            std::cin >> simbolo;
+            tipoMarcacao = tipoDoSimbolo(static_cast<char>(std::toupper(static_cast<unsigned char>(simbolo))));
+            if (tipoMarcacao == TipoMarcacao::NAO_MARCADO) {
+                std::cout << COR_VERMELHA << "ERRO: Tipo de marcacao invalido.\n" << RESET_COR;
+                std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+                return;
+            }
+        }
+        if (op == 5) {
+            std::cout << "Horas (1 a " << UNIDADES_POR_DIA - 1 << ", meio dia = " << MEIO_DIA << "): ";
+            if (!(std::cin >> unidades) || unidades < 1 || unidades >= UNIDADES_POR_DIA) {
+                std::cout << COR_VERMELHA << "ERRO: Numero de horas invalido.\n" << RESET_COR;
+                std::cin.clear();
+                std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+                return;
+            }
+        }
+
+        // Formação e teletrabalho não tiram ninguém do serviço: não contam para a cobertura mínima
+        if (temTipo(MASCARA_AUSENCIA, tipoMarcacao) && diaDoAno != 0 && cobertura.minimoDe(colab.departamento) > 0) {
+            // Cobertura mínima do departamento: férias abaixo do mínimo são recusadas, faltas só avisam
+            std::vector<ViolacaoCobertura> violacoes = cobertura.verificarAusencia(colab, diaDoAno, diaDoAno, ano);
+            for (const auto& violacao : violacoes) {
+                std::cout << COR_AMARELA << "AVISO: Cobertura minima em causa - " << descreverViolacao(violacao, ano) << "\n" << RESET_COR;
+            }
+            if (!violacoes.empty() && tipoMarcacao == TipoMarcacao::FERIAS) {
+                std::cout << COR_VERMELHA << "ERRO: Ferias recusadas para manter a cobertura minima do departamento.\n" << RESET_COR;
+                std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+                return;
+            }
+        } else if (tipoMarcacao == TipoMarcacao::FERIAS) {
+            // Verificar Conflito de Férias 
+            bool conflito = verificarConflitoFerias(colab, dia, mes, ano, lista, &ausencias);
             if (conflito) {
                 std::cout << COR_AMARELA << "A marcacao vai prosseguir, apesar do conflito no departamento.\n" << RESET_COR;
             }
         }
 
-        marcarDia(colab, dia, mes, ano, tipoMarcacao);
+        marcarDia(colab, dia, mes, ano, tipoMarcacao, unidades);
+    }
+
+    if (diaDoAno != 0) {
+        marcado = colab.calendario.find(diaDoAno);
+        TipoMarcacao depois = marcado == colab.calendario.end() ? TipoMarcacao::LIVRE : marcado->second;
+        cobertura.alterarDia(colab.departamento, diaDoAno, antes, depois);
+        registarAlteracaoDia(colab, antes, depois);
+        registarAusenciaDia(colab, diaDoAno, antes, depois, unidadesAntes);
     }
 
     // Limpar o buffer de input após a leitura de números
@@ -140,6 +221,11 @@ void menuVisualizarCalendario(const std::vector<Colaborador>& lista) {
         return;
     }
 
+    pedirMesEVisualizarCalendario(lista[static_cast<size_t>(indice)]);
+}
+
+// Pede o mês/ano e mostra o calendário do colaborador
+void pedirMesEVisualizarCalendario(const Colaborador& colab) {
     int mes, ano;
     std::cout << "Mes (mm): ";
     // Lê o mes e ano na mesma linha
@@ -160,16 +246,382 @@ void menuVisualizarCalendario(const std::vector<Colaborador>& lista) {
         return;
     }
 
-    visualizarCalendario(lista[static_cast<size_t>(indice)], mes, ano);
+    visualizarCalendario(colab, mes, ano);
     std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n'); // Limpar buffer após a leitura dos números
 }
 
-int main() {
-    std::vector<Colaborador> listaColaboradores;
+// Opções de linha de comandos (diagnóstico de desempenho)
+struct OpcoesPrograma {
+    bool mostrarMetricasNoFim = false; // --metricas
+    std::string ficheiroTrace;         // --trace ficheiro.json
+    bool modoServidor = false;         // --servidor [socket]
+    std::string caminhoSocket = SOCKET_POR_OMISSAO;
+    int intervaloAutosave = 10;        // --autosave segundos (0 desliga)
+    bool cargaCompleta = false;        // --carga-completa (desliga a carga a pedido)
+    bool fragmentar = false;           // --fragmentar (divide o rh_data.txt por departamento)
+    std::string departamentos;         // --departamentos A,B (âmbito com fragmentos)
+    int anoArquivar = 0;               // --arquivar ano (congela um ano fechado e sai)
+    int anoVirar = 0;                  // --virar-ano ano (fecha o ano, abre o seguinte e sai)
+    PoliticaViragem politica;          // --dias-anuais N, --transitar N (para --virar-ano)
+    bool forcarViragem = false;        // --forcar (vira o ano mesmo com marcações que podem ser do ano novo)
+};
+
+// Lê as opções da linha de comandos. Retorna false se houver uma opção inválida.
+bool lerOpcoes(int argc, char* argv[], OpcoesPrograma& opcoes) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--metricas") {
+            opcoes.mostrarMetricasNoFim = true;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            opcoes.ficheiroTrace = argv[++i];
+        } else if (arg == "--servidor") {
+            opcoes.modoServidor = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                opcoes.caminhoSocket = argv[++i];
+            }
+        } else if (arg == "--carga-completa") {
+            opcoes.cargaCompleta = true;
+        } else if (arg == "--fragmentar") {
+            opcoes.fragmentar = true;
+        } else if (arg == "--departamentos" && i + 1 < argc) {
+            opcoes.departamentos = argv[++i];
+        } else if (arg == "--arquivar" && i + 1 < argc) {
+            try {
+                opcoes.anoArquivar = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << COR_VERMELHA << "ERRO: Ano a arquivar invalido.\n" << RESET_COR;
+                return false;
+            }
+        } else if ((arg == "--virar-ano" || arg == "--dias-anuais" || arg == "--transitar") && i + 1 < argc) {
+            int valor = 0;
+            try {
+                valor = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << COR_VERMELHA << "ERRO: Valor invalido para " << arg << ".\n" << RESET_COR;
+                return false;
+            }
+            if (arg == "--virar-ano") opcoes.anoVirar = valor;
+            else if (arg == "--dias-anuais") opcoes.politica.diasAnuais = valor;
+            else opcoes.politica.maxTransitados = valor;
+        } else if (arg == "--forcar") {
+            opcoes.forcarViragem = true;
+        } else if (arg == "--autosave" && i + 1 < argc) {
+            try {
+                opcoes.intervaloAutosave = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << COR_VERMELHA << "ERRO: Intervalo de autosave invalido.\n" << RESET_COR;
+                return false;
+            }
+        } else {
+            std::cerr << COR_VERMELHA << "ERRO: Opcao desconhecida '" << arg << "'.\n" << RESET_COR;
+            std::cerr << "Uso: main.exe [--metricas] [--trace ficheiro.json] [--servidor [socket]] [--autosave segundos] [--carga-completa]\n"
+                      << "               [--fragmentar] [--departamentos A,B] [--arquivar ano]\n"
+                      << "               [--virar-ano ano [--dias-anuais N] [--transitar N] [--forcar]]\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Mostra/escreve as métricas pedidas na linha de comandos (ao sair)
+void terminarMetricas(const OpcoesPrograma& opcoes) {
+    if (opcoes.mostrarMetricasNoFim) {
+        mostrarMetricas();
+    }
+    if (!opcoes.ficheiroTrace.empty() && exportarTrace(opcoes.ficheiroTrace)) {
+        std::cout << COR_VERDE << "[INFO] Trace escrito em " << opcoes.ficheiroTrace << " (abrir em chrome://tracing).\n" << RESET_COR;
+    }
+}
+
+// Dados da sessão interativa. Com o índice do ficheiro (indice.h), o menu aparece sem carregar
+// ninguém: as consultas por ID/nome completo leem só o colaborador pedido e a lista completa
+// é carregada na primeira opção que precise dela.
+struct SessaoDados {
+    std::vector<Colaborador> lista;
+    FicheiroIndexado indice;
+    NomesCifrados nomesCifrados; // Pesquisa por parte do nome na carga a pedido (lida na primeira pesquisa)
+    bool listaCarregada = false;
+    std::string ficheiro;
+    int intervaloAutosave = 0;
+
+    // Com fragmentos por departamento (fragmentos.h) a lista tem só os departamentos do âmbito
+    ArmazemFragmentado armazem;
+    bool fragmentado = false;
+
+    // Regras de cobertura mínima (cobertura.h); os contadores são construídos na primeira
+    // opção que precise deles e refeitos depois de adicionar/remover colaboradores
+    MotorCobertura cobertura;
+    bool coberturaConstruida = false;
+
+    // Índice das formações da empresa (formacoes.h), refeito depois de alterar colaboradores/formações
+    IndiceFormacoes formacoes;
+    bool formacoesConstruidas = false;
+
+    // Índice de texto das notas internas (notas.h) da lista carregada; depois de construído é
+    // mantido pelo CRUD de notas e colaboradores, por isso não é invalidado
+    IndiceNotas notas;
+    bool notasConstruidas = false;
+
+    // Validades das formações (validades.h), também mantidas pelo CRUD depois de construídas
+    MotorValidades validades;
+    bool validadesConstruidas = false;
+
+    // Blocos de nomes (duplicados.h) para avisar de nomes semelhantes ao adicionar, mantidos pelo CRUD
+    IndiceNomes nomes;
+    bool nomesConstruidos = false;
+
+    // Rankings de ausências (ranking.h), mantidos pelas marcações e pelo CRUD depois de construídos
+    RankingAusencias ranking;
+    bool rankingConstruido = false;
+
+    // Contagens de ausências por departamento e dia (ausencias.h) do calendário em memória da
+    // empresa, mantidas pelas marcações e pelo CRUD depois de construídas
+    IndiceAusencias ausencias;
+    bool ausenciasConstruidas = false;
+};
+
+// Contadores de cobertura da lista da sessão, construídos só quando são precisos
+MotorCobertura& garantirCobertura(SessaoDados& sessao) {
+    if (!sessao.coberturaConstruida) {
+        sessao.cobertura.construir(sessao.lista);
+        sessao.coberturaConstruida = true;
+    }
+    return sessao.cobertura;
+}
+
+// Empresa inteira para as estatísticas/exportações: a lista ou, com fragmentos, um departamento de cada vez
+PercorrerEmpresa percorrerEmpresa(SessaoDados& sessao) {
+    if (!sessao.fragmentado) return nullptr;
+    return [&sessao](const VisitarParte& visitar) { percorrerFragmentos(sessao.armazem, sessao.lista, visitar); };
+}
+
+// Índice das formações de toda a empresa, construído só quando é preciso
+const IndiceFormacoes& garantirIndiceFormacoes(SessaoDados& sessao) {
+    if (!sessao.formacoesConstruidas) {
+        if (sessao.fragmentado) {
+            sessao.formacoes = construirIndiceFormacoes(percorrerEmpresa(sessao));
+        } else {
+            sessao.formacoes.construir(sessao.lista);
+        }
+        sessao.formacoesConstruidas = true;
+    }
+    return sessao.formacoes;
+}
+
+// Índice das notas da lista da sessão, construído só quando é preciso
+const IndiceNotas& garantirIndiceNotas(SessaoDados& sessao) {
+    if (!sessao.notasConstruidas) {
+        sessao.notas.construir(sessao.lista);
+        ativarIndiceNotas(&sessao.notas);
+        sessao.notasConstruidas = true;
+    }
+    return sessao.notas;
+}
+
+// Expirações das formações da lista da sessão, calculadas só quando são precisas
+MotorValidades& garantirValidades(SessaoDados& sessao) {
+    if (!sessao.validadesConstruidas) {
+        sessao.validades.construir(sessao.lista);
+        ativarMotorValidades(&sessao.validades);
+        sessao.validadesConstruidas = true;
+    }
+    return sessao.validades;
+}
+
+// Índice de nomes da lista da sessão, construído no primeiro colaborador adicionado
+void garantirIndiceNomes(SessaoDados& sessao) {
+    if (sessao.nomesConstruidos) return;
+    sessao.nomes.construir(sessao.lista);
+    ativarIndiceNomes(&sessao.nomes);
+    sessao.nomesConstruidos = true;
+}
+
+// Rankings de ausências da lista da sessão, construídos só quando são precisos
+const RankingAusencias& garantirRanking(SessaoDados& sessao) {
+    if (!sessao.rankingConstruido) {
+        sessao.ranking.construir(sessao.lista);
+        ativarRanking(&sessao.ranking);
+        sessao.rankingConstruido = true;
+    }
+    return sessao.ranking;
+}
+
+// Índice de ausências da empresa (com fragmentos, um departamento de cada vez), construído só quando é preciso
+const IndiceAusencias& garantirAusencias(SessaoDados& sessao) {
+    if (!sessao.ausenciasConstruidas) {
+        if (sessao.fragmentado) {
+            sessao.ausencias.porDepartamento.clear();
+            percorrerEmpresa(sessao)([&](const std::vector<Colaborador>& parte) { sessao.ausencias.acrescentar(parte); });
+        } else {
+            sessao.ausencias.construir(sessao.lista);
+        }
+        ativarIndiceAusencias(&sessao.ausencias);
+        sessao.ausenciasConstruidas = true;
+    }
+    return sessao.ausencias;
+}
+
+// Arranca a sessão com fragmentos (se existir o manifesto). Retorna false se não houver fragmentos.
+bool iniciarFragmentos(SessaoDados& sessao, const OpcoesPrograma& opcoes) {
+    if (opcoes.fragmentar) {
+        if (std::ifstream(MANIFESTO_POR_OMISSAO).is_open()) {
+            std::cout << COR_AMARELA << "[AVISO] Os dados ja estao divididos (" << MANIFESTO_POR_OMISSAO << ").\n" << RESET_COR;
+        } else {
+            std::vector<Colaborador> todos;
+            carregarDados(todos, sessao.ficheiro);
+            criarFragmentos(todos, MANIFESTO_POR_OMISSAO);
+        }
+    }
+    if (!sessao.armazem.lerManifesto(MANIFESTO_POR_OMISSAO)) {
+        if (!opcoes.departamentos.empty()) {
+            std::cout << COR_AMARELA << "[AVISO] --departamentos so se aplica a dados divididos (use --fragmentar).\n" << RESET_COR;
+        }
+        return false;
+    }
+
+    std::stringstream ss(opcoes.departamentos);
+    std::string depto;
+    while (std::getline(ss, depto, ',')) {
+        if (!depto.empty()) sessao.armazem.ambito.insert(depto);
+    }
+    carregarFragmentos(sessao.armazem, sessao.lista);
+    definirProximoIdMinimo(sessao.armazem.proximoId);
+    sessao.fragmentado = true;
+    sessao.listaCarregada = true;
+
+    // O journal fica junto ao manifesto e só é integrado nos fragmentos ao guardar
+    iniciarAutosave(sessao.lista, MANIFESTO_POR_OMISSAO, sessao.intervaloAutosave, false);
+    return true;
+}
+
+// Carrega a lista completa (se ainda não estiver) e arranca o autosave
+void garantirListaCarregada(SessaoDados& sessao) {
+    if (sessao.listaCarregada) return;
+    sessao.indice.fechar();
+    carregarDados(sessao.lista, sessao.ficheiro);
+    sessao.listaCarregada = true;
+
+    // Gravação incremental em segundo plano (as opções do menu que usam a lista bloqueiam mutexDados,
+    // porque o autosave limpa as flags 'modificado' dos colaboradores)
+    iniciarAutosave(sessao.lista, sessao.ficheiro, sessao.intervaloAutosave);
+}
+
+// Pede um colaborador (nome ou ID) sem carregar a lista, usando o índice do ficheiro.
+// A pesquisa por parte do nome corre sobre os nomes cifrados (NomesCifrados, sem decifrar a lista);
+// só um ID que não esteja no índice obriga a carregar a lista e usar encontrarColaborador.
+// O ponteiro devolvido é válido até à próxima pesquisa.
+const Colaborador* pedirColaboradorIndexado(SessaoDados& sessao, const std::string& titulo) {
+    std::string chave;
+    std::cout << COR_AZUL << "\n--- " << titulo << " ---\n" << RESET_COR;
+    std::cout << "Digite o nome ou ID do colaborador (" << sessao.indice.size() << " no ficheiro): ";
+    std::getline(std::cin >> std::ws, chave);
+
+    bool isID = std::all_of(chave.begin(), chave.end(), ::isdigit);
+    const Colaborador* colab = nullptr;
+    if (isID) {
+        try {
+            colab = sessao.indice.procurarPorId(std::stoi(chave));
+        } catch (const std::exception& e) {
+            colab = nullptr;
+        }
+    } else {
+        colab = sessao.indice.procurarPorNome(chave);
+        if (colab == nullptr) {
+            // Parte do nome: procura nos nomes cifrados e decifra só o colaborador encontrado
+            if (!sessao.nomesCifrados.carregado()) sessao.nomesCifrados.carregar(sessao.ficheiro);
+            std::vector<int> ids = sessao.nomesCifrados.procurar(chave);
+            if (!ids.empty()) colab = sessao.indice.procurarPorId(ids.front());
+            if (colab == nullptr && sessao.nomesCifrados.carregado()) {
+                std::cout << COR_VERMELHA << "ERRO: Colaborador nao encontrado: '" << chave << "'.\n" << RESET_COR;
+                return nullptr;
+            }
+        }
+    }
+    if (colab != nullptr) return colab;
+
+    garantirListaCarregada(sessao);
+    int indice = encontrarColaborador(sessao.lista, chave, isID);
+    if (indice == -1) {
+        std::cout << COR_VERMELHA << "ERRO: Colaborador nao encontrado: '" << chave << "'.\n" << RESET_COR;
+        return nullptr;
+    }
+    return &sessao.lista[static_cast<size_t>(indice)];
+}
+
+// --arquivar: congela os calendários atuais da empresa inteira como o ano fechado 'ano' (arquivo.h)
+bool arquivarAnoFechado(SessaoDados& sessao, int ano) {
+    if (ano >= obterAnoAtual()) {
+        std::cerr << COR_VERMELHA << "ERRO: So e possivel arquivar anos fechados (anteriores a " << obterAnoAtual() << ").\n" << RESET_COR;
+        return false;
+    }
+    if (anoArquivado(ano)) return arquivarAno({}, ano); // Mostra o erro sem carregar a lista
+    if (!sessao.fragmentado) {
+        garantirListaCarregada(sessao);
+        return arquivarAno(sessao.lista, ano);
+    }
+    std::vector<Colaborador> empresa;
+    percorrerFragmentos(sessao.armazem, sessao.lista, [&](const std::vector<Colaborador>& parte) {
+        empresa.insert(empresa.end(), parte.begin(), parte.end());
+    });
+    return arquivarAno(empresa, ano);
+}
+
+// --virar-ano: fecha o ano para a empresa inteira e abre o seguinte (viragem.h)
+// Corre antes de a sessão abrir os dados: o trabalho lê e substitui o ficheiro por si
+bool virarAnoFechado(const std::string& ficheiro, int ano, const PoliticaViragem& politica, bool forcar) {
+    if (std::ifstream(MANIFESTO_POR_OMISSAO).is_open()) {
+        std::cerr << COR_VERMELHA << "ERRO: A viragem do ano usa o " << ficheiro << " e os dados estao divididos por departamento ("
+                  << MANIFESTO_POR_OMISSAO << ").\n" << RESET_COR;
+        return false;
+    }
+    return virarAno(ficheiro, ano, politica, forcar);
+}
+
+int main(int argc, char* argv[]) {
+    SessaoDados sessao;
+    std::vector<Colaborador>& listaColaboradores = sessao.lista;
     const std::string FICHEIRO_DADOS = "rh_data.txt";
+
+    OpcoesPrograma opcoes;
+    if (!lerOpcoes(argc, argv, opcoes)) {
+        return 1;
+    }
+    if (opcoes.mostrarMetricasNoFim) ativarMetricas(true);
+    if (!opcoes.ficheiroTrace.empty()) ativarTrace(true);
+
+    // Modo servidor: sem menu, os operadores usam o cliente
+    if (opcoes.modoServidor) {
+        int codigo = executarServidor(opcoes.caminhoSocket, FICHEIRO_DADOS);
+        terminarMetricas(opcoes);
+        return codigo;
+    }
     
-    // Carregar dados ao iniciar
-    carregarDados(listaColaboradores, FICHEIRO_DADOS);
+    // Carregar dados ao iniciar (só o rodapé do índice, se o ficheiro o tiver)
+    sessao.ficheiro = FICHEIRO_DADOS;
+    sessao.intervaloAutosave = opcoes.intervaloAutosave;
+    if (opcoes.anoVirar != 0) {
+        bool virado = virarAnoFechado(FICHEIRO_DADOS, opcoes.anoVirar, opcoes.politica, opcoes.forcarViragem);
+        terminarMetricas(opcoes);
+        return virado ? 0 : 1;
+    }
+    if (iniciarFragmentos(sessao, opcoes)) {
+        // Lista do âmbito já carregada
+    } else if (!opcoes.cargaCompleta && sessao.indice.abrir(FICHEIRO_DADOS)) {
+        std::cout << COR_VERDE << "[INFO] Indice de " << sessao.indice.size()
+                  << " colaboradores aberto (carga a pedido).\n" << RESET_COR;
+    } else {
+        garantirListaCarregada(sessao);
+    }
+
+    sessao.cobertura.lerRegras(FICHEIRO_COBERTURA);
+    sessao.validades.lerRegras(FICHEIRO_VALIDADES);
+
+    if (opcoes.anoArquivar != 0) {
+        bool arquivado = arquivarAnoFechado(sessao, opcoes.anoArquivar);
+        pararAutosave();
+        terminarMetricas(opcoes);
+        return arquivado ? 0 : 1;
+    }
 
     int opcao;
 
@@ -178,7 +630,7 @@ int main() {
 
         // Validação de input numérico e tratamento de buffer
         if (!(std::cin >> opcao)) {
-            std::cout << COR_AMARELA << "Input invalido. Por favor, digite um numero (0-10).\n" << RESET_COR;
+            std::cout << COR_AMARELA << "Input invalido. Por favor, digite um numero (0-" << ULTIMA_OPCAO_MENU << ").\n" << RESET_COR;
             std::cin.clear();
             std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
             continue;
@@ -190,69 +642,246 @@ int main() {
 
 
 
+        // Só as consultas individuais (4 e 6) funcionam sem a lista completa
+        if (opcao != 0 && opcao != 4 && opcao != 6 && opcao != 99) {
+            garantirListaCarregada(sessao);
+        }
+
         switch (opcao) {
-            case 1:
+            case 1: {
+                std::lock_guard<std::mutex> lock(mutexDados);
+                garantirIndiceNomes(sessao);
                 adicionarColaborador(listaColaboradores);
+                sessao.coberturaConstruida = false;
+                sessao.formacoesConstruidas = false;
+            }
 
                 break;
-            case 2:
+            case 2: {
+                std::lock_guard<std::mutex> lock(mutexDados);
                 removerColaborador(listaColaboradores);
+                sessao.coberturaConstruida = false;
+                sessao.formacoesConstruidas = false;
+            }
 
                 break;
-            case 3:
-                menuGerirMarcacoes(listaColaboradores);
+            case 3: {
+                std::lock_guard<std::mutex> lock(mutexDados);
+                menuGerirMarcacoes(listaColaboradores, garantirCobertura(sessao), garantirAusencias(sessao));
+            }
 
                 break;
-            case 4:
+            case 4: {
+                // Sem a lista carregada o autosave ainda não corre (e pedirColaboradorIndexado pode arrancá-lo)
+                if (!sessao.listaCarregada) {
+                    const Colaborador* colab = pedirColaboradorIndexado(sessao, "Visualizar Calendario");
+                    if (colab != nullptr) pedirMesEVisualizarCalendario(*colab);
+                    break;
+                }
+                std::lock_guard<std::mutex> lock(mutexDados);
                 menuVisualizarCalendario(listaColaboradores);
+            }
 
                 break;
             case 5:
-                listarColaboradores(listaColaboradores);
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    listarColaboradores(listaColaboradores);
+                }
                 std::cout << "Pressione ENTER para continuar...";
                 std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
                 std::cin.get();
 
                 break;
-            case 6: // Procurar Colaborador
+            case 6: { // Procurar Colaborador
+                if (!sessao.listaCarregada) {
+                    const Colaborador* colab = pedirColaboradorIndexado(sessao, "Procurar Colaborador");
+                    if (colab != nullptr) mostrarColaborador(*colab);
+                    break;
+                }
+                std::lock_guard<std::mutex> lock(mutexDados);
                 procurarColaborador(listaColaboradores);
+            }
 
                 break;
-            case 7: // Gerir Formações e Notas
+            case 7: { // Gerir Formações e Notas
+                std::lock_guard<std::mutex> lock(mutexDados);
                 menuGestaoColaborador(listaColaboradores);
+                sessao.formacoesConstruidas = false;
+            }
 
                 break;
             case 8: // Dashboard Resumido
-                dashboardResumido(listaColaboradores);
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    dashboardResumido(listaColaboradores);
+                }
                 std::cout << "\nPressione ENTER para continuar...";
                 std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
                 std::cin.get();
 
                 break;
             case 9: // Relatório Mensal
-                relatorioMensal(listaColaboradores);
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    relatorioMensal(listaColaboradores);
+                }
                 std::cout << "\nPressione ENTER para continuar...";
                 std::cin.get();
 
                 break;
             case 10: // Estatísticas de Departamento 
-                estatisticasDepartamento(listaColaboradores);
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    if (sessao.fragmentado) {
+                        estatisticasDepartamentoPorPartes(percorrerEmpresa(sessao));
+                    } else {
+                        estatisticasDepartamento(listaColaboradores);
+                    }
+                }
                 std::cout << "\nPressione ENTER para continuar...";
                 std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
                 std::cin.get();
 
                 break;
             case 11: // Exportação
-                exportarDados(listaColaboradores);
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    exportarDados(listaColaboradores, percorrerEmpresa(sessao));
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+
+                break;
+            case 12: // Uso de memória por subsistema
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    mostrarRelatorioMemoria(listaColaboradores);
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+
+                break;
+            case 13: { // Ausências por departamento entre duas datas
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    PercorrerEmpresa empresa = percorrerEmpresa(sessao);
+                    if (!empresa) empresa = [&](const VisitarParte& visitar) { visitar(listaColaboradores); };
+                    relatorioAusenciasIntervalo(empresa, garantirAusencias(sessao));
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+            }
+
+                break;
+            case 14: { // Mapa de ausências por departamento e dia
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    PercorrerEmpresa empresa = percorrerEmpresa(sessao);
+                    if (!empresa) empresa = [&](const VisitarParte& visitar) { visitar(listaColaboradores); };
+                    relatorioMapaCalor(empresa);
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+            }
+
+                break;
+            case 15: // Regras de cobertura mínima e capacidade por departamento
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    menuCobertura(garantirCobertura(sessao));
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+
+                break;
+            case 16: { // Plano de férias a partir de um ficheiro de pedidos
+                {
+                    // O autosave fica bloqueado só durante o planeamento, não à espera do ENTER
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    menuPlaneamentoFerias(listaColaboradores, garantirCobertura(sessao));
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+            }
+
+                break;
+            case 17: // Formações de toda a empresa por curso e data de conclusão
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    menuPesquisaFormacoes(garantirIndiceFormacoes(sessao));
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+
+                break;
+            case 18: // Pesquisa de texto nas notas internas
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    menuPesquisaNotas(garantirIndiceNotas(sessao), listaColaboradores);
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+
+                break;
+            case 19: // Formações que expiram e exportação das renovações
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    menuValidades(garantirValidades(sessao), listaColaboradores);
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+
+                break;
+            case 20: // Pares de colaboradores com nomes iguais ou quase iguais
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    menuDuplicados(listaColaboradores);
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+
+                break;
+            case 21: // Colaboradores com faltas curtas e frequentes ou junto ao fim de semana
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    relatorioPadroesAusencia(listaColaboradores);
+                }
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+
+                break;
+            case 22: // Top-K de colaboradores e departamentos por ausências
+                {
+                    std::lock_guard<std::mutex> lock(mutexDados);
+                    menuRanking(garantirRanking(sessao));
+                }
                 std::cout << "\nPressione ENTER para continuar...";
                 std::cin.get();
 
                 break;
             case 0:
-                // Guardar dados ao sair
-                guardarDados(listaColaboradores, FICHEIRO_DADOS);
-                std::cout << COR_VERDE << "Dados guardados. Obrigado!\n" << RESET_COR;
+                // Guardar dados ao sair (a gravação completa substitui o journal do autosave).
+                // Se a lista nunca foi carregada, não houve alterações.
+                if (sessao.fragmentado) {
+                    pararAutosave();
+                    guardarFragmentos(sessao.armazem, listaColaboradores);
+                    std::cout << COR_VERDE << "Dados guardados. Obrigado!\n" << RESET_COR;
+                } else if (sessao.listaCarregada) {
+                    pararAutosave();
+                    guardarDados(listaColaboradores, FICHEIRO_DADOS);
+                    std::cout << COR_VERDE << "Dados guardados. Obrigado!\n" << RESET_COR;
+                } else {
+                    std::cout << COR_VERDE << "Sem alteracoes para guardar. Obrigado!\n" << RESET_COR;
+                }
+                terminarMetricas(opcoes);
                 return 0;
+            case 99: // Opção escondida: estatísticas de desempenho
+                mostrarMetricas();
+                std::cout << "\nPressione ENTER para continuar...";
+                std::cin.get();
+
+                break;
             default:
                 std::cout << COR_VERMELHA << "Opcao invalida. Tente novamente.\n"<< RESET_COR;
                 std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
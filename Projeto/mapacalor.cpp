@@ -0,0 +1,204 @@
+#include "mapacalor.h"
+#include "calendario.h"
+#include "arquivo.h"
+#include "paralelo.h"
+#include "cores.h"
+#include "metricas.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <unordered_map>
+#include <map>
+#include <cmath>
+
+// ===============================================
+// CÁLCULO
+// ===============================================
+
+// Matriz parcial de uma thread
+struct ParcialMapaCalor {
+    std::vector<LinhaMapaCalor> linhas;
+    std::unordered_map<std::string, size_t> posicao;
+
+    size_t posicaoDe(const std::string& departamento) {
+        auto it = posicao.find(departamento);
+        if (it != posicao.end()) return it->second;
+        posicao.emplace(departamento, linhas.size());
+        linhas.emplace_back();
+        linhas.back().departamento = departamento;
+        return linhas.size() - 1;
+    }
+};
+
+void acrescentarMapaCalor(MapaCalor& mapa, const std::vector<Colaborador>& parte) {
+    MEDIR_ESCOPO(Metrica::MAPA_CALOR);
+    // Só um ano fechado com arquivo precisa de o consultar; caso contrário usa-se o calendário em memória
+    const bool usarArquivo = mapa.ano < obterAnoAtual() && anoArquivado(mapa.ano);
+
+    std::vector<ParcialMapaCalor> parciais(numeroThreads());
+    executarBlocos(parte.size(), [&](size_t inicio, size_t fim, unsigned t) {
+        ParcialMapaCalor& parcial = parciais[t];
+        std::map<int, TipoMarcacao> arquivado;
+        const std::string* ultimoDepto = nullptr;
+        size_t ultimaLinha = 0;
+
+        for (size_t i = inicio; i < fim; ++i) {
+            const Colaborador& colab = parte[i];
+            // Colaboradores seguidos costumam ser do mesmo departamento: evita o hash do nome
+            if (ultimoDepto == nullptr || *ultimoDepto != colab.departamento) {
+                ultimaLinha = parcial.posicaoDe(colab.departamento);
+                ultimoDepto = &colab.departamento;
+            }
+            LinhaMapaCalor& linha = parcial.linhas[ultimaLinha];
+            ++linha.colaboradores;
+
+            const auto& calendario = usarArquivo ? calendarioDoAno(colab, mapa.ano, arquivado) : colab.calendario;
+            for (const auto& par : calendario) {
+                if (par.first < 1 || par.first > DIAS_MAPA_CALOR) continue;
+                linha.ferias[par.first - 1] += contaTipo(MASCARA_FERIAS, par.second);
+                linha.faltas[par.first - 1] += contaTipo(MASCARA_FALTAS, par.second);
+            }
+        }
+    });
+
+    // Somar as parciais ao mapa, mantendo as linhas ordenadas por departamento
+    for (const auto& parcial : parciais) {
+        for (const auto& origem : parcial.linhas) {
+            auto it = std::lower_bound(mapa.linhas.begin(), mapa.linhas.end(), origem.departamento,
+                                       [](const LinhaMapaCalor& l, const std::string& d) { return l.departamento < d; });
+            if (it == mapa.linhas.end() || it->departamento != origem.departamento) {
+                mapa.linhas.insert(it, origem);
+                continue;
+            }
+            it->colaboradores += origem.colaboradores;
+            for (int d = 0; d < DIAS_MAPA_CALOR; ++d) {
+                it->ferias[d] += origem.ferias[d];
+                it->faltas[d] += origem.faltas[d];
+            }
+        }
+    }
+}
+
+MapaCalor calcularMapaCalor(const std::vector<Colaborador>& lista, int ano) {
+    MapaCalor mapa;
+    mapa.ano = ano;
+    acrescentarMapaCalor(mapa, lista);
+    return mapa;
+}
+
+MapaCalor calcularMapaCalor(const PercorrerEmpresa& empresa, int ano) {
+    MapaCalor mapa;
+    mapa.ano = ano;
+    empresa([&](const std::vector<Colaborador>& parte) { acrescentarMapaCalor(mapa, parte); });
+    return mapa;
+}
+
+// ===============================================
+// APRESENTAÇÃO E EXPORTAÇÃO
+// ===============================================
+
+static const int SEMANAS_MAPA_CALOR = (DIAS_MAPA_CALOR + 6) / 7;
+static const char NIVEIS_MAPA_CALOR[] = ".:-=+*#%@"; // '.' = ninguém ausente, '@' = pico do mapa
+
+// Percentagem máxima de ausentes (férias + faltas) num dia da semana 'semana' (0 a 52)
+static double picoSemana(const LinhaMapaCalor& linha, int semana, int diasNoAno) {
+    if (linha.colaboradores == 0) return 0.0;
+    uint32_t maximo = 0;
+    for (int d = semana * 7; d < std::min(diasNoAno, semana * 7 + 7); ++d) {
+        maximo = std::max(maximo, linha.ferias[d] + linha.faltas[d]);
+    }
+    return 100.0 * maximo / linha.colaboradores;
+}
+
+void mostrarMapaCalor(const MapaCalor& mapa) {
+    if (mapa.linhas.empty()) {
+        std::cout << COR_AMARELA << "AVISO: Nao ha colaboradores para o mapa de ausencias.\n" << RESET_COR;
+        return;
+    }
+    const int diasNoAno = dataParaDiaDoAno(31, 12, mapa.ano);
+
+    double maximo = 0.0;
+    for (const auto& linha : mapa.linhas) {
+        for (int s = 0; s < SEMANAS_MAPA_CALOR; ++s) maximo = std::max(maximo, picoSemana(linha, s, diasNoAno));
+    }
+
+    std::cout << COR_AZUL << "\n--- Mapa de Ausencias " << mapa.ano << " (pico semanal de ausentes, % do departamento) ---\n" << RESET_COR;
+
+    // Cabeçalho: inicial do mês na semana em que o mês começa
+    std::string meses(SEMANAS_MAPA_CALOR, ' ');
+    for (int mes = 1; mes <= 12; ++mes) {
+        meses[static_cast<size_t>((dataParaDiaDoAno(1, mes, mapa.ano) - 1) / 7)] = nomeMes(mes)[0];
+    }
+    std::cout << std::left << std::setw(16) << "Departamento" << meses << "  Pico\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (const auto& linha : mapa.linhas) {
+        std::cout << std::left << std::setw(16) << linha.departamento.substr(0, 15);
+        double picoLinha = 0.0;
+        for (int s = 0; s < SEMANAS_MAPA_CALOR; ++s) {
+            double pct = picoSemana(linha, s, diasNoAno);
+            picoLinha = std::max(picoLinha, pct);
+            int nivel = (pct <= 0.0 || maximo <= 0.0) ? 0 : std::max(1, static_cast<int>(std::ceil(8.0 * pct / maximo)));
+            const std::string& cor = nivel >= 7 ? COR_VERMELHA : (nivel >= 4 ? COR_AMARELA : COR_VERDE);
+            std::cout << cor << NIVEIS_MAPA_CALOR[nivel] << RESET_COR;
+        }
+        std::cout << "  " << picoLinha << "%\n";
+    }
+    std::cout << "Escala: . = ninguem ausente, : a @ = ate " << maximo << "% do departamento ausente no mesmo dia\n";
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
+
+bool exportarMapaCalorCSV(const MapaCalor& mapa, const std::string& nomeFicheiro) {
+    BufferEscrita saida(nomeFicheiro);
+    if (!saida.aberto()) return false;
+
+    saida.escrever("Departamento,Data,Colaboradores,Ferias,Faltas\n");
+    for (const auto& linha : mapa.linhas) {
+        for (int d = 1; d <= DIAS_MAPA_CALOR; ++d) {
+            int dia = 0, mes = 0;
+            if (!diaDoAnoParaData(d, mapa.ano, dia, mes)) continue;
+            saida.escrever(linha.departamento);
+            saida.escreverChar(',');
+            saida.escreverData(dia, mes, mapa.ano);
+            saida.escreverChar(',');
+            saida.escreverInt(linha.colaboradores);
+            saida.escreverChar(',');
+            saida.escreverInt(linha.ferias[d - 1]);
+            saida.escreverChar(',');
+            saida.escreverInt(linha.faltas[d - 1]);
+            saida.escreverChar('\n');
+        }
+    }
+    return true;
+}
+
+void relatorioMapaCalor(const PercorrerEmpresa& empresa) {
+    int ano = obterAnoAtual();
+    std::string texto;
+    std::cout << COR_AZUL << "\n--- Mapa de Ausencias (Departamento x Dia) ---\n" << RESET_COR;
+    std::cout << "Ano (ENTER = " << ano << "): ";
+    std::getline(std::cin, texto);
+    if (!texto.empty()) {
+        try {
+            ano = std::stoi(texto);
+        } catch (const std::exception&) {
+            std::cout << COR_VERMELHA << "ERRO: Ano invalido.\n" << RESET_COR;
+            return;
+        }
+    }
+
+    MapaCalor mapa = calcularMapaCalor(empresa, ano);
+    mostrarMapaCalor(mapa);
+    if (mapa.linhas.empty()) return;
+
+    std::cout << COR_AZUL << "Exportar para CSV? (S/N): " << RESET_COR;
+    std::getline(std::cin, texto);
+    if (texto.empty() || (texto[0] != 'S' && texto[0] != 's')) return;
+
+    const std::string nomeFicheiro = "mapa_ausencias_" + std::to_string(ano) + ".csv";
+    if (exportarMapaCalorCSV(mapa, nomeFicheiro)) {
+        std::cout << COR_VERDE << "Mapa de " << mapa.linhas.size() << " departamentos exportado para " << nomeFicheiro << "\n" << RESET_COR;
+    } else {
+        std::cout << COR_VERMELHA << "ERRO: Nao foi possivel abrir o ficheiro " << nomeFicheiro << " para escrita.\n" << RESET_COR;
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef MAPACALOR_H
+#define MAPACALOR_H
+
+#include "colaborador.h"
+#include "reports.h"
+#include <string>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+// ===============================================
+// MAPA DE AUSÊNCIAS (DEPARTAMENTO x DIA)
+// ===============================================
+// Matriz com o número de colaboradores de férias e com falta em cada dia do ano, por departamento.
+// É calculada numa única passagem paralela pelos calendários: cada thread acumula uma matriz
+// parcial (só com os departamentos que encontrou) e as parciais são somadas no fim.
+
+const int DIAS_MAPA_CALOR = 366;
+
+struct LinhaMapaCalor {
+    std::string departamento;
+    uint32_t colaboradores = 0;
+    std::array<uint32_t, DIAS_MAPA_CALOR> ferias{}; // Índice = dia do ano - 1
+    std::array<uint32_t, DIAS_MAPA_CALOR> faltas{};
+};
+
+struct MapaCalor {
+    int ano = 0;
+    std::vector<LinhaMapaCalor> linhas; // Ordenadas pelo nome do departamento
+};
+
+// Junta uma parte da empresa ao mapa (mapa.ano já definido). Para um ano arquivado, os
+// calendários vêm do arquivo desse ano (ver calendarioDoAno).
+void acrescentarMapaCalor(MapaCalor& mapa, const std::vector<Colaborador>& parte);
+
+MapaCalor calcularMapaCalor(const std::vector<Colaborador>& lista, int ano);
+MapaCalor calcularMapaCalor(const PercorrerEmpresa& empresa, int ano);
+
+// Grelha compacta: uma linha por departamento, uma coluna por semana (pico de ausentes na semana)
+void mostrarMapaCalor(const MapaCalor& mapa);
+
+// CSV com uma linha por departamento e dia: Departamento,Data,Colaboradores,Ferias,Faltas
+bool exportarMapaCalorCSV(const MapaCalor& mapa, const std::string& nomeFicheiro);
+
+// Opção do menu: pede o ano, mostra a grelha e oferece a exportação
+void relatorioMapaCalor(const PercorrerEmpresa& empresa);
+
+#endif // MAPACALOR_H
@@ -0,0 +1,166 @@
+#ifndef MARCACOES_H
+#define MARCACOES_H
+
+#include "cores.h"
+#include <array>
+#include <cstdint>
+#include <string>
+
+// ===============================================
+// TIPOS DE MARCAÇÃO E AS SUAS PROPRIEDADES
+// ===============================================
+// Tudo o que distingue um tipo de marcação está numa só tabela constante: o símbolo (ficheiro de
+// dados, arquivo, protocolo, CSV e calendário), a cor, o nome, se pode ser marcado, se desconta no
+// saldo de férias, se é uma ausência e se é uma ausência imprevista. Os conversores, o calendário
+// e as contagens são gerados a partir dela em tempo de compilação; as contagens usam máscaras de
+// bits (um bit por tipo), por isso acrescentar um tipo é acrescentar uma linha à tabela e não um
+// ramo nos ciclos que percorrem os calendários.
+
+enum class TipoMarcacao : uint8_t {
+    LIVRE,        // ' ' - Dia normal de trabalho
+    FERIAS,       // 'F' - Dia de férias
+    FALTA,        // 'X' - Dia de falta
+    FIM_SEMANA,   // 'S' - Fim de semana (normalmente não é marcável pelo utilizador)
+    NAO_MARCADO,  // Não marcado (usado internamente)
+    BAIXA,        // 'B' - Baixa médica
+    FORMACAO,     // 'C' - Dia de formação (curso)
+    TELETRABALHO, // 'T' - Trabalho remoto
+    PARENTAL      // 'P' - Licença parental
+};
+
+struct PropriedadesMarcacao {
+    TipoMarcacao tipo;
+    char simbolo;           // ' ' = sem símbolo
+    const std::string* cor; // cores.h
+    const char* nome;       // Legenda e mensagens
+    bool marcavel;          // O utilizador pode marcar e o ficheiro de dados guarda
+    bool descontaSaldo;     // Gasta dias de férias
+    bool ausencia;          // O colaborador não está ao serviço (cobertura, índices, rankings)
+    bool imprevista;        // Ausência não planeada (fator de Bradford)
+};
+
+// Pela ordem do enum
+constexpr PropriedadesMarcacao PROPRIEDADES_MARCACAO[] = {
+    // tipo                      simb. cor              nome             marc.  saldo  aus.   impr.
+    {TipoMarcacao::LIVRE,        ' ', &COR_VERDE,      "Livre",         false, false, false, false},
+    {TipoMarcacao::FERIAS,       'F', &COR_AZUL,       "Ferias",        true,  true,  true,  false},
+    {TipoMarcacao::FALTA,        'X', &COR_VERMELHA,   "Falta",         true,  false, true,  true},
+    {TipoMarcacao::FIM_SEMANA,   'S', &COR_CIANO,      "Fim de Semana", false, false, false, false},
+    {TipoMarcacao::NAO_MARCADO,  ' ', &RESET_COR,      "Nao Marcado",   false, false, false, false},
+    {TipoMarcacao::BAIXA,        'B', &COR_AMARELA,    "Baixa",         true,  false, true,  true},
+    {TipoMarcacao::FORMACAO,     'C', &COR_ROXO,       "Formacao",      true,  false, false, false},
+    {TipoMarcacao::TELETRABALHO, 'T', &COR_FIM_SEMANA, "Teletrabalho",  true,  false, false, false},
+    {TipoMarcacao::PARENTAL,     'P', &COR_FERIAS,     "Parental",      true,  false, true,  false},
+};
+
+constexpr size_t NUM_TIPOS_MARCACAO = sizeof(PROPRIEDADES_MARCACAO) / sizeof(PROPRIEDADES_MARCACAO[0]);
+
+constexpr const PropriedadesMarcacao& propriedadesMarcacao(TipoMarcacao tipo) {
+    return PROPRIEDADES_MARCACAO[static_cast<size_t>(tipo)];
+}
+
+// Bits para guardar um tipo por dia num formato compacto: ceil(log2(NUM_TIPOS_MARCACAO))
+constexpr int bitsParaValores(size_t valores) {
+    int bits = 0;
+    while ((size_t{1} << bits) < valores) ++bits;
+    return bits;
+}
+
+constexpr int BITS_POR_TIPO = bitsParaValores(NUM_TIPOS_MARCACAO);
+
+// --- Máscaras de tipos ---
+
+using MascaraTipos = uint32_t;
+
+constexpr MascaraTipos bitTipo(TipoMarcacao tipo) {
+    return MascaraTipos{1} << static_cast<unsigned>(tipo);
+}
+
+constexpr MascaraTipos mascaraDe(bool PropriedadesMarcacao::*propriedade) {
+    MascaraTipos mascara = 0;
+    for (const auto& p : PROPRIEDADES_MARCACAO) {
+        if (p.*propriedade) mascara |= bitTipo(p.tipo);
+    }
+    return mascara;
+}
+
+constexpr MascaraTipos MASCARA_MARCAVEL = mascaraDe(&PropriedadesMarcacao::marcavel);
+constexpr MascaraTipos MASCARA_DESCONTA_SALDO = mascaraDe(&PropriedadesMarcacao::descontaSaldo);
+constexpr MascaraTipos MASCARA_AUSENCIA = mascaraDe(&PropriedadesMarcacao::ausencia);
+constexpr MascaraTipos MASCARA_IMPREVISTA = mascaraDe(&PropriedadesMarcacao::imprevista);
+
+// As duas colunas dos relatórios, índices e rankings: férias (ausências que gastam saldo) e
+// faltas (as outras ausências: faltas, baixas, licenças)
+constexpr MascaraTipos MASCARA_FERIAS = MASCARA_AUSENCIA & MASCARA_DESCONTA_SALDO;
+constexpr MascaraTipos MASCARA_FALTAS = MASCARA_AUSENCIA & ~MASCARA_DESCONTA_SALDO;
+
+constexpr bool temTipo(MascaraTipos mascara, TipoMarcacao tipo) {
+    return ((mascara >> static_cast<unsigned>(tipo)) & 1u) != 0;
+}
+
+// 0 ou 1, para somar sem ramos nos ciclos de contagem
+constexpr int contaTipo(MascaraTipos mascara, TipoMarcacao tipo) {
+    return static_cast<int>((mascara >> static_cast<unsigned>(tipo)) & 1u);
+}
+
+// --- Granularidade ---
+
+// O tempo marcado e os saldos estão em unidades fixas: um dia inteiro tem UNIDADES_POR_DIA
+// unidades (uma por hora de um dia de 8 horas) e meio dia tem MEIO_DIA. Um dia marcado só em
+// parte usa de 1 a UNIDADES_POR_DIA - 1 unidades, o que cabe num nibble.
+constexpr int UNIDADES_POR_DIA = 8;
+constexpr int MEIO_DIA = UNIDADES_POR_DIA / 2;
+
+// --- Símbolos ---
+
+// Símbolo -> tipo marcável (NAO_MARCADO se o símbolo não for de nenhum)
+constexpr std::array<TipoMarcacao, 256> tabelaSimbolos() {
+    std::array<TipoMarcacao, 256> tabela{};
+    for (auto& t : tabela) t = TipoMarcacao::NAO_MARCADO;
+    for (const auto& p : PROPRIEDADES_MARCACAO) {
+        if (p.marcavel) tabela[static_cast<unsigned char>(p.simbolo)] = p.tipo;
+    }
+    return tabela;
+}
+
+constexpr std::array<TipoMarcacao, 256> TIPO_POR_SIMBOLO = tabelaSimbolos();
+
+constexpr TipoMarcacao tipoDoSimbolo(char simbolo) {
+    return TIPO_POR_SIMBOLO[static_cast<unsigned char>(simbolo)];
+}
+
+// Símbolo mostrado no calendário (' ' para dias livres e fins de semana)
+constexpr char simboloCalendario(TipoMarcacao tipo) {
+    return temTipo(MASCARA_MARCAVEL, tipo) ? propriedadesMarcacao(tipo).simbolo : ' ';
+}
+
+// --- Verificações da tabela ---
+
+constexpr bool tabelaPelaOrdemDoEnum() {
+    for (size_t i = 0; i < NUM_TIPOS_MARCACAO; ++i) {
+        if (static_cast<size_t>(PROPRIEDADES_MARCACAO[i].tipo) != i) return false;
+    }
+    return true;
+}
+
+constexpr bool simbolosMarcaveisUnicos() {
+    for (const auto& p : PROPRIEDADES_MARCACAO) {
+        if (!p.marcavel) continue;
+        // Os símbolos marcáveis separam intervalos no ficheiro de dados: não podem ser dígitos nem separadores
+        if (p.simbolo == ' ' || (p.simbolo >= '0' && p.simbolo <= '9') || p.simbolo == ',' || p.simbolo == ':' ||
+            p.simbolo == '-' || p.simbolo == ';') {
+            return false;
+        }
+        if (tipoDoSimbolo(p.simbolo) != p.tipo) return false;
+    }
+    return true;
+}
+
+static_assert(tabelaPelaOrdemDoEnum(), "PROPRIEDADES_MARCACAO tem de seguir a ordem de TipoMarcacao");
+static_assert(NUM_TIPOS_MARCACAO <= sizeof(MascaraTipos) * 8, "Demasiados tipos para MascaraTipos");
+static_assert(simbolosMarcaveisUnicos(), "Simbolos de marcacao repetidos ou invalidos");
+static_assert(UNIDADES_POR_DIA >= 2 && UNIDADES_POR_DIA - 1 <= 15, "Um dia parcial tem de caber num nibble");
+static_assert((MASCARA_DESCONTA_SALDO & ~MASCARA_MARCAVEL) == 0 && (MASCARA_IMPREVISTA & ~MASCARA_AUSENCIA) == 0,
+              "Propriedades de marcacao incoerentes");
+
+#endif // MARCACOES_H
@@ -0,0 +1,141 @@
+#include "memoria.h"
+#include "cores.h"
+#include <iostream>
+#include <iomanip>
+#include <set>
+
+// Tamanho real de um bloco pedido ao alocador: cabeçalho + arredondamento a 16 bytes (mínimo 32)
+static size_t tamanhoAlocacao(size_t pedido) {
+    if (pedido == 0) return 0;
+    size_t comCabecalho = pedido + sizeof(void*);
+    size_t arredondado = (comCabecalho + 15) / 16 * 16;
+    return arredondado < 32 ? 32 : arredondado;
+}
+
+size_t memoriaString(const std::string& s) {
+    // Capacidade do buffer interno (Small String Optimization) da implementação atual
+    static const size_t capacidadeSSO = std::string().capacity();
+    if (s.capacity() <= capacidadeSSO) return 0;
+    return tamanhoAlocacao(s.capacity() + 1);
+}
+
+size_t memoriaNoCalendario() {
+    // Nó de árvore vermelho-preta: cor + 3 ponteiros (pai, esquerda, direita) + par chave/valor
+    return tamanhoAlocacao(4 * sizeof(void*) + sizeof(std::pair<const int, TipoMarcacao>));
+}
+
+// Memória de um único colaborador (sem a parte do vetor principal)
+static DetalheMemoria memoriaColaborador(const Colaborador& colab) {
+    DetalheMemoria d;
+
+    // Os dias parciais são nós do mesmo tamanho (chave int, valor de um byte)
+    d.calendarios.objetos = colab.calendario.size() + colab.parciais.size();
+    d.calendarios.bytes = d.calendarios.objetos * memoriaNoCalendario();
+
+    d.strings.objetos = 2;
+    d.strings.bytes = memoriaString(colab.nome) + memoriaString(colab.departamento);
+
+    d.formacoes.objetos = colab.formacoes.size();
+    d.formacoes.bytes = tamanhoAlocacao(colab.formacoes.capacity() * sizeof(Formacao));
+    for (const auto& f : colab.formacoes) {
+        d.formacoes.bytes += memoriaString(f.nome_curso) + memoriaString(f.data_conclusao);
+    }
+
+    d.notas.objetos = colab.notas.size();
+    d.notas.bytes = tamanhoAlocacao(colab.notas.capacity() * sizeof(Nota));
+    for (const auto& n : colab.notas) {
+        d.notas.bytes += memoriaString(n.texto) + memoriaString(n.data_criacao);
+    }
+    return d;
+}
+
+static void somarDetalhe(DetalheMemoria& destino, const DetalheMemoria& origem) {
+    destino.roster.somar(origem.roster);
+    destino.calendarios.somar(origem.calendarios);
+    destino.strings.somar(origem.strings);
+    destino.formacoes.somar(origem.formacoes);
+    destino.notas.somar(origem.notas);
+}
+
+RelatorioMemoria calcularMemoria(const std::vector<Colaborador>& lista) {
+    RelatorioMemoria r;
+    r.numColaboradores = lista.size();
+
+    // O vetor principal reserva capacity() estruturas, mesmo que não estejam todas em uso
+    r.total.roster.objetos = lista.size();
+    r.total.roster.bytes = tamanhoAlocacao(lista.capacity() * sizeof(Colaborador));
+
+    for (const auto& colab : lista) {
+        DetalheMemoria d = memoriaColaborador(colab);
+        d.roster.objetos = 1;
+        d.roster.bytes = sizeof(Colaborador);
+
+        somarDetalhe(r.porDepartamento[colab.departamento], d);
+
+        d.roster = UsoMemoria(); // O roster total já foi contado pela capacidade
+        somarDetalhe(r.total, d);
+        r.numMarcacoes += colab.calendario.size();
+    }
+    return r;
+}
+
+static void imprimirLinha(const std::string& nome, const UsoMemoria& uso, size_t total) {
+    double percentagem = total > 0 ? 100.0 * static_cast<double>(uso.bytes) / static_cast<double>(total) : 0.0;
+    std::cout << std::left << std::setw(22) << nome << std::right
+              << std::setw(14) << uso.bytes
+              << std::setw(12) << std::fixed << std::setprecision(2) << static_cast<double>(uso.bytes) / (1024.0 * 1024.0)
+              << std::setw(12) << uso.objetos
+              << std::setw(9) << std::setprecision(1) << percentagem << "%\n";
+}
+
+void mostrarRelatorioMemoria(const std::vector<Colaborador>& lista) {
+    RelatorioMemoria r = calcularMemoria(lista);
+    size_t total = r.total.totalBytes();
+
+    std::cout << COR_AZUL << "\n--- Uso de Memoria por Subsistema (estimativa) ---\n" << RESET_COR;
+    std::cout << "Colaboradores: " << r.numColaboradores << " | Marcacoes: " << r.numMarcacoes << "\n";
+    std::cout << "======================================================================\n";
+    std::cout << std::left << std::setw(22) << "Subsistema" << std::right
+              << std::setw(14) << "Bytes" << std::setw(12) << "MiB" << std::setw(12) << "Objetos" << std::setw(10) << "%" << "\n";
+    std::cout << "----------------------------------------------------------------------\n";
+    imprimirLinha("Roster (vetor)", r.total.roster, total);
+    imprimirLinha("Calendarios (map)", r.total.calendarios, total);
+    imprimirLinha("Strings (nome/depto)", r.total.strings, total);
+    imprimirLinha("Formacoes", r.total.formacoes, total);
+    imprimirLinha("Notas", r.total.notas, total);
+    std::cout << "----------------------------------------------------------------------\n";
+    std::cout << std::left << std::setw(22) << "TOTAL" << std::right << std::setw(14) << total
+              << std::setw(12) << std::setprecision(2) << static_cast<double>(total) / (1024.0 * 1024.0) << "\n";
+
+    // Repartição por departamento
+    std::cout << COR_CIANO << "\nPor departamento:\n" << RESET_COR;
+    std::cout << std::left << std::setw(22) << "Departamento" << std::right
+              << std::setw(10) << "Colabs" << std::setw(14) << "Calendarios" << std::setw(12) << "Strings"
+              << std::setw(12) << "Form+Notas" << std::setw(14) << "Total" << "\n";
+    std::cout << "----------------------------------------------------------------------------------\n";
+    for (const auto& par : r.porDepartamento) {
+        const DetalheMemoria& d = par.second;
+        std::cout << std::left << std::setw(22) << par.first << std::right
+                  << std::setw(10) << d.roster.objetos
+                  << std::setw(14) << d.calendarios.bytes
+                  << std::setw(12) << d.strings.bytes
+                  << std::setw(12) << d.formacoes.bytes + d.notas.bytes
+                  << std::setw(14) << d.totalBytes() << "\n";
+    }
+
+    // Quanto se pouparia com formatos alternativos
+    std::set<std::string> deptos;
+    size_t bytesDepto = 0;
+    for (const auto& colab : lista) {
+        deptos.insert(colab.departamento);
+        bytesDepto += memoriaString(colab.departamento);
+    }
+    size_t bitsetCalendarios = r.numColaboradores * ((BITS_POR_TIPO * 366 + 7) / 8); // BITS_POR_TIPO por dia (marcacoes.h)
+    std::cout << COR_AMARELA << "\nPoupancas estimadas:\n" << RESET_COR;
+    std::cout << " - Calendario como bitset de " << BITS_POR_TIPO << " bits/dia: " << bitsetCalendarios << " bytes em vez de "
+              << r.total.calendarios.bytes << "\n";
+    std::cout << " - Departamento partilhado (" << deptos.size() << " valores distintos): ate "
+              << bytesDepto << " bytes de strings\n";
+    std::cout << "======================================================================\n";
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
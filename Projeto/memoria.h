@@ -0,0 +1,57 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include "colaborador.h"
+#include <vector>
+#include <string>
+#include <map>
+
+// --- Contabilidade de Memória (estimativas por subsistema) ---
+// Os valores são estimados a partir dos tamanhos dos tipos, das capacidades reservadas
+// e de um modelo simples do alocador (cabeçalho + arredondamento a 16 bytes).
+
+// Bytes e número de objetos de um subsistema
+struct UsoMemoria {
+    size_t bytes = 0;
+    size_t objetos = 0;
+
+    void somar(const UsoMemoria& outro) {
+        bytes += outro.bytes;
+        objetos += outro.objetos;
+    }
+};
+
+// Uso de memória dividido por subsistema
+struct DetalheMemoria {
+    UsoMemoria roster;      // Estruturas Colaborador (capacidade do vetor)
+    UsoMemoria calendarios; // Nós do std::map de cada calendário
+    UsoMemoria strings;     // Texto em heap de nome e departamento
+    UsoMemoria formacoes;   // Vetores de Formacao + respetivas strings
+    UsoMemoria notas;       // Vetores de Nota + respetivas strings
+
+    size_t totalBytes() const {
+        return roster.bytes + calendarios.bytes + strings.bytes + formacoes.bytes + notas.bytes;
+    }
+};
+
+// Relatório completo (total + por departamento)
+struct RelatorioMemoria {
+    DetalheMemoria total;
+    std::map<std::string, DetalheMemoria> porDepartamento;
+    size_t numColaboradores = 0;
+    size_t numMarcacoes = 0;
+};
+
+// Bytes em heap ocupados por uma string (0 se couber no buffer interno / SSO)
+size_t memoriaString(const std::string& s);
+
+// Bytes de um nó de calendário (std::map<int, TipoMarcacao>)
+size_t memoriaNoCalendario();
+
+// Calcula o relatório de memória da lista
+RelatorioMemoria calcularMemoria(const std::vector<Colaborador>& lista);
+
+// Mostra o relatório na consola (com poupanças estimadas de formatos alternativos)
+void mostrarRelatorioMemoria(const std::vector<Colaborador>& lista);
+
+#endif // MEMORIA_H
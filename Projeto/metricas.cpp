@@ -0,0 +1,292 @@
+#include "metricas.h"
+#include "cores.h"
+#include <vector>
+#include <mutex>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+// ===============================================
+// ESTRUTURAS INTERNAS
+// ===============================================
+
+static const int NUM_METRICAS = static_cast<int>(Metrica::TOTAL);
+static const int NUM_CONTADORES = static_cast<int>(Contador::TOTAL);
+static const int NUM_BUCKETS = 64; // Bucket b guarda durações em [2^b, 2^(b+1)) ns
+
+std::atomic<bool> metricasAtivas(false);
+std::atomic<bool> traceAtivo(false);
+
+// Origem do tempo para os eventos do trace
+static const std::chrono::steady_clock::time_point INICIO_PROGRAMA = std::chrono::steady_clock::now();
+
+// Cada thread escreve apenas no seu próprio bloco (um único escritor),
+// por isso basta load/store relaxed. Os atómicos só servem para a leitura concorrente.
+static void somarRelaxed(std::atomic<uint64_t>& a, uint64_t v) {
+    a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+struct EstatisticaMetrica {
+    std::atomic<uint64_t> chamadas{0};
+    std::atomic<uint64_t> totalNs{0};
+    std::atomic<uint64_t> minNs{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> maxNs{0};
+    std::atomic<uint64_t> buckets[NUM_BUCKETS] = {};
+};
+
+struct EventoTrace {
+    Metrica metrica;
+    uint64_t inicioNs;
+    uint64_t duracaoNs;
+};
+
+struct BlocoThread {
+    EstatisticaMetrica metricas[NUM_METRICAS];
+    std::atomic<uint64_t> contadores[NUM_CONTADORES] = {};
+    std::mutex mutexTrace;
+    std::vector<EventoTrace> eventos;
+    unsigned idThread = 0;
+};
+
+// Registo global dos blocos das threads vivas + acumulador das threads que já terminaram
+static std::mutex mutexRegisto;
+static std::vector<BlocoThread*> blocosAtivos;
+static BlocoThread blocoRetirado;
+static std::vector<std::pair<unsigned, EventoTrace>> eventosRetirados;
+static unsigned proximoIdThread = 1;
+
+static void juntarBloco(BlocoThread& destino, const BlocoThread& origem) {
+    for (int m = 0; m < NUM_METRICAS; ++m) {
+        const EstatisticaMetrica& o = origem.metricas[m];
+        EstatisticaMetrica& d = destino.metricas[m];
+        somarRelaxed(d.chamadas, o.chamadas.load(std::memory_order_relaxed));
+        somarRelaxed(d.totalNs, o.totalNs.load(std::memory_order_relaxed));
+        d.minNs.store(std::min(d.minNs.load(std::memory_order_relaxed), o.minNs.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+        d.maxNs.store(std::max(d.maxNs.load(std::memory_order_relaxed), o.maxNs.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+        for (int b = 0; b < NUM_BUCKETS; ++b) {
+            somarRelaxed(d.buckets[b], o.buckets[b].load(std::memory_order_relaxed));
+        }
+    }
+    for (int c = 0; c < NUM_CONTADORES; ++c) {
+        somarRelaxed(destino.contadores[c], origem.contadores[c].load(std::memory_order_relaxed));
+    }
+}
+
+static void limparBloco(BlocoThread& bloco) {
+    for (auto& m : bloco.metricas) {
+        m.chamadas.store(0, std::memory_order_relaxed);
+        m.totalNs.store(0, std::memory_order_relaxed);
+        m.minNs.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        m.maxNs.store(0, std::memory_order_relaxed);
+        for (auto& b : m.buckets) b.store(0, std::memory_order_relaxed);
+    }
+    for (auto& c : bloco.contadores) c.store(0, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(bloco.mutexTrace);
+    bloco.eventos.clear();
+}
+
+// Dono do bloco da thread: regista-o na criação e, quando a thread termina,
+// passa os valores para o acumulador global (as threads do pool são de curta duração)
+struct DonoBloco {
+    BlocoThread* bloco;
+    DonoBloco() : bloco(new BlocoThread) {
+        std::lock_guard<std::mutex> lock(mutexRegisto);
+        bloco->idThread = proximoIdThread++;
+        blocosAtivos.push_back(bloco);
+    }
+    ~DonoBloco() {
+        std::lock_guard<std::mutex> lock(mutexRegisto);
+        juntarBloco(blocoRetirado, *bloco);
+        for (const auto& e : bloco->eventos) eventosRetirados.push_back({bloco->idThread, e});
+        blocosAtivos.erase(std::remove(blocosAtivos.begin(), blocosAtivos.end(), bloco), blocosAtivos.end());
+        delete bloco;
+    }
+};
+
+static BlocoThread& blocoDaThread() {
+    thread_local DonoBloco dono;
+    return *dono.bloco;
+}
+
+static int indiceBucket(uint64_t ns) {
+    int b = 0;
+    while (ns > 1 && b < NUM_BUCKETS - 1) {
+        ns >>= 1;
+        ++b;
+    }
+    return b;
+}
+
+// ===============================================
+// API PÚBLICA
+// ===============================================
+
+const char* nomeMetrica(Metrica m) {
+    switch (m) {
+        case Metrica::CARREGAR_DADOS: return "carregarDados";
+        case Metrica::GUARDAR_DADOS: return "guardarDados";
+        case Metrica::ENCRIPTAR: return "encriptar";
+        case Metrica::DESENCRIPTAR: return "desencriptar";
+        case Metrica::ENCONTRAR_COLABORADOR: return "encontrarColaborador";
+        case Metrica::VERIFICAR_CONFLITO: return "verificarConflitoFerias";
+        case Metrica::DASHBOARD: return "dashboardResumido";
+        case Metrica::RELATORIO_MENSAL: return "relatorioMensal";
+        case Metrica::ESTATISTICAS_DEPTO: return "estatisticasDepartamento";
+        case Metrica::EXPORTAR_DADOS: return "exportarDados";
+        case Metrica::EXPORTAR_AUSENCIAS_EMPRESA: return "exportarAusenciasEmpresa";
+        case Metrica::EXPORTAR_RELATORIOS_DEPTOS: return "exportarRelatoriosDepartamentos";
+        case Metrica::AUTOSAVE: return "autosave";
+        case Metrica::MAPA_CALOR: return "calcularMapaCalor";
+        case Metrica::PLANEAR_FERIAS: return "planearFerias";
+        case Metrica::DETETAR_DUPLICADOS: return "detetarDuplicados";
+        case Metrica::PADROES_AUSENCIA: return "calcularPadroesAusencia";
+        case Metrica::CONSTRUIR_RANKING: return "construirRanking";
+        case Metrica::VIRAR_ANO: return "virarAno";
+        default: return "?";
+    }
+}
+
+const char* nomeContador(Contador c) {
+    switch (c) {
+        case Contador::COLABORADORES_CARREGADOS: return "colaboradores carregados";
+        case Contador::COLABORADORES_GUARDADOS: return "colaboradores guardados";
+        case Contador::LINHAS_INVALIDAS: return "linhas invalidas no ficheiro";
+        case Contador::CONFLITOS_ENCONTRADOS: return "conflitos de ferias encontrados";
+        case Contador::LINHAS_EXPORTADAS: return "linhas exportadas";
+        case Contador::REGISTOS_AUTOSAVE: return "registos gravados pelo autosave";
+        default: return "?";
+    }
+}
+
+void ativarMetricas(bool ativo) {
+    metricasAtivas.store(ativo, std::memory_order_relaxed);
+}
+
+void ativarTrace(bool ativo) {
+    traceAtivo.store(ativo, std::memory_order_relaxed);
+    if (ativo) ativarMetricas(true);
+}
+
+void registarDuracao(Metrica m, std::chrono::steady_clock::time_point inicio, std::chrono::steady_clock::time_point fim) {
+    BlocoThread& bloco = blocoDaThread();
+    uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(fim - inicio).count());
+
+    EstatisticaMetrica& e = bloco.metricas[static_cast<int>(m)];
+    somarRelaxed(e.chamadas, 1);
+    somarRelaxed(e.totalNs, ns);
+    if (ns < e.minNs.load(std::memory_order_relaxed)) e.minNs.store(ns, std::memory_order_relaxed);
+    if (ns > e.maxNs.load(std::memory_order_relaxed)) e.maxNs.store(ns, std::memory_order_relaxed);
+    somarRelaxed(e.buckets[indiceBucket(ns)], 1);
+
+    if (traceAtivo.load(std::memory_order_relaxed)) {
+        uint64_t inicioNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(inicio - INICIO_PROGRAMA).count());
+        std::lock_guard<std::mutex> lock(bloco.mutexTrace);
+        bloco.eventos.push_back({m, inicioNs, ns});
+    }
+}
+
+void registarContador(Contador c, uint64_t valor) {
+    somarRelaxed(blocoDaThread().contadores[static_cast<int>(c)], valor);
+}
+
+void reiniciarMetricas() {
+    std::lock_guard<std::mutex> lock(mutexRegisto);
+    for (BlocoThread* b : blocosAtivos) limparBloco(*b);
+    limparBloco(blocoRetirado);
+    eventosRetirados.clear();
+}
+
+// Percentil aproximado a partir do histograma (limite superior do bucket)
+static uint64_t percentilHistograma(const EstatisticaMetrica& e, double p) {
+    uint64_t total = e.chamadas.load(std::memory_order_relaxed);
+    if (total == 0) return 0;
+    uint64_t alvo = static_cast<uint64_t>(std::ceil(p * static_cast<double>(total)));
+    if (alvo == 0) alvo = 1;
+    uint64_t acumulado = 0;
+    for (int b = 0; b < NUM_BUCKETS; ++b) {
+        acumulado += e.buckets[b].load(std::memory_order_relaxed);
+        if (acumulado >= alvo) {
+            uint64_t limite = (b >= 63) ? std::numeric_limits<uint64_t>::max() : (uint64_t(1) << (b + 1));
+            return std::min(limite, e.maxNs.load(std::memory_order_relaxed));
+        }
+    }
+    return e.maxNs.load(std::memory_order_relaxed);
+}
+
+void mostrarMetricas() {
+    // Somar os blocos de todas as threads (vivas e terminadas)
+    BlocoThread total;
+    {
+        std::lock_guard<std::mutex> lock(mutexRegisto);
+        juntarBloco(total, blocoRetirado);
+        for (BlocoThread* b : blocosAtivos) juntarBloco(total, *b);
+    }
+
+    std::cout << COR_AZUL << "\n--- Estatisticas de Desempenho ---\n" << RESET_COR;
+    if (!metricasAtivas.load(std::memory_order_relaxed)) {
+        std::cout << COR_AMARELA << "AVISO: A recolha de metricas esta desligada (use --metricas).\n" << RESET_COR;
+    }
+    std::cout << "==========================================================================================\n";
+    std::cout << std::left << std::setw(34) << "Operacao" << std::right
+              << std::setw(10) << "Chamadas" << std::setw(12) << "Total ms" << std::setw(11) << "Media us"
+              << std::setw(11) << "p50 us" << std::setw(11) << "p99 us" << std::setw(11) << "Max us" << "\n";
+    std::cout << "------------------------------------------------------------------------------------------\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (int m = 0; m < NUM_METRICAS; ++m) {
+        const EstatisticaMetrica& e = total.metricas[m];
+        uint64_t chamadas = e.chamadas.load(std::memory_order_relaxed);
+        if (chamadas == 0) continue;
+        double totalNs = static_cast<double>(e.totalNs.load(std::memory_order_relaxed));
+        std::cout << std::left << std::setw(34) << nomeMetrica(static_cast<Metrica>(m)) << std::right
+                  << std::setw(10) << chamadas
+                  << std::setw(12) << totalNs / 1e6
+                  << std::setw(11) << totalNs / static_cast<double>(chamadas) / 1e3
+                  << std::setw(11) << static_cast<double>(percentilHistograma(e, 0.50)) / 1e3
+                  << std::setw(11) << static_cast<double>(percentilHistograma(e, 0.99)) / 1e3
+                  << std::setw(11) << static_cast<double>(e.maxNs.load(std::memory_order_relaxed)) / 1e3 << "\n";
+    }
+    std::cout << "------------------------------------------------------------------------------------------\n";
+    for (int c = 0; c < NUM_CONTADORES; ++c) {
+        uint64_t valor = total.contadores[c].load(std::memory_order_relaxed);
+        if (valor == 0) continue;
+        std::cout << std::left << std::setw(34) << nomeContador(static_cast<Contador>(c)) << std::right << std::setw(10) << valor << "\n";
+    }
+    std::cout << "==========================================================================================\n";
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << "(Percentis aproximados pelo histograma em potencias de 2)\n";
+}
+
+bool exportarTrace(const std::string& nomeFicheiro) {
+    std::vector<std::pair<unsigned, EventoTrace>> eventos;
+    {
+        std::lock_guard<std::mutex> lock(mutexRegisto);
+        eventos = eventosRetirados;
+        for (BlocoThread* b : blocosAtivos) {
+            std::lock_guard<std::mutex> lockTrace(b->mutexTrace);
+            for (const auto& e : b->eventos) eventos.push_back({b->idThread, e});
+        }
+    }
+
+    std::ofstream ficheiro(nomeFicheiro);
+    if (!ficheiro.is_open()) {
+        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel abrir o ficheiro " << nomeFicheiro << " para escrita.\n" << RESET_COR;
+        return false;
+    }
+
+    // Formato "Complete Event" (ph = X) com tempos em microssegundos
+    ficheiro << "{\"traceEvents\":[\n";
+    ficheiro << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < eventos.size(); ++i) {
+        const EventoTrace& e = eventos[i].second;
+        ficheiro << "{\"name\":\"" << nomeMetrica(e.metrica) << "\",\"cat\":\"rh\",\"ph\":\"X\""
+                 << ",\"ts\":" << static_cast<double>(e.inicioNs) / 1e3
+                 << ",\"dur\":" << static_cast<double>(e.duracaoNs) / 1e3
+                 << ",\"pid\":1,\"tid\":" << eventos[i].first << "}"
+                 << (i + 1 < eventos.size() ? ",\n" : "\n");
+    }
+    ficheiro << "],\"displayTimeUnit\":\"ms\"}\n";
+    return true;
+}
@@ -0,0 +1,107 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <string>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+
+// ===============================================
+// INSTRUMENTAÇÃO DOS CAMINHOS CRÍTICOS
+// ===============================================
+// Temporizadores de escopo (RAII), contadores por thread (somados na leitura),
+// histogramas de latência e exportação em formato Chrome Trace (chrome://tracing).
+// Desligado por omissão: cada ponto instrumentado custa apenas a leitura de uma flag.
+// Compilar com -DRH_SEM_METRICAS remove a instrumentação por completo.
+
+// Operações medidas com temporizador
+enum class Metrica {
+    CARREGAR_DADOS,
+    GUARDAR_DADOS,
+    ENCRIPTAR,
+    DESENCRIPTAR,
+    ENCONTRAR_COLABORADOR,
+    VERIFICAR_CONFLITO,
+    DASHBOARD,
+    RELATORIO_MENSAL,
+    ESTATISTICAS_DEPTO,
+    EXPORTAR_DADOS,
+    EXPORTAR_AUSENCIAS_EMPRESA,
+    EXPORTAR_RELATORIOS_DEPTOS,
+    AUTOSAVE,
+    MAPA_CALOR,
+    PLANEAR_FERIAS,
+    DETETAR_DUPLICADOS,
+    PADROES_AUSENCIA,
+    CONSTRUIR_RANKING,
+    VIRAR_ANO,
+    TOTAL // Número de métricas (manter no fim)
+};
+
+// Contadores de eventos simples
+enum class Contador {
+    COLABORADORES_CARREGADOS,
+    COLABORADORES_GUARDADOS,
+    LINHAS_INVALIDAS,
+    CONFLITOS_ENCONTRADOS,
+    LINHAS_EXPORTADAS,
+    REGISTOS_AUTOSAVE,
+    TOTAL // Número de contadores (manter no fim)
+};
+
+// Nome legível de cada métrica/contador
+const char* nomeMetrica(Metrica m);
+const char* nomeContador(Contador c);
+
+// Flags globais (lidas em cada ponto instrumentado)
+extern std::atomic<bool> metricasAtivas;
+extern std::atomic<bool> traceAtivo;
+
+// Liga/desliga a recolha
+void ativarMetricas(bool ativo);
+void ativarTrace(bool ativo); // Também liga as métricas
+
+// Regista uma duração (usado pelo TemporizadorEscopo)
+void registarDuracao(Metrica m, std::chrono::steady_clock::time_point inicio, std::chrono::steady_clock::time_point fim);
+
+// Incrementa um contador da thread atual
+void registarContador(Contador c, uint64_t valor);
+
+// Apaga todos os valores acumulados
+void reiniciarMetricas();
+
+// Mostra a tabela de estatísticas na consola
+void mostrarMetricas();
+
+// Escreve os eventos recolhidos em formato Chrome Trace JSON. Retorna false se falhar.
+bool exportarTrace(const std::string& nomeFicheiro);
+
+// Temporizador de escopo: mede do construtor ao destrutor
+struct TemporizadorEscopo {
+    explicit TemporizadorEscopo(Metrica m) : metrica(m), ativo(metricasAtivas.load(std::memory_order_relaxed)) {
+        if (ativo) inicio = std::chrono::steady_clock::now();
+    }
+    ~TemporizadorEscopo() {
+        if (ativo) registarDuracao(metrica, inicio, std::chrono::steady_clock::now());
+    }
+    TemporizadorEscopo(const TemporizadorEscopo&) = delete;
+    TemporizadorEscopo& operator=(const TemporizadorEscopo&) = delete;
+
+    Metrica metrica;
+    bool ativo;
+    std::chrono::steady_clock::time_point inicio;
+};
+
+#define RH_CONCAT_INTERNO(a, b) a##b
+#define RH_CONCAT(a, b) RH_CONCAT_INTERNO(a, b)
+
+#ifdef RH_SEM_METRICAS
+    #define MEDIR_ESCOPO(metrica) ((void)0)
+    #define CONTAR_EVENTO(contador, valor) ((void)0)
+#else
+    #define MEDIR_ESCOPO(metrica) TemporizadorEscopo RH_CONCAT(temporizador_, __LINE__)(metrica)
+    #define CONTAR_EVENTO(contador, valor) \
+        do { if (metricasAtivas.load(std::memory_order_relaxed)) registarContador(contador, valor); } while (0)
+#endif
+
+#endif // METRICAS_H
@@ -0,0 +1,416 @@
+#include "notas.h"
+#include "calendario.h"
+#include "cores.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <unordered_set>
+#include <cctype>
+#include <chrono>
+#include <limits>
+
+// ===============================================
+// PALAVRAS (MINÚSCULAS E SEM ACENTOS)
+// ===============================================
+
+// Letra sem acento para o segundo byte de um carácter UTF-8 que começa por 0xC3 (À a ÿ); 0 se não for letra
+static char letraSemAcento(unsigned char segundo) {
+    static const char tabela[64] = {
+        'a', 'a', 'a', 'a', 'a', 'a', 'a', 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i', // 0x80 - 0x8F
+        'd', 'n', 'o', 'o', 'o', 'o', 'o', 0,   'o', 'u', 'u', 'u', 'u', 'y', 0,   0,   // 0x90 - 0x9F
+        'a', 'a', 'a', 'a', 'a', 'a', 'a', 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i', // 0xA0 - 0xAF
+        'd', 'n', 'o', 'o', 'o', 'o', 'o', 0,   'o', 'u', 'u', 'u', 'u', 'y', 0,   'y', // 0xB0 - 0xBF
+    };
+    return (segundo >= 0x80 && segundo <= 0xBF) ? tabela[segundo - 0x80] : 0;
+}
+
+std::vector<std::string> dividirPalavras(const std::string& texto) {
+    std::vector<std::string> palavras;
+    std::string atual;
+    auto terminar = [&]() {
+        if (!atual.empty()) palavras.push_back(std::move(atual));
+        atual.clear();
+    };
+
+    for (size_t i = 0; i < texto.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(texto[i]);
+        if (c < 0x80) {
+            if (std::isalnum(c)) {
+                atual += static_cast<char>(std::tolower(c));
+            } else {
+                terminar();
+            }
+        } else if (c == 0xC3 && i + 1 < texto.size() && letraSemAcento(static_cast<unsigned char>(texto[i + 1])) != 0) {
+            atual += letraSemAcento(static_cast<unsigned char>(texto[++i]));
+        } else {
+            // Outros caracteres não ASCII separam palavras (os bytes de continuação são saltados)
+            terminar();
+            while (i + 1 < texto.size() && (static_cast<unsigned char>(texto[i + 1]) & 0xC0) == 0x80) ++i;
+        }
+    }
+    terminar();
+    return palavras;
+}
+
+// ===============================================
+// VARINT
+// ===============================================
+
+static void escreverVarint(std::vector<uint8_t>& bytes, uint32_t valor) {
+    while (valor >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(valor | 0x80));
+        valor >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(valor));
+}
+
+static uint32_t lerVarint(const uint8_t*& p) {
+    uint32_t valor = 0;
+    int deslocamento = 0;
+    while (*p & 0x80) {
+        valor |= static_cast<uint32_t>(*p++ & 0x7F) << deslocamento;
+        deslocamento += 7;
+    }
+    return valor | (static_cast<uint32_t>(*p++) << deslocamento);
+}
+
+static uint64_t chaveNota(int idColaborador, int idNota) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(idColaborador)) << 32) | static_cast<uint32_t>(idNota);
+}
+
+// ===============================================
+// ÍNDICE
+// ===============================================
+
+void IndiceNotas::construir(const std::vector<Colaborador>& lista) {
+    notas.clear();
+    termos.clear();
+    postings.clear();
+    notaPorChave.clear();
+    removidas = 0;
+    for (const auto& colab : lista) {
+        for (const auto& nota : colab.notas) indexar(colab, nota);
+    }
+}
+
+void IndiceNotas::indexar(const Colaborador& colab, const Nota& nota) {
+    const uint64_t chave = chaveNota(colab.id, nota.id_nota);
+    if (notaPorChave.count(chave) != 0) desindexar(colab.id, nota.id_nota);
+
+    const uint32_t n = static_cast<uint32_t>(notas.size());
+    notas.push_back({colab.id, nota.id_nota, dataTextoParaSerial(nota.data_criacao), true});
+    notaPorChave[chave] = n;
+
+    // (palavra, posição) ordenados por palavra: cada palavra recebe uma entrada com todas as posições
+    std::vector<std::pair<uint32_t, uint32_t>> pares;
+    std::vector<std::string> palavras = dividirPalavras(nota.texto);
+    pares.reserve(palavras.size());
+    for (size_t i = 0; i < palavras.size(); ++i) {
+        auto [it, novo] = termos.try_emplace(std::move(palavras[i]), static_cast<uint32_t>(postings.size()));
+        if (novo) postings.emplace_back();
+        pares.push_back({it->second, static_cast<uint32_t>(i)});
+    }
+    std::sort(pares.begin(), pares.end());
+
+    for (size_t i = 0; i < pares.size();) {
+        size_t fim = i;
+        while (fim < pares.size() && pares[fim].first == pares[i].first) ++fim;
+
+        ListaPostings& lista = postings[pares[i].first];
+        escreverVarint(lista.bytes, n - lista.ultimaNota);
+        escreverVarint(lista.bytes, static_cast<uint32_t>(fim - i));
+        uint32_t anterior = 0;
+        for (size_t k = i; k < fim; ++k) {
+            escreverVarint(lista.bytes, pares[k].second - anterior);
+            anterior = pares[k].second;
+        }
+        lista.ultimaNota = n;
+        ++lista.numNotas;
+        i = fim;
+    }
+}
+
+void IndiceNotas::desindexar(int idColaborador, int idNota) {
+    auto it = notaPorChave.find(chaveNota(idColaborador, idNota));
+    if (it == notaPorChave.end()) return;
+    notas[it->second].ativa = false;
+    notaPorChave.erase(it);
+    ++removidas;
+
+    // As listas só encolhem quando a maioria das notas indexadas já foi removida
+    if (removidas >= 1024 && removidas * 2 > notas.size()) compactar();
+}
+
+void IndiceNotas::desindexarColaborador(const Colaborador& colab) {
+    for (const auto& nota : colab.notas) desindexar(colab.id, nota.id_nota);
+}
+
+// Renumera as notas ativas e reescreve as listas sem as removidas
+void IndiceNotas::compactar() {
+    std::vector<uint32_t> novoNumero(notas.size(), std::numeric_limits<uint32_t>::max());
+    std::vector<NotaIndexada> ativasAgora;
+    ativasAgora.reserve(notas.size() - removidas);
+    for (size_t n = 0; n < notas.size(); ++n) {
+        if (!notas[n].ativa) continue;
+        novoNumero[n] = static_cast<uint32_t>(ativasAgora.size());
+        ativasAgora.push_back(notas[n]);
+    }
+
+    for (auto& lista : postings) {
+        ListaPostings nova;
+        const uint8_t* p = lista.bytes.data();
+        const uint8_t* fim = p + lista.bytes.size();
+        uint32_t nota = 0;
+        while (p < fim) {
+            nota += lerVarint(p);
+            uint32_t numPosicoes = lerVarint(p);
+            const uint8_t* inicioPosicoes = p;
+            for (uint32_t k = 0; k < numPosicoes; ++k) lerVarint(p);
+            if (novoNumero[nota] == std::numeric_limits<uint32_t>::max()) continue;
+
+            escreverVarint(nova.bytes, novoNumero[nota] - nova.ultimaNota);
+            escreverVarint(nova.bytes, numPosicoes);
+            nova.bytes.insert(nova.bytes.end(), inicioPosicoes, p); // Posições copiadas tal como estão
+            nova.ultimaNota = novoNumero[nota];
+            ++nova.numNotas;
+        }
+        nova.bytes.shrink_to_fit();
+        lista = std::move(nova);
+    }
+
+    notas = std::move(ativasAgora);
+    for (auto& par : notaPorChave) par.second = novoNumero[par.second];
+    removidas = 0;
+}
+
+size_t IndiceNotas::bytesPostings() const {
+    size_t total = 0;
+    for (const auto& lista : postings) total += lista.bytes.size();
+    return total;
+}
+
+// ===============================================
+// PESQUISA
+// ===============================================
+
+IndiceNotas::Ocorrencias IndiceNotas::ocorrencias(const std::string& palavra, bool comPosicoes) const {
+    Ocorrencias resultado;
+    auto it = termos.find(palavra);
+    if (it == termos.end()) return resultado;
+
+    const ListaPostings& lista = postings[it->second];
+    resultado.notas.reserve(lista.numNotas);
+    if (comPosicoes) resultado.inicio.reserve(lista.numNotas + 1);
+    const uint8_t* p = lista.bytes.data();
+    const uint8_t* fim = p + lista.bytes.size();
+    uint32_t nota = 0;
+    while (p < fim) {
+        nota += lerVarint(p);
+        uint32_t numPosicoes = lerVarint(p);
+        resultado.notas.push_back(nota);
+        if (comPosicoes) resultado.inicio.push_back(static_cast<uint32_t>(resultado.posicoes.size()));
+        uint32_t posicao = 0;
+        for (uint32_t k = 0; k < numPosicoes; ++k) {
+            posicao += lerVarint(p);
+            if (comPosicoes) resultado.posicoes.push_back(posicao);
+        }
+    }
+    if (comPosicoes) resultado.inicio.push_back(static_cast<uint32_t>(resultado.posicoes.size()));
+    return resultado;
+}
+
+// Notas onde as palavras aparecem seguidas, por esta ordem
+std::vector<uint32_t> IndiceNotas::notasDaFrase(const std::vector<std::string>& palavras) const {
+    std::vector<Ocorrencias> listas;
+    for (const auto& palavra : palavras) {
+        listas.push_back(ocorrencias(palavra, true));
+        if (listas.back().notas.empty()) return {};
+    }
+
+    std::vector<uint32_t> resultado;
+    std::vector<size_t> cursor(listas.size(), 0);
+    for (size_t i = 0; i < listas[0].notas.size(); ++i) {
+        const uint32_t nota = listas[0].notas[i];
+        // Avançar as outras listas até à mesma nota
+        bool emTodas = true;
+        for (size_t k = 1; k < listas.size() && emTodas; ++k) {
+            const auto& notas = listas[k].notas;
+            while (cursor[k] < notas.size() && notas[cursor[k]] < nota) ++cursor[k];
+            emTodas = cursor[k] < notas.size() && notas[cursor[k]] == nota;
+        }
+        if (!emTodas) continue;
+
+        for (uint32_t j = listas[0].inicio[i]; j < listas[0].inicio[i + 1]; ++j) {
+            const uint32_t inicio = listas[0].posicoes[j];
+            bool seguida = true;
+            for (size_t k = 1; k < listas.size() && seguida; ++k) {
+                auto primeira = listas[k].posicoes.begin() + listas[k].inicio[cursor[k]];
+                auto ultima = listas[k].posicoes.begin() + listas[k].inicio[cursor[k] + 1];
+                seguida = std::binary_search(primeira, ultima, inicio + static_cast<uint32_t>(k));
+            }
+            if (seguida) {
+                resultado.push_back(nota);
+                break;
+            }
+        }
+    }
+    return resultado;
+}
+
+ResultadoPesquisaNotas IndiceNotas::pesquisar(const std::string& consulta, int dataInicio, int dataFim) const {
+    // Separar a consulta em alternativas (OU), cada uma com uma lista de frases (uma palavra = frase de 1)
+    std::vector<std::vector<std::vector<std::string>>> alternativas(1);
+    std::string fragmento;
+    bool entreAspas = false;
+    auto fecharFragmento = [&]() {
+        std::vector<std::string> palavras = dividirPalavras(fragmento);
+        fragmento.clear();
+        if (palavras.empty()) return;
+        if (!entreAspas && palavras.size() == 1 && (palavras[0] == "ou" || palavras[0] == "or")) {
+            if (!alternativas.back().empty()) alternativas.emplace_back();
+            return;
+        }
+        alternativas.back().push_back(std::move(palavras));
+    };
+    for (char c : consulta) {
+        if (c == '"') {
+            fecharFragmento();
+            entreAspas = !entreAspas;
+        } else if (!entreAspas && std::isspace(static_cast<unsigned char>(c))) {
+            fecharFragmento();
+        } else {
+            fragmento += c;
+        }
+    }
+    fecharFragmento();
+
+    ResultadoPesquisaNotas resultado;
+    for (const auto& frases : alternativas) {
+        if (frases.empty()) continue;
+
+        std::vector<std::vector<uint32_t>> conjuntos;
+        for (const auto& frase : frases) {
+            std::vector<uint32_t> conjunto;
+            if (frase.size() == 1) {
+                conjunto = ocorrencias(frase[0], false).notas;
+            } else {
+                conjunto = notasDaFrase(frase);
+            }
+            conjuntos.push_back(std::move(conjunto));
+        }
+        // Intersetar a partir do conjunto mais pequeno
+        std::sort(conjuntos.begin(), conjuntos.end(), [](const auto& a, const auto& b) { return a.size() < b.size(); });
+        std::vector<uint32_t> intersecao = std::move(conjuntos[0]);
+        for (size_t k = 1; k < conjuntos.size() && !intersecao.empty(); ++k) {
+            std::vector<uint32_t> proxima;
+            std::set_intersection(intersecao.begin(), intersecao.end(), conjuntos[k].begin(), conjuntos[k].end(),
+                                  std::back_inserter(proxima));
+            intersecao = std::move(proxima);
+        }
+
+        std::vector<uint32_t> uniao;
+        std::set_union(resultado.notas.begin(), resultado.notas.end(), intersecao.begin(), intersecao.end(),
+                       std::back_inserter(uniao));
+        resultado.notas = std::move(uniao);
+    }
+
+    resultado.candidatas = resultado.notas.size();
+    resultado.notas.erase(std::remove_if(resultado.notas.begin(), resultado.notas.end(), [&](uint32_t n) {
+        return !notas[n].ativa || notas[n].data < dataInicio || notas[n].data > dataFim;
+    }), resultado.notas.end());
+    return resultado;
+}
+
+// ===============================================
+// GANCHOS DO CRUD
+// ===============================================
+
+static IndiceNotas* indiceAtivo = nullptr;
+
+void ativarIndiceNotas(IndiceNotas* indice) {
+    indiceAtivo = indice;
+}
+
+void indexarNota(const Colaborador& colab, const Nota& nota) {
+    if (indiceAtivo != nullptr) indiceAtivo->indexar(colab, nota);
+}
+
+void desindexarNota(const Colaborador& colab, int idNota) {
+    if (indiceAtivo != nullptr) indiceAtivo->desindexar(colab.id, idNota);
+}
+
+void desindexarColaborador(const Colaborador& colab) {
+    if (indiceAtivo != nullptr) indiceAtivo->desindexarColaborador(colab);
+}
+
+// ===============================================
+// MENU
+// ===============================================
+
+// Número máximo de notas mostradas por pesquisa
+static const size_t MAX_NOTAS_MOSTRADAS = 20;
+
+// Lê uma data opcional (ENTER = sem limite). Retorna false se a data for inválida.
+static bool pedirDataOpcional(const std::string& pergunta, int semLimite, int& serial) {
+    std::string texto;
+    std::cout << pergunta;
+    std::getline(std::cin, texto);
+    if (texto.empty()) {
+        serial = semLimite;
+        return true;
+    }
+    serial = dataTextoParaSerial(texto);
+    if (serial != SERIAL_INVALIDO) return true;
+    std::cout << COR_VERMELHA << "ERRO: Data invalida (use dd/mm/aaaa).\n" << RESET_COR;
+    return false;
+}
+
+void menuPesquisaNotas(const IndiceNotas& indice, const std::vector<Colaborador>& lista) {
+    std::cout << COR_AZUL << "\n--- Pesquisar Notas Internas ---\n" << RESET_COR;
+    std::cout << indice.ativas() << " notas indexadas, " << indice.palavras() << " palavras diferentes ("
+              << indice.bytesPostings() / 1024 << " KB de listas).\n";
+    std::cout << "Palavras separadas por espacos = todas; OU = alternativa; \"texto entre aspas\" = frase.\n";
+
+    std::string consulta;
+    std::cout << "Pesquisa: ";
+    std::getline(std::cin, consulta);
+    int dataInicio = 0, dataFim = 0;
+    if (!pedirDataOpcional("Criadas desde (dd/mm/aaaa, ENTER = sem limite): ", SERIAL_INVALIDO, dataInicio)) return;
+    if (!pedirDataOpcional("Criadas ate (dd/mm/aaaa, ENTER = sem limite): ", 1 << 30, dataFim)) return;
+
+    auto inicio = std::chrono::steady_clock::now();
+    ResultadoPesquisaNotas resultado = indice.pesquisar(consulta, dataInicio, dataFim);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+
+    if (resultado.notas.empty()) {
+        std::cout << COR_AMARELA << "Nenhuma nota encontrada.\n" << RESET_COR;
+        return;
+    }
+
+    // Colaboradores das notas a mostrar (uma passagem pela lista)
+    std::unordered_set<int> ids;
+    for (size_t i = 0; i < resultado.notas.size() && i < MAX_NOTAS_MOSTRADAS; ++i) ids.insert(indice.notas[resultado.notas[i]].idColaborador);
+    std::unordered_map<int, const Colaborador*> colaboradores;
+    for (const auto& colab : lista) {
+        if (ids.count(colab.id) != 0) colaboradores[colab.id] = &colab;
+    }
+
+    std::cout << COR_CIANO << std::left << std::setw(7) << "ID" << std::setw(24) << "Nome" << std::setw(6) << "Nota"
+              << std::setw(12) << "Criada" << "Texto" << RESET_COR << "\n";
+    for (size_t i = 0; i < resultado.notas.size() && i < MAX_NOTAS_MOSTRADAS; ++i) {
+        const NotaIndexada& indexada = indice.notas[resultado.notas[i]];
+        auto it = colaboradores.find(indexada.idColaborador);
+        if (it == colaboradores.end()) continue;
+        const Colaborador& colab = *it->second;
+        auto nota = std::find_if(colab.notas.begin(), colab.notas.end(), [&](const Nota& n) { return n.id_nota == indexada.idNota; });
+        if (nota == colab.notas.end()) continue;
+        std::string texto = nota->texto.size() > 60 ? nota->texto.substr(0, 57) + "..." : nota->texto;
+        std::cout << std::left << std::setw(7) << colab.id << std::setw(24) << colab.nome.substr(0, 23) << std::setw(6)
+                  << nota->id_nota << std::setw(12) << nota->data_criacao << texto << "\n";
+    }
+    if (resultado.notas.size() > MAX_NOTAS_MOSTRADAS) {
+        std::cout << "... e mais " << resultado.notas.size() - MAX_NOTAS_MOSTRADAS << " notas.\n";
+    }
+    std::cout << COR_VERDE << resultado.notas.size() << " notas encontradas em " << std::fixed << std::setprecision(2) << ms
+              << " ms.\n" << RESET_COR << std::defaultfloat << std::setprecision(6);
+}
@@ -0,0 +1,87 @@
+#ifndef NOTAS_H
+#define NOTAS_H
+
+#include "colaborador.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// ===============================================
+// PESQUISA DE TEXTO NAS NOTAS INTERNAS
+// ===============================================
+// Índice invertido sobre Nota::texto de todos os colaboradores:
+//   - o texto é dividido em palavras (letras e dígitos), em minúsculas e sem acentos
+//     ("Formação" e "formacao" são a mesma palavra);
+//   - cada palavra tem uma lista de (nota, posições) com os números guardados como diferenças
+//     em varint (1 byte para valores < 128), acrescentada no fim a cada nota nova;
+//   - editar uma nota marca a versão antiga como removida e indexa a nova; quando as removidas
+//     passam a ser a maioria, as listas são compactadas.
+// O CRUD de notas (colaborador.cpp) atualiza o índice ativo através de indexarNota/desindexarNota.
+//
+// Consultas: palavras separadas por espaços têm de aparecer todas (E); "OU" separa alternativas;
+// texto entre aspas tem de aparecer seguido (frase). Ex: ferias "fim de ano" OU baixa medica
+
+// Palavras do texto, em minúsculas e sem acentos
+std::vector<std::string> dividirPalavras(const std::string& texto);
+
+struct NotaIndexada {
+    int idColaborador = 0;
+    int idNota = 0;
+    int data = 0;       // data_criacao em série (SERIAL_INVALIDO se não for dd/mm/aaaa)
+    bool ativa = true;  // false depois de editada/removida
+};
+
+struct ResultadoPesquisaNotas {
+    std::vector<uint32_t> notas; // Índices em IndiceNotas::notas, por ordem de indexação
+    size_t candidatas = 0;       // Notas que tinham as palavras (antes do filtro de frases/datas)
+};
+
+struct IndiceNotas {
+    std::vector<NotaIndexada> notas;
+
+    void construir(const std::vector<Colaborador>& lista);
+    void indexar(const Colaborador& colab, const Nota& nota);
+    void desindexar(int idColaborador, int idNota);
+    void desindexarColaborador(const Colaborador& colab);
+
+    // Notas ativas com data em [dataInicio, dataFim] (séries) que satisfazem a consulta
+    ResultadoPesquisaNotas pesquisar(const std::string& consulta, int dataInicio = SERIAL_INVALIDO, int dataFim = 1 << 30) const;
+
+    size_t ativas() const { return notas.size() - removidas; }
+    size_t palavras() const { return termos.size(); }
+    size_t bytesPostings() const;
+
+private:
+    struct ListaPostings {
+        std::vector<uint8_t> bytes; // (Δnota, nº posições, Δposição...) em varint
+        uint32_t ultimaNota = 0;
+        uint32_t numNotas = 0;
+    };
+    // Notas de uma palavra; as posições da nota i estão em posicoes[inicio[i], inicio[i + 1])
+    struct Ocorrencias {
+        std::vector<uint32_t> notas;
+        std::vector<uint32_t> inicio;
+        std::vector<uint32_t> posicoes;
+    };
+
+    std::unordered_map<std::string, uint32_t> termos;
+    std::vector<ListaPostings> postings;
+    std::unordered_map<uint64_t, uint32_t> notaPorChave; // (idColaborador, idNota) -> nota ativa
+    size_t removidas = 0;
+
+    Ocorrencias ocorrencias(const std::string& palavra, bool comPosicoes) const;
+    std::vector<uint32_t> notasDaFrase(const std::vector<std::string>& palavras) const;
+    void compactar();
+};
+
+// Ganchos do CRUD de notas: atualizam o índice ativo (se houver)
+void ativarIndiceNotas(IndiceNotas* indice);
+void indexarNota(const Colaborador& colab, const Nota& nota);
+void desindexarNota(const Colaborador& colab, int idNota);
+void desindexarColaborador(const Colaborador& colab);
+
+// Opção do menu: pede a consulta e o intervalo de datas e mostra as notas encontradas
+void menuPesquisaNotas(const IndiceNotas& indice, const std::vector<Colaborador>& lista);
+
+#endif // NOTAS_H
@@ -0,0 +1,243 @@
+#include "padroes.h"
+#include "calendario.h"
+#include "arquivo.h"
+#include "io.h"
+#include "paralelo.h"
+#include "cores.h"
+#include "metricas.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+#include <cmath>
+
+// ===============================================
+// MÁSCARAS DO ANO
+// ===============================================
+
+struct MascarasAno {
+    DiasAno naoUteis;      // Fins de semana e feriados (só dias que existem)
+    DiasAno segundas;
+    DiasAno sextas;
+    DiasAno juntoDescanso; // Dias úteis com um dia não útil antes ou depois
+};
+
+static MascarasAno mascarasDoAno(int ano, const DiasAno& naoUteis) {
+    MascarasAno m;
+    DiasAno validos;
+    int semana = diaSemana(1, 1, ano);
+    for (int d = 1; d <= 366; ++d, semana = (semana + 1) % 7) {
+        int dia = 0, mes = 0;
+        if (!diaDoAnoParaData(d, ano, dia, mes)) break;
+        validos.set(static_cast<size_t>(d));
+        if (semana == 1) m.segundas.set(static_cast<size_t>(d));
+        if (semana == 5) m.sextas.set(static_cast<size_t>(d));
+    }
+    m.naoUteis = naoUteis & validos;
+    m.juntoDescanso = ((m.naoUteis << 1) | (m.naoUteis >> 1)) & validos & ~m.naoUteis;
+    return m;
+}
+
+// Dias com falta que continuam um episódio: o dia anterior, ou o último dia útil antes de uma
+// sequência de dias não úteis, também tem falta
+static DiasAno continuacoes(const DiasAno& faltas, const DiasAno& naoUteis) {
+    DiasAno ligados = faltas << 1;
+    // Cada volta atravessa mais um dia não útil (a Páscoa ou o Natal juntam poucos dias seguidos)
+    for (int volta = 0; volta < 16; ++volta) {
+        DiasAno seguinte = ligados | ((ligados & naoUteis) << 1);
+        if (seguinte == ligados) break;
+        ligados = seguinte;
+    }
+    return ligados;
+}
+
+static void avaliar(PadraoAusencia& padrao, const DiasAno& faltas, const MascarasAno& m) {
+    const DiasAno inicios = faltas & ~continuacoes(faltas, m.naoUteis);
+    padrao.episodios = static_cast<int>(inicios.count());
+    padrao.dias = static_cast<int>(faltas.count());
+    padrao.bradford = static_cast<long long>(padrao.episodios) * padrao.episodios * padrao.dias;
+    padrao.segundas = static_cast<int>((faltas & m.segundas).count());
+    padrao.sextas = static_cast<int>((faltas & m.sextas).count());
+    padrao.juntoDescanso = static_cast<int>((faltas & m.juntoDescanso).count());
+}
+
+// ===============================================
+// CÁLCULO
+// ===============================================
+
+std::vector<PadraoAusencia> calcularPadroesAusencia(const std::vector<Colaborador>& lista, int ano, const DiasAno& naoUteis) {
+    MEDIR_ESCOPO(Metrica::PADROES_AUSENCIA);
+    const MascarasAno mascaras = mascarasDoAno(ano, naoUteis);
+    // Só um ano fechado com arquivo precisa de o consultar; caso contrário usa-se o calendário em memória
+    const bool usarArquivo = ano < obterAnoAtual() && anoArquivado(ano);
+
+    std::vector<PadraoAusencia> todos(lista.size());
+    std::vector<char> comFaltas(lista.size(), 0);
+    executarBlocos(lista.size(), [&](size_t inicio, size_t fim, unsigned) {
+        std::map<int, TipoMarcacao> arquivado;
+        for (size_t i = inicio; i < fim; ++i) {
+            const auto& calendario = usarArquivo ? calendarioDoAno(lista[i], ano, arquivado) : lista[i].calendario;
+            DiasAno faltas;
+            for (const auto& par : calendario) {
+                if (temTipo(MASCARA_IMPREVISTA, par.second) && par.first >= 1 && par.first <= 366) faltas.set(static_cast<size_t>(par.first));
+            }
+            if (faltas.none()) continue;
+            todos[i].posicao = static_cast<uint32_t>(i);
+            avaliar(todos[i], faltas, mascaras);
+            comFaltas[i] = 1;
+        }
+    });
+
+    std::vector<PadraoAusencia> padroes;
+    for (size_t i = 0; i < todos.size(); ++i) {
+        if (comFaltas[i]) padroes.push_back(todos[i]);
+    }
+    return padroes;
+}
+
+std::vector<PadraoAusencia> topPadroes(std::vector<PadraoAusencia> padroes, size_t k, CriterioPadrao criterio) {
+    if (criterio == CriterioPadrao::JUNTO_DESCANSO) {
+        padroes.erase(std::remove_if(padroes.begin(), padroes.end(),
+                                     [](const PadraoAusencia& p) { return p.dias < MIN_DIAS_JUNTO_DESCANSO; }),
+                      padroes.end());
+    }
+
+    auto primeiro = [criterio](const PadraoAusencia& a, const PadraoAusencia& b) {
+        switch (criterio) {
+            case CriterioPadrao::BRADFORD:
+                if (a.bradford != b.bradford) return a.bradford > b.bradford;
+                break;
+            case CriterioPadrao::EPISODIOS:
+                if (a.episodios != b.episodios) return a.episodios > b.episodios;
+                break;
+            case CriterioPadrao::JUNTO_DESCANSO: {
+                // Compara juntoA/diasA com juntoB/diasB sem divisões
+                long long esquerda = static_cast<long long>(a.juntoDescanso) * b.dias;
+                long long direita = static_cast<long long>(b.juntoDescanso) * a.dias;
+                if (esquerda != direita) return esquerda > direita;
+                break;
+            }
+        }
+        if (a.dias != b.dias) return a.dias > b.dias;
+        return a.posicao < b.posicao;
+    };
+
+    if (k < padroes.size()) {
+        std::nth_element(padroes.begin(), padroes.begin() + static_cast<long>(k), padroes.end(), primeiro);
+        padroes.resize(k);
+    }
+    std::sort(padroes.begin(), padroes.end(), primeiro);
+    return padroes;
+}
+
+bool exportarPadroesCSV(const std::vector<PadraoAusencia>& padroes, const std::vector<Colaborador>& lista,
+                        const std::string& nomeFicheiro) {
+    BufferEscrita saida(nomeFicheiro);
+    if (!saida.aberto()) return false;
+
+    saida.escrever("ID,Nome,Departamento,Episodios,Dias,Bradford,Segundas,Sextas,Junto_Descanso\n");
+    for (const auto& p : padroes) {
+        const Colaborador& colab = lista[p.posicao];
+        saida.escreverInt(colab.id);
+        saida.escreverChar(',');
+        saida.escrever(colab.nome);
+        saida.escreverChar(',');
+        saida.escrever(colab.departamento);
+        saida.escreverChar(',');
+        saida.escreverInt(p.episodios);
+        saida.escreverChar(',');
+        saida.escreverInt(p.dias);
+        saida.escreverChar(',');
+        saida.escreverInt(p.bradford);
+        saida.escreverChar(',');
+        saida.escreverInt(p.segundas);
+        saida.escreverChar(',');
+        saida.escreverInt(p.sextas);
+        saida.escreverChar(',');
+        saida.escreverInt(p.juntoDescanso);
+        saida.escreverChar('\n');
+    }
+    return true;
+}
+
+// ===============================================
+// MENU
+// ===============================================
+
+// Pede um inteiro; ENTER mantém 'valor'
+static bool lerInteiroOpcional(const std::string& pergunta, int& valor) {
+    std::string texto;
+    std::cout << pergunta;
+    std::getline(std::cin, texto);
+    if (texto.empty()) return true;
+    try {
+        valor = std::stoi(texto);
+    } catch (const std::exception&) {
+        std::cout << COR_VERMELHA << "ERRO: Valor invalido.\n" << RESET_COR;
+        return false;
+    }
+    return true;
+}
+
+static void mostrarPadroes(const std::vector<PadraoAusencia>& top, const std::vector<Colaborador>& lista) {
+    std::cout << COR_CIANO << std::left << std::setw(7) << "ID" << std::setw(24) << "Nome" << std::setw(16) << "Departamento"
+              << std::right << std::setw(6) << "Epis." << std::setw(6) << "Dias" << std::setw(10) << "Bradford"
+              << std::setw(5) << "Seg" << std::setw(5) << "Sex" << std::setw(9) << "Junto FS" << RESET_COR << "\n";
+    for (const auto& p : top) {
+        const Colaborador& colab = lista[p.posicao];
+        // Limiares habituais do fator de Bradford: 51 (atenção) e 201 (intervenção)
+        const std::string& cor = p.bradford > 200 ? COR_VERMELHA : (p.bradford > 50 ? COR_AMARELA : RESET_COR);
+        std::cout << std::left << std::setw(7) << colab.id << std::setw(24) << colab.nome.substr(0, 23)
+                  << std::setw(16) << colab.departamento.substr(0, 15) << std::right << std::setw(6) << p.episodios
+                  << std::setw(6) << p.dias << cor << std::setw(10) << p.bradford << RESET_COR << std::setw(5) << p.segundas
+                  << std::setw(5) << p.sextas << std::setw(8)
+                  << std::lround(p.proporcaoJuntoDescanso() * 100.0) << "%\n";
+    }
+}
+
+void relatorioPadroesAusencia(const std::vector<Colaborador>& lista) {
+    std::cout << COR_AZUL << "\n--- Padroes de Ausencia (Fator de Bradford) ---\n" << RESET_COR;
+    int ano = obterAnoAtual();
+    if (!lerInteiroOpcional("Ano (ENTER = " + std::to_string(ano) + "): ", ano)) return;
+
+    std::cout << "Criterio: 1. Fator de Bradford  2. Episodios  3. Faltas junto ao fim de semana/feriado\n";
+    int criterio = 1;
+    if (!lerInteiroOpcional("Opcao (ENTER = 1): ", criterio)) return;
+    if (criterio < 1 || criterio > 3) {
+        std::cout << COR_VERMELHA << "Opcao invalida.\n" << RESET_COR;
+        return;
+    }
+    int k = 10;
+    if (!lerInteiroOpcional("Quantos colaboradores mostrar (ENTER = 10): ", k)) return;
+    if (k < 1) {
+        std::cout << COR_VERMELHA << "ERRO: O numero tem de ser positivo.\n" << RESET_COR;
+        return;
+    }
+
+    std::vector<PadraoAusencia> padroes = calcularPadroesAusencia(lista, ano, diasNaoUteis(ano, FICHEIRO_FERIADOS));
+    if (padroes.empty()) {
+        std::cout << COR_VERDE << "Nenhuma falta registada em " << ano << ".\n" << RESET_COR;
+        return;
+    }
+    std::cout << padroes.size() << " colaboradores com faltas em " << ano << ".\n";
+    if (criterio == 3) std::cout << "(So colaboradores com " << MIN_DIAS_JUNTO_DESCANSO << " ou mais faltas)\n";
+
+    std::vector<PadraoAusencia> top = topPadroes(padroes, static_cast<size_t>(k), static_cast<CriterioPadrao>(criterio - 1));
+    if (top.empty()) {
+        std::cout << "Nenhum colaborador cumpre o criterio.\n";
+    } else {
+        mostrarPadroes(top, lista);
+    }
+
+    std::string texto;
+    std::cout << COR_AZUL << "Exportar todos para CSV? (S/N): " << RESET_COR;
+    std::getline(std::cin, texto);
+    if (texto.empty() || (texto[0] != 'S' && texto[0] != 's')) return;
+
+    const std::string nomeFicheiro = "padroes_ausencia_" + std::to_string(ano) + ".csv";
+    if (exportarPadroesCSV(padroes, lista, nomeFicheiro)) {
+        std::cout << COR_VERDE << padroes.size() << " colaboradores exportados para " << nomeFicheiro << "\n" << RESET_COR;
+    } else {
+        std::cout << COR_VERMELHA << "ERRO: Nao foi possivel abrir o ficheiro " << nomeFicheiro << " para escrita.\n" << RESET_COR;
+    }
+}
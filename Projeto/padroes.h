@@ -0,0 +1,59 @@
+#ifndef PADROES_H
+#define PADROES_H
+
+#include "colaborador.h"
+#include "planeador.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// ===============================================
+// PADRÕES DE AUSÊNCIA (FATOR DE BRADFORD)
+// ===============================================
+// Para cada colaborador, num ano, conta as ausências imprevistas (faltas e baixas; as férias e as
+// licenças são planeadas):
+//  - episódios (S): períodos seguidos de falta. Um fim de semana ou feriado no meio não
+//    separa o período (falta na sexta e na segunda seguinte = 1 episódio de 2 dias);
+//  - dias (D) e fator de Bradford S² x D, que pesa mais as faltas curtas e frequentes;
+//  - faltas à segunda, à sexta e num dia útil junto a um fim de semana ou feriado.
+//
+// O calendário de cada colaborador é convertido num DiasAno (um bit por dia) e as contagens são
+// deslocamentos, ANDs e contagens de bits contra máscaras do ano calculadas uma vez, em vez de
+// percorrer o calendário dia a dia. A passagem é paralela e o top-K usa seleção parcial
+// (nth_element + ordenação só dos K escolhidos).
+
+struct PadraoAusencia {
+    uint32_t posicao = 0; // Índice na lista
+    int episodios = 0;
+    int dias = 0;
+    long long bradford = 0;
+    int segundas = 0;
+    int sextas = 0;
+    int juntoDescanso = 0; // Dias úteis com falta ao lado de um fim de semana ou feriado
+
+    double proporcaoJuntoDescanso() const { return dias > 0 ? static_cast<double>(juntoDescanso) / dias : 0.0; }
+};
+
+enum class CriterioPadrao {
+    BRADFORD,
+    EPISODIOS,
+    JUNTO_DESCANSO // Proporção das faltas junto ao descanso (só com MIN_DIAS_JUNTO_DESCANSO faltas)
+};
+
+const int MIN_DIAS_JUNTO_DESCANSO = 3; // Abaixo disto a proporção não diz nada
+
+// Um padrão por colaborador com faltas no ano, pela ordem da lista. Para um ano arquivado, os
+// calendários vêm do arquivo desse ano (ver calendarioDoAno).
+std::vector<PadraoAusencia> calcularPadroesAusencia(const std::vector<Colaborador>& lista, int ano, const DiasAno& naoUteis);
+
+// Os K maiores pelo critério (empate: mais dias, depois posição), por ordem decrescente
+std::vector<PadraoAusencia> topPadroes(std::vector<PadraoAusencia> padroes, size_t k, CriterioPadrao criterio);
+
+// CSV com uma linha por colaborador com faltas: ID,Nome,Departamento,Episodios,Dias,Bradford,Segundas,Sextas,Junto_Descanso
+bool exportarPadroesCSV(const std::vector<PadraoAusencia>& padroes, const std::vector<Colaborador>& lista,
+                        const std::string& nomeFicheiro);
+
+// Opção do menu: pede o ano, o critério e K, mostra o top-K e oferece a exportação
+void relatorioPadroesAusencia(const std::vector<Colaborador>& lista);
+
+#endif // PADROES_H
@@ -0,0 +1,56 @@
+#include "paralelo.h"
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+// Número de threads de trabalho a usar
+unsigned numeroThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// Executa as tarefas num pool de threads com distribuição dinâmica
+void executarParalelo(size_t numTarefas, const std::function<void(size_t)>& tarefa) {
+    if (numTarefas == 0) return;
+
+    unsigned nThreads = static_cast<unsigned>(std::min<size_t>(numeroThreads(), numTarefas));
+    if (nThreads <= 1) {
+        for (size_t i = 0; i < numTarefas; ++i) tarefa(i);
+        return;
+    }
+
+    std::atomic<size_t> proximo(0);
+    auto trabalhador = [&]() {
+        for (size_t i = proximo++; i < numTarefas; i = proximo++) {
+            tarefa(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(nThreads - 1);
+    for (unsigned t = 1; t < nThreads; ++t) {
+        pool.emplace_back(trabalhador);
+    }
+    trabalhador(); // A thread atual também trabalha
+    for (auto& th : pool) th.join();
+}
+
+// Divide [0, total) em blocos contíguos, um por thread
+void executarBlocos(size_t total, const std::function<void(size_t, size_t, unsigned)>& bloco) {
+    if (total == 0) return;
+
+    unsigned nThreads = static_cast<unsigned>(std::min<size_t>(numeroThreads(), total));
+    size_t tamanho = (total + nThreads - 1) / nThreads;
+
+    std::vector<std::thread> pool;
+    pool.reserve(nThreads);
+    for (unsigned t = 1; t < nThreads; ++t) {
+        size_t inicio = t * tamanho;
+        size_t fim = std::min(total, inicio + tamanho);
+        if (inicio >= fim) break;
+        pool.emplace_back(bloco, inicio, fim, t);
+    }
+    bloco(0, std::min(total, tamanho), 0);
+    for (auto& th : pool) th.join();
+}
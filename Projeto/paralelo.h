@@ -0,0 +1,20 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <cstddef>
+#include <functional>
+
+// --- Execução Paralela (pool de threads simples) ---
+
+// Número de threads de trabalho a usar (núcleos disponíveis, mínimo 1)
+unsigned numeroThreads();
+
+// Executa tarefa(i) para i em [0, numTarefas). As threads do pool vão buscando
+// o próximo índice livre, por isso tarefas de tamanho diferente ficam equilibradas.
+void executarParalelo(size_t numTarefas, const std::function<void(size_t)>& tarefa);
+
+// Divide [0, total) em blocos contíguos, um por thread.
+// bloco(inicio, fim, indiceThread) - indiceThread permite usar acumuladores parciais por thread.
+void executarBlocos(size_t total, const std::function<void(size_t, size_t, unsigned)>& bloco);
+
+#endif // PARALELO_H
@@ -0,0 +1,580 @@
+#include "planeador.h"
+#include "calendario.h"
+#include "io.h"
+#include "paralelo.h"
+#include "cores.h"
+#include "metricas.h"
+#include "ranking.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <unordered_map>
+
+const std::string FICHEIRO_FERIADOS = "rh_feriados.txt";
+const std::string FICHEIRO_PEDIDOS_FERIAS = "pedidos_ferias.txt";
+
+// Número máximo de passagens da pesquisa local por departamento
+static const int RONDAS_PESQUISA_LOCAL = 20;
+
+static bool eAusencia(TipoMarcacao tipo) {
+    return temTipo(MASCARA_AUSENCIA, tipo);
+}
+
+// "dd/mm" -> dia do ano (0 se a data for inválida)
+static int lerDiaMes(const std::string& texto, int ano) {
+    size_t barra = texto.find('/');
+    if (barra == std::string::npos) return 0;
+    try {
+        int dia = std::stoi(texto.substr(0, barra));
+        int mes = std::stoi(texto.substr(barra + 1));
+        return dataValida(dia, mes, ano) ? dataParaDiaDoAno(dia, mes, ano) : 0;
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+static std::string textoDiaMes(int diaDoAno, int ano) {
+    int dia = 0, mes = 0;
+    diaDoAnoParaData(diaDoAno, ano, dia, mes);
+    std::ostringstream texto;
+    texto << std::setw(2) << std::setfill('0') << dia << "/" << std::setw(2) << mes;
+    return texto.str();
+}
+
+// Dias do pedido que passariam a férias: úteis e ainda sem ausência no calendário
+static DiasAno diasNovos(const Colaborador& colab, const PedidoFerias& pedido, const DiasAno& naoUteis) {
+    DiasAno dias;
+    for (int d = pedido.inicio; d <= pedido.fim; ++d) {
+        if (naoUteis.test(static_cast<size_t>(d))) continue;
+        auto it = colab.calendario.find(d);
+        if (it != colab.calendario.end() && eAusencia(it->second)) continue;
+        dias.set(static_cast<size_t>(d));
+    }
+    return dias;
+}
+
+// ===============================================
+// LEITURA
+// ===============================================
+
+DiasAno diasNaoUteis(int ano, const std::string& nomeFicheiro) {
+    DiasAno naoUteis;
+    naoUteis.set(0);
+    for (int d = 1; d <= 366; ++d) {
+        int dia = 0, mes = 0;
+        if (!diaDoAnoParaData(d, ano, dia, mes)) {
+            naoUteis.set(static_cast<size_t>(d)); // 366 num ano comum
+            continue;
+        }
+        int semana = diaSemana(dia, mes, ano);
+        if (semana == 0 || semana == 6) naoUteis.set(static_cast<size_t>(d));
+    }
+
+    std::ifstream ficheiro(nomeFicheiro);
+    std::string linha;
+    while (std::getline(ficheiro, linha)) {
+        if (linha.empty() || linha[0] == '#') continue;
+        int d = lerDiaMes(linha, ano);
+        if (d == 0) {
+            std::cerr << COR_AMARELA << "[AVISO] Feriado invalido ignorado: " << linha << "\n" << RESET_COR;
+            continue;
+        }
+        naoUteis.set(static_cast<size_t>(d));
+    }
+    return naoUteis;
+}
+
+bool lerPedidosFerias(const std::string& nomeFicheiro, int ano, std::vector<PedidoFerias>& pedidos) {
+    std::ifstream ficheiro(nomeFicheiro);
+    if (!ficheiro.is_open()) return false;
+
+    pedidos.clear();
+    std::string linha;
+    int numeroLinha = 0;
+    while (std::getline(ficheiro, linha)) {
+        ++numeroLinha;
+        if (linha.empty() || linha[0] == '#') continue;
+
+        std::vector<std::string> campos;
+        std::stringstream ss(linha);
+        std::string campo;
+        while (std::getline(ss, campo, ';')) campos.push_back(campo);
+
+        PedidoFerias pedido;
+        pedido.linha = numeroLinha;
+        bool valido = campos.size() == 4 || campos.size() == 5;
+        if (valido) {
+            try {
+                pedido.id = std::stoi(campos[0]);
+                pedido.prioridade = std::stoi(campos[1]);
+                if (campos.size() == 5) pedido.grupo = std::stoi(campos[4]);
+            } catch (const std::exception&) {
+                valido = false;
+            }
+            pedido.inicio = lerDiaMes(campos[2], ano);
+            pedido.fim = lerDiaMes(campos[3], ano);
+            valido = valido && pedido.prioridade >= 1 && pedido.prioridade <= MAX_PRIORIDADE_FERIAS && pedido.grupo >= 1 &&
+                     pedido.inicio != 0 && pedido.fim != 0 && pedido.inicio <= pedido.fim;
+        }
+        if (!valido) {
+            std::cerr << COR_AMARELA << "[AVISO] Linha " << numeroLinha << " do ficheiro de pedidos ignorada: " << linha << "\n" << RESET_COR;
+            continue;
+        }
+        pedidos.push_back(pedido);
+    }
+    return true;
+}
+
+// ===============================================
+// RESOLUÇÃO POR DEPARTAMENTO
+// ===============================================
+
+struct OpcaoPlano {
+    size_t pedido = 0; // Índice em 'pedidos'
+    size_t grupo = 0;
+    int peso = 0;
+    DiasAno dias;
+    std::vector<int> listaDias;
+};
+
+struct GrupoPlano {
+    size_t colaborador = 0;    // Índice em ProblemaDepartamento::colaboradores
+    std::vector<size_t> opcoes; // Por peso decrescente
+    long escolhida = -1;        // Índice em ProblemaDepartamento::opcoes (-1 = nada concedido)
+};
+
+struct ColaboradorPlano {
+    int saldo = 0;
+    int usados = 0;
+    DiasAno ocupados; // Dias das opções concedidas
+};
+
+struct ProblemaDepartamento {
+    std::array<int, 367> capacidade{}; // Ausências a mais que cada dia ainda aguenta
+    std::array<int, 367> uso{};        // Ausências concedidas pelo plano em cada dia
+    std::vector<OpcaoPlano> opcoes;
+    std::vector<GrupoPlano> grupos;
+    std::vector<ColaboradorPlano> colaboradores;
+
+    int pesoDe(long o) const { return o < 0 ? 0 : opcoes[static_cast<size_t>(o)].peso; }
+
+    // A opção 'o' cabe no lugar da escolha atual do seu grupo?
+    bool cabe(size_t o) const {
+        const OpcaoPlano& opcao = opcoes[o];
+        const GrupoPlano& grupo = grupos[opcao.grupo];
+        const ColaboradorPlano& colab = colaboradores[grupo.colaborador];
+        const OpcaoPlano* atual = grupo.escolhida < 0 ? nullptr : &opcoes[static_cast<size_t>(grupo.escolhida)];
+
+        int usados = colab.usados + static_cast<int>(opcao.listaDias.size()) - (atual ? static_cast<int>(atual->listaDias.size()) : 0);
+        if (usados > colab.saldo) return false;
+        DiasAno outros = atual ? (colab.ocupados & ~atual->dias) : colab.ocupados;
+        if ((outros & opcao.dias).any()) return false;
+        return diaSaturado(o) == 0;
+    }
+
+    // Primeiro dia da opção sem capacidade para mais uma ausência (0 se nenhum)
+    int diaSaturado(size_t o) const {
+        const OpcaoPlano& opcao = opcoes[o];
+        const GrupoPlano& grupo = grupos[opcao.grupo];
+        const OpcaoPlano* atual = grupo.escolhida < 0 ? nullptr : &opcoes[static_cast<size_t>(grupo.escolhida)];
+        for (int d : opcao.listaDias) {
+            int libertado = (atual && atual->dias.test(static_cast<size_t>(d))) ? 1 : 0;
+            if (uso[static_cast<size_t>(d)] - libertado + 1 > capacidade[static_cast<size_t>(d)]) return d;
+        }
+        return 0;
+    }
+
+    void largar(size_t g) {
+        GrupoPlano& grupo = grupos[g];
+        if (grupo.escolhida < 0) return;
+        const OpcaoPlano& opcao = opcoes[static_cast<size_t>(grupo.escolhida)];
+        for (int d : opcao.listaDias) --uso[static_cast<size_t>(d)];
+        ColaboradorPlano& colab = colaboradores[grupo.colaborador];
+        colab.usados -= static_cast<int>(opcao.listaDias.size());
+        colab.ocupados &= ~opcao.dias;
+        grupo.escolhida = -1;
+    }
+
+    void escolher(size_t o) {
+        const OpcaoPlano& opcao = opcoes[o];
+        largar(opcao.grupo);
+        for (int d : opcao.listaDias) ++uso[static_cast<size_t>(d)];
+        ColaboradorPlano& colab = colaboradores[grupos[opcao.grupo].colaborador];
+        colab.usados += static_cast<int>(opcao.listaDias.size());
+        colab.ocupados |= opcao.dias;
+        grupos[opcao.grupo].escolhida = static_cast<long>(o);
+    }
+
+    void escolherOuLargar(size_t g, long o) {
+        if (o < 0) largar(g);
+        else escolher(static_cast<size_t>(o));
+    }
+
+    // Tenta conceder 'o' tirando a opção de um colega que ocupa um dia saturado; o colega fica com
+    // a melhor alternativa que ainda caiba. Só aceita a troca se o peso total aumentar.
+    bool tentarTroca(size_t o) {
+        int dia = diaSaturado(o);
+        if (dia == 0) return false;
+        const size_t g = opcoes[o].grupo;
+        const long anteriorG = grupos[g].escolhida;
+
+        for (size_t h = 0; h < grupos.size(); ++h) {
+            const long anteriorH = grupos[h].escolhida;
+            if (h == g || anteriorH < 0 || !opcoes[static_cast<size_t>(anteriorH)].dias.test(static_cast<size_t>(dia))) continue;
+
+            largar(h);
+            if (!cabe(o)) {
+                escolher(static_cast<size_t>(anteriorH));
+                continue;
+            }
+            escolher(o);
+            long novaH = -1;
+            for (size_t alternativa : grupos[h].opcoes) {
+                if (cabe(alternativa)) {
+                    escolher(alternativa);
+                    novaH = static_cast<long>(alternativa);
+                    break;
+                }
+            }
+            if (pesoDe(static_cast<long>(o)) + pesoDe(novaH) > pesoDe(anteriorG) + pesoDe(anteriorH)) return true;
+
+            // Desfazer pela ordem inversa
+            largar(h);
+            escolherOuLargar(g, anteriorG);
+            escolher(static_cast<size_t>(anteriorH));
+        }
+        return false;
+    }
+
+    void resolver() {
+        // Escolha gulosa: maior peso primeiro; em empate, o pedido com menos dias
+        std::vector<size_t> ordem(opcoes.size());
+        for (size_t i = 0; i < ordem.size(); ++i) ordem[i] = i;
+        std::stable_sort(ordem.begin(), ordem.end(), [&](size_t a, size_t b) {
+            if (opcoes[a].peso != opcoes[b].peso) return opcoes[a].peso > opcoes[b].peso;
+            return opcoes[a].listaDias.size() < opcoes[b].listaDias.size();
+        });
+        for (size_t o : ordem) {
+            if (grupos[opcoes[o].grupo].escolhida < 0 && cabe(o)) escolher(o);
+        }
+
+        // Pesquisa local: melhorar cada grupo para uma alternativa de maior peso
+        bool melhorou = true;
+        for (int ronda = 0; melhorou && ronda < RONDAS_PESQUISA_LOCAL; ++ronda) {
+            melhorou = false;
+            for (auto& grupo : grupos) {
+                for (size_t o : grupo.opcoes) {
+                    if (opcoes[o].peso <= pesoDe(grupo.escolhida)) break;
+                    if (cabe(o)) {
+                        escolher(o);
+                    } else if (!tentarTroca(o)) {
+                        continue;
+                    }
+                    melhorou = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Porque é que a opção 'o' ficou de fora do plano final
+    std::string motivoRecusa(size_t o, int ano) const {
+        const OpcaoPlano& opcao = opcoes[o];
+        const GrupoPlano& grupo = grupos[opcao.grupo];
+        if (grupo.escolhida >= 0) return "outra alternativa concedida";
+        const ColaboradorPlano& colab = colaboradores[grupo.colaborador];
+        if (colab.usados + static_cast<int>(opcao.listaDias.size()) > colab.saldo) return "saldo de ferias insuficiente";
+        if ((colab.ocupados & opcao.dias).any()) return "sobrepoe outro periodo concedido";
+        int dia = diaSaturado(o);
+        if (dia != 0) return "cobertura minima em " + textoDiaMes(dia, ano);
+        return "nao concedido";
+    }
+};
+
+PlanoFerias planearFerias(const std::vector<Colaborador>& lista, const std::vector<PedidoFerias>& pedidos,
+                          const MotorCobertura& cobertura, const DiasAno& naoUteis, int ano) {
+    MEDIR_ESCOPO(Metrica::PLANEAR_FERIAS);
+    PlanoFerias plano;
+    plano.ano = ano;
+    plano.decisoes.resize(pedidos.size());
+
+    std::unordered_map<int, size_t> posicaoPorId;
+    for (size_t i = 0; i < lista.size(); ++i) posicaoPorId[lista[i].id] = i;
+
+    // Montar um problema por departamento
+    std::vector<ProblemaDepartamento> problemas;
+    std::map<std::string, size_t> problemaDe;
+    std::vector<std::map<size_t, size_t>> colaboradorLocal;             // Por problema: posição na lista -> índice local
+    std::vector<std::map<std::pair<size_t, int>, size_t>> grupoLocal;   // Por problema: (colaborador, grupo) -> índice
+    std::vector<std::pair<size_t, size_t>> opcaoDoPedido(pedidos.size(), {0, 0}); // pedido -> (problema, opção)
+    std::vector<bool> temOpcao(pedidos.size(), false);
+
+    for (size_t i = 0; i < pedidos.size(); ++i) {
+        DecisaoFerias& decisao = plano.decisoes[i];
+        decisao.pedido = pedidos[i];
+        auto posicao = posicaoPorId.find(pedidos[i].id);
+        if (posicao == posicaoPorId.end()) {
+            decisao.motivo = "colaborador nao encontrado";
+            continue;
+        }
+        decisao.posicao = static_cast<long>(posicao->second);
+        const Colaborador& colab = lista[posicao->second];
+
+        auto [itProblema, novoProblema] = problemaDe.try_emplace(colab.departamento, problemas.size());
+        if (novoProblema) {
+            problemas.emplace_back();
+            colaboradorLocal.emplace_back();
+            grupoLocal.emplace_back();
+            ProblemaDepartamento& novo = problemas.back();
+            for (int d = 1; d <= 366; ++d) {
+                novo.capacidade[static_cast<size_t>(d)] = cobertura.capacidadeRestante(colab.departamento, d, ano);
+            }
+        }
+        const size_t p = itProblema->second;
+        ProblemaDepartamento& problema = problemas[p];
+
+        auto [itColab, novoColab] = colaboradorLocal[p].try_emplace(posicao->second, problema.colaboradores.size());
+        if (novoColab) {
+            problema.colaboradores.emplace_back();
+            // O plano concede dias inteiros: a fração do saldo fica para marcações de parte do dia
+            problema.colaboradores.back().saldo = std::max(colab.saldo_ferias, 0) / UNIDADES_POR_DIA;
+        }
+        auto [itGrupo, novoGrupo] = grupoLocal[p].try_emplace({itColab->second, pedidos[i].grupo}, problema.grupos.size());
+        if (novoGrupo) {
+            problema.grupos.emplace_back();
+            problema.grupos.back().colaborador = itColab->second;
+        }
+
+        OpcaoPlano opcao;
+        opcao.pedido = i;
+        opcao.grupo = itGrupo->second;
+        opcao.peso = MAX_PRIORIDADE_FERIAS + 1 - pedidos[i].prioridade;
+        opcao.dias = diasNovos(colab, pedidos[i], naoUteis);
+        for (int d = pedidos[i].inicio; d <= pedidos[i].fim; ++d) {
+            if (opcao.dias.test(static_cast<size_t>(d))) opcao.listaDias.push_back(d);
+        }
+        decisao.diasUteis = static_cast<int>(opcao.listaDias.size());
+        if (opcao.listaDias.empty()) {
+            decisao.motivo = "sem dias uteis por marcar";
+            continue;
+        }
+        opcaoDoPedido[i] = {p, problema.opcoes.size()};
+        temOpcao[i] = true;
+        problema.grupos[opcao.grupo].opcoes.push_back(problema.opcoes.size());
+        problema.opcoes.push_back(std::move(opcao));
+    }
+
+    // Os departamentos não partilham colaboradores nem cobertura: resolvem-se em paralelo
+    executarParalelo(problemas.size(), [&](size_t p) {
+        ProblemaDepartamento& problema = problemas[p];
+        for (auto& grupo : problema.grupos) {
+            std::stable_sort(grupo.opcoes.begin(), grupo.opcoes.end(), [&](size_t a, size_t b) {
+                if (problema.opcoes[a].peso != problema.opcoes[b].peso) return problema.opcoes[a].peso > problema.opcoes[b].peso;
+                return problema.opcoes[a].listaDias.size() < problema.opcoes[b].listaDias.size();
+            });
+        }
+        problema.resolver();
+    });
+
+    for (size_t i = 0; i < pedidos.size(); ++i) {
+        if (!temOpcao[i]) continue;
+        const ProblemaDepartamento& problema = problemas[opcaoDoPedido[i].first];
+        const size_t o = opcaoDoPedido[i].second;
+        DecisaoFerias& decisao = plano.decisoes[i];
+        decisao.concedido = problema.grupos[problema.opcoes[o].grupo].escolhida == static_cast<long>(o);
+        if (!decisao.concedido) decisao.motivo = problema.motivoRecusa(o, ano);
+    }
+
+    // Totais por grupo (colaborador + grupo), incluindo os pedidos sem opção válida
+    std::map<std::pair<int, int>, std::pair<int, int>> porGrupo; // -> (melhor peso, peso concedido)
+    for (const auto& decisao : plano.decisoes) {
+        auto& totais = porGrupo[{decisao.pedido.id, decisao.pedido.grupo}];
+        int peso = MAX_PRIORIDADE_FERIAS + 1 - decisao.pedido.prioridade;
+        totais.first = std::max(totais.first, peso);
+        if (decisao.concedido) totais.second = peso;
+    }
+    plano.grupos = static_cast<int>(porGrupo.size());
+    for (const auto& par : porGrupo) {
+        plano.pesoMaximo += par.second.first;
+        plano.pesoConcedido += par.second.second;
+        if (par.second.second > 0) ++plano.gruposConcedidos;
+    }
+    return plano;
+}
+
+// ===============================================
+// APLICAÇÃO (TUDO OU NADA)
+// ===============================================
+
+int aplicarPlanoFerias(std::vector<Colaborador>& lista, const PlanoFerias& plano, MotorCobertura& cobertura,
+                       const DiasAno& naoUteis) {
+    // As marcações são feitas em cópias e só passam para a lista se todas correrem bem
+    std::map<size_t, Colaborador> copias;
+    std::vector<std::pair<size_t, int>> marcados; // (posição, dia do ano)
+
+    for (const auto& decisao : plano.decisoes) {
+        if (!decisao.concedido || decisao.posicao < 0) continue;
+        const size_t posicao = static_cast<size_t>(decisao.posicao);
+        Colaborador& copia = copias.try_emplace(posicao, lista[posicao]).first->second;
+
+        // aplicarMarcacao desconta o saldo de férias de cada dia
+        DiasAno dias = diasNovos(copia, decisao.pedido, naoUteis);
+        for (int d = decisao.pedido.inicio; d <= decisao.pedido.fim; ++d) {
+            if (!dias.test(static_cast<size_t>(d))) continue;
+            int dia = 0, mes = 0;
+            diaDoAnoParaData(d, plano.ano, dia, mes);
+            ResultadoMarcacao r = aplicarMarcacao(copia, dia, mes, plano.ano, TipoMarcacao::FERIAS);
+            if (r != ResultadoMarcacao::OK) {
+                std::cout << COR_VERMELHA << "ERRO: Nao foi possivel marcar " << textoDiaMes(d, plano.ano) << " para "
+                          << copia.nome << " (linha " << decisao.pedido.linha << " dos pedidos).\n" << RESET_COR;
+                return -1;
+            }
+            marcados.push_back({posicao, d});
+        }
+    }
+
+    for (auto& par : copias) lista[par.first] = std::move(par.second);
+    for (const auto& marcado : marcados) {
+        cobertura.alterarDia(lista[marcado.first].departamento, marcado.second, TipoMarcacao::LIVRE, TipoMarcacao::FERIAS);
+        registarAlteracaoDia(lista[marcado.first], TipoMarcacao::LIVRE, TipoMarcacao::FERIAS);
+        registarAusenciaDia(lista[marcado.first], marcado.second, TipoMarcacao::LIVRE, TipoMarcacao::FERIAS);
+    }
+    return static_cast<int>(marcados.size());
+}
+
+// ===============================================
+// APRESENTAÇÃO E MENU
+// ===============================================
+
+// Número máximo de pedidos recusados listados na consola (o CSV tem todos)
+static const size_t MAX_RECUSADOS_CONSOLA = 20;
+
+void mostrarPlanoFerias(const PlanoFerias& plano, const std::vector<Colaborador>& lista) {
+    struct ResumoDepartamento { int pedidos = 0, concedidos = 0, dias = 0; };
+    std::map<std::string, ResumoDepartamento> resumo;
+    std::vector<const DecisaoFerias*> recusados;
+    for (const auto& decisao : plano.decisoes) {
+        const std::string departamento = decisao.posicao < 0 ? "(desconhecido)" : lista[static_cast<size_t>(decisao.posicao)].departamento;
+        ResumoDepartamento& r = resumo[departamento];
+        ++r.pedidos;
+        if (decisao.concedido) {
+            ++r.concedidos;
+            r.dias += decisao.diasUteis;
+        } else if (decisao.motivo != "outra alternativa concedida") {
+            recusados.push_back(&decisao);
+        }
+    }
+
+    std::cout << COR_AZUL << "\n--- Plano de Ferias " << plano.ano << " ---\n" << RESET_COR;
+    std::cout << std::left << std::setw(20) << "Departamento" << std::right << std::setw(10) << "Pedidos"
+              << std::setw(12) << "Concedidos" << std::setw(8) << "Dias" << "\n";
+    for (const auto& par : resumo) {
+        std::cout << std::left << std::setw(20) << par.first << std::right << std::setw(10) << par.second.pedidos
+                  << std::setw(12) << par.second.concedidos << std::setw(8) << par.second.dias << "\n";
+    }
+    std::cout << std::left;
+    int percentagem = plano.pesoMaximo == 0 ? 0 : 100 * plano.pesoConcedido / plano.pesoMaximo;
+    std::cout << COR_VERDE << plano.gruposConcedidos << " de " << plano.grupos << " periodos pedidos concedidos; peso "
+              << plano.pesoConcedido << " de " << plano.pesoMaximo << " (" << percentagem << "% das primeiras escolhas).\n" << RESET_COR;
+
+    if (recusados.empty()) return;
+    std::cout << COR_AMARELA << "\nPedidos recusados:\n" << RESET_COR;
+    for (size_t i = 0; i < recusados.size() && i < MAX_RECUSADOS_CONSOLA; ++i) {
+        const DecisaoFerias& d = *recusados[i];
+        std::cout << "  Linha " << d.pedido.linha << ": ID " << d.pedido.id << ", " << textoDiaMes(d.pedido.inicio, plano.ano)
+                  << " a " << textoDiaMes(d.pedido.fim, plano.ano) << " (prioridade " << d.pedido.prioridade << ") - "
+                  << d.motivo << "\n";
+    }
+    if (recusados.size() > MAX_RECUSADOS_CONSOLA) {
+        std::cout << "  ... e mais " << recusados.size() - MAX_RECUSADOS_CONSOLA << " (ver o CSV do plano)\n";
+    }
+}
+
+bool exportarPlanoFeriasCSV(const PlanoFerias& plano, const std::vector<Colaborador>& lista, const std::string& nomeFicheiro) {
+    BufferEscrita saida(nomeFicheiro);
+    if (!saida.aberto()) return false;
+
+    saida.escrever("ID,Nome,Departamento,Grupo,Prioridade,Inicio,Fim,Dias_Uteis,Decisao\n");
+    for (const auto& decisao : plano.decisoes) {
+        const Colaborador* colab = decisao.posicao < 0 ? nullptr : &lista[static_cast<size_t>(decisao.posicao)];
+        int dia = 0, mes = 0;
+        saida.escreverInt(decisao.pedido.id);
+        saida.escreverChar(',');
+        saida.escrever(colab ? colab->nome : std::string());
+        saida.escreverChar(',');
+        saida.escrever(colab ? colab->departamento : std::string());
+        saida.escreverChar(',');
+        saida.escreverInt(decisao.pedido.grupo);
+        saida.escreverChar(',');
+        saida.escreverInt(decisao.pedido.prioridade);
+        saida.escreverChar(',');
+        diaDoAnoParaData(decisao.pedido.inicio, plano.ano, dia, mes);
+        saida.escreverData(dia, mes, plano.ano);
+        saida.escreverChar(',');
+        diaDoAnoParaData(decisao.pedido.fim, plano.ano, dia, mes);
+        saida.escreverData(dia, mes, plano.ano);
+        saida.escreverChar(',');
+        saida.escreverInt(decisao.diasUteis);
+        saida.escreverChar(',');
+        saida.escrever(decisao.concedido ? "CONCEDIDO" : "RECUSADO: " + decisao.motivo);
+        saida.escreverChar('\n');
+    }
+    return true;
+}
+
+void menuPlaneamentoFerias(std::vector<Colaborador>& lista, MotorCobertura& cobertura) {
+    std::string nomeFicheiro, texto;
+    int ano = obterAnoAtual();
+    std::cout << COR_AZUL << "\n--- Planear Ferias em Lote ---\n" << RESET_COR;
+    std::cout << "Ficheiro de pedidos (ENTER = " << FICHEIRO_PEDIDOS_FERIAS << "): ";
+    std::getline(std::cin, nomeFicheiro);
+    if (nomeFicheiro.empty()) nomeFicheiro = FICHEIRO_PEDIDOS_FERIAS;
+    std::cout << "Ano (ENTER = " << ano << "): ";
+    std::getline(std::cin, texto);
+    if (!texto.empty()) {
+        try {
+            ano = std::stoi(texto);
+        } catch (const std::exception&) {
+            std::cout << COR_VERMELHA << "ERRO: Ano invalido.\n" << RESET_COR;
+            return;
+        }
+    }
+
+    std::vector<PedidoFerias> pedidos;
+    if (!lerPedidosFerias(nomeFicheiro, ano, pedidos)) {
+        std::cout << COR_VERMELHA << "ERRO: Nao foi possivel abrir o ficheiro " << nomeFicheiro << ".\n" << RESET_COR;
+        std::cout << "Formato: <id>;<prioridade 1-" << MAX_PRIORIDADE_FERIAS << ">;<dd/mm inicio>;<dd/mm fim>[;<grupo>]\n";
+        return;
+    }
+    if (pedidos.empty()) {
+        std::cout << COR_AMARELA << "AVISO: O ficheiro nao tem pedidos validos.\n" << RESET_COR;
+        return;
+    }
+
+    DiasAno naoUteis = diasNaoUteis(ano, FICHEIRO_FERIADOS);
+    PlanoFerias plano = planearFerias(lista, pedidos, cobertura, naoUteis, ano);
+    mostrarPlanoFerias(plano, lista);
+
+    const std::string nomeCSV = "plano_ferias_" + std::to_string(ano) + ".csv";
+    if (exportarPlanoFeriasCSV(plano, lista, nomeCSV)) {
+        std::cout << COR_VERDE << "Plano completo escrito em " << nomeCSV << "\n" << RESET_COR;
+    }
+    if (plano.gruposConcedidos == 0) return;
+
+    std::cout << COR_AZUL << "Aplicar o plano (marcar as ferias concedidas)? (S/N): " << RESET_COR;
+    std::getline(std::cin, texto);
+    if (texto.empty() || (texto[0] != 'S' && texto[0] != 's')) {
+        std::cout << "Plano nao aplicado.\n";
+        return;
+    }
+    int dias = aplicarPlanoFerias(lista, plano, cobertura, naoUteis);
+    if (dias < 0) {
+        std::cout << COR_VERMELHA << "ERRO: Plano nao aplicado (nenhuma marcacao foi feita).\n" << RESET_COR;
+    } else {
+        std::cout << COR_VERDE << "Plano aplicado: " << dias << " dias de ferias marcados.\n" << RESET_COR;
+    }
+}
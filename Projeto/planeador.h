@@ -0,0 +1,85 @@
+#ifndef PLANEADOR_H
+#define PLANEADOR_H
+
+#include "colaborador.h"
+#include "cobertura.h"
+#include <string>
+#include <vector>
+#include <bitset>
+
+// ===============================================
+// PLANEAMENTO DE FÉRIAS EM LOTE
+// ===============================================
+// Recebe os pedidos de férias de um ano (vários períodos alternativos por colaborador, por ordem
+// de preferência) e escolhe que pedidos conceder para maximizar o peso total concedido, respeitando:
+//   - os calendários atuais (dias já ausentes não contam) e os dias não úteis (fins de semana e
+//     feriados de rh_feriados.txt);
+//   - o saldo de férias de cada colaborador (saldo_ferias, só os dias inteiros);
+//   - a cobertura mínima de cada departamento (cobertura.h).
+// Os departamentos são independentes e são resolvidos em paralelo: primeiro uma escolha gulosa
+// pelos pedidos de maior peso, depois pesquisa local que troca um pedido concedido por um de maior
+// peso quando isso aumenta o total. O plano aceite é aplicado de uma vez (tudo ou nada).
+//
+// Ficheiro de pedidos (uma linha por alternativa, '#' inicia um comentário):
+//   <id>;<prioridade>;<dd/mm inicio>;<dd/mm fim>[;<grupo>]
+// A prioridade vai de 1 (preferida) a MAX_PRIORIDADE_FERIAS e o peso do pedido é
+// MAX_PRIORIDADE_FERIAS + 1 - prioridade. As alternativas do mesmo colaborador e grupo (1 por
+// omissão) excluem-se: no máximo uma é concedida. Grupos diferentes são períodos distintos.
+
+const int MAX_PRIORIDADE_FERIAS = 9;
+extern const std::string FICHEIRO_FERIADOS;       // Uma linha dd/mm por feriado (todos os anos)
+extern const std::string FICHEIRO_PEDIDOS_FERIAS; // Nome sugerido no menu
+
+using DiasAno = std::bitset<367>; // Índice = dia do ano (posição 0 não usada)
+
+struct PedidoFerias {
+    int id = 0;
+    int prioridade = 1;
+    int inicio = 0; // Dia do ano
+    int fim = 0;
+    int grupo = 1;
+    int linha = 0;  // Linha no ficheiro (para as mensagens)
+};
+
+struct DecisaoFerias {
+    PedidoFerias pedido;
+    long posicao = -1;  // Índice do colaborador na lista (-1 se não existir)
+    bool concedido = false;
+    int diasUteis = 0;  // Dias de férias novos que o pedido marca
+    std::string motivo; // Porque não foi concedido (vazio se concedido)
+};
+
+struct PlanoFerias {
+    int ano = 0;
+    std::vector<DecisaoFerias> decisoes; // Pela ordem dos pedidos
+    int pesoConcedido = 0;
+    int pesoMaximo = 0;                  // Soma da melhor alternativa de cada grupo
+    int gruposConcedidos = 0;
+    int grupos = 0;
+};
+
+// Fins de semana do ano mais os feriados lidos de 'nomeFicheiro' (se existir)
+DiasAno diasNaoUteis(int ano, const std::string& nomeFicheiro);
+
+// Lê os pedidos. As linhas inválidas são indicadas na consola e ignoradas.
+bool lerPedidosFerias(const std::string& nomeFicheiro, int ano, std::vector<PedidoFerias>& pedidos);
+
+// Calcula o plano sem alterar nada (a cobertura dá os mínimos e os ausentes atuais)
+PlanoFerias planearFerias(const std::vector<Colaborador>& lista, const std::vector<PedidoFerias>& pedidos,
+                          const MotorCobertura& cobertura, const DiasAno& naoUteis, int ano);
+
+// Marca os pedidos concedidos (aplicarMarcacao, que desconta o saldo de férias). Se alguma marcação
+// falhar, nada é alterado. Retorna o número de dias marcados, ou -1 em caso de falha.
+int aplicarPlanoFerias(std::vector<Colaborador>& lista, const PlanoFerias& plano, MotorCobertura& cobertura,
+                       const DiasAno& naoUteis);
+
+// Resumo por departamento e lista dos pedidos recusados
+void mostrarPlanoFerias(const PlanoFerias& plano, const std::vector<Colaborador>& lista);
+
+// CSV com uma linha por pedido: ID,Nome,Departamento,Grupo,Prioridade,Inicio,Fim,Dias_Uteis,Decisao
+bool exportarPlanoFeriasCSV(const PlanoFerias& plano, const std::vector<Colaborador>& lista, const std::string& nomeFicheiro);
+
+// Opção do menu: lê os pedidos, mostra o plano e aplica-o se o utilizador aceitar
+void menuPlaneamentoFerias(std::vector<Colaborador>& lista, MotorCobertura& cobertura);
+
+#endif // PLANEADOR_H
@@ -0,0 +1,334 @@
+#include "ranking.h"
+#include "calendario.h"
+#include "paralelo.h"
+#include "cores.h"
+#include "metricas.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <array>
+
+// ===============================================
+// CONSTRUÇÃO E ATUALIZAÇÃO
+// ===============================================
+
+// Posição do total na árvore de Fenwick (um calendário não tem mais de 366 dias)
+static int indiceTotal(int total) {
+    return std::min(std::max(total, 0), DIAS_INDICE_AUSENCIAS - 1) + 1;
+}
+
+static int totalDe(int ferias, int faltas, CriterioRanking criterio) {
+    return criterio == CriterioRanking::FALTAS ? faltas : ferias + faltas;
+}
+
+bool RankingAusencias::MaiorMedia::operator()(const ChaveDepartamento& a, const ChaveDepartamento& b) const {
+    // Compara ausenciasA/colaboradoresA com ausenciasB/colaboradoresB sem divisões
+    long long esquerda = a.ausencias * b.colaboradores;
+    long long direita = b.ausencias * a.colaboradores;
+    if (esquerda != direita) return esquerda > direita;
+    return a.departamento < b.departamento;
+}
+
+RankingAusencias::ChaveDepartamento RankingAusencias::chaveDe(const std::string& nome, const Departamento& depto) {
+    return {depto.ferias + depto.faltas, depto.colaboradores, nome};
+}
+
+void RankingAusencias::construir(const std::vector<Colaborador>& lista) {
+    MEDIR_ESCOPO(Metrica::CONSTRUIR_RANKING);
+    *this = RankingAusencias();
+
+    // As contagens são a parte cara e são independentes por colaborador
+    std::vector<std::array<int, 2>> contagens(lista.size());
+    executarBlocos(lista.size(), [&](size_t inicio, size_t fim, unsigned) {
+        for (size_t i = inicio; i < fim; ++i) {
+            for (const auto& par : lista[i].calendario) {
+                contagens[i][0] += contaTipo(MASCARA_FERIAS, par.second);
+                contagens[i][1] += contaTipo(MASCARA_FALTAS, par.second);
+            }
+        }
+    });
+
+    std::vector<Chave> chavesAusencias, chavesFaltas;
+    chavesAusencias.reserve(lista.size());
+    chavesFaltas.reserve(lista.size());
+    std::array<int, DIAS_INDICE_AUSENCIAS + 1> porTotalAusencias{}, porTotalFaltas{};
+    porId.reserve(lista.size());
+    for (size_t i = 0; i < lista.size(); ++i) {
+        const Colaborador& colab = lista[i];
+        const int ferias = contagens[i][0], faltas = contagens[i][1];
+        if (!porId.emplace(colab.id, Totais{colab.nome, colab.departamento, ferias, faltas}).second) continue;
+        chavesAusencias.push_back({ferias + faltas, colab.id});
+        chavesFaltas.push_back({faltas, colab.id});
+        ++porTotalAusencias[static_cast<size_t>(indiceTotal(ferias + faltas))];
+        ++porTotalFaltas[static_cast<size_t>(indiceTotal(faltas))];
+
+        Departamento& depto = porDepartamento[colab.departamento];
+        ++depto.colaboradores;
+        depto.ferias += ferias;
+        depto.faltas += faltas;
+    }
+
+    // Inserir já por ordem, com a posição final como sugestão, custa O(1) por elemento
+    std::sort(chavesAusencias.begin(), chavesAusencias.end(), MaisAusente());
+    std::sort(chavesFaltas.begin(), chavesFaltas.end(), MaisAusente());
+    for (const Chave& chave : chavesAusencias) {
+        porAusencias.insert(porAusencias.end(), chave);
+        Ordem& doDepartamento = porDepartamento[porId[chave.id].departamento].porAusencias;
+        doDepartamento.insert(doDepartamento.end(), chave);
+    }
+    for (const Chave& chave : chavesFaltas) porFaltas.insert(porFaltas.end(), chave);
+    contagemAusencias.construir(porTotalAusencias);
+    contagemFaltas.construir(porTotalFaltas);
+
+    for (const auto& par : porDepartamento) porMedia.insert(chaveDe(par.first, par.second));
+}
+
+void RankingAusencias::entrar(int id, const Totais& totais) {
+    const int ausencias = totais.ferias + totais.faltas;
+    porAusencias.insert({ausencias, id});
+    porFaltas.insert({totais.faltas, id});
+    contagemAusencias.adicionar(indiceTotal(ausencias), 1);
+    contagemFaltas.adicionar(indiceTotal(totais.faltas), 1);
+
+    auto it = porDepartamento.find(totais.departamento);
+    if (it == porDepartamento.end()) {
+        it = porDepartamento.emplace(totais.departamento, Departamento()).first;
+    } else {
+        porMedia.erase(chaveDe(it->first, it->second));
+    }
+    Departamento& depto = it->second;
+    ++depto.colaboradores;
+    depto.ferias += totais.ferias;
+    depto.faltas += totais.faltas;
+    depto.porAusencias.insert({ausencias, id});
+    porMedia.insert(chaveDe(it->first, depto));
+}
+
+void RankingAusencias::sair(int id, const Totais& totais) {
+    const int ausencias = totais.ferias + totais.faltas;
+    porAusencias.erase({ausencias, id});
+    porFaltas.erase({totais.faltas, id});
+    contagemAusencias.adicionar(indiceTotal(ausencias), -1);
+    contagemFaltas.adicionar(indiceTotal(totais.faltas), -1);
+
+    auto it = porDepartamento.find(totais.departamento);
+    if (it == porDepartamento.end()) return;
+    porMedia.erase(chaveDe(it->first, it->second));
+    Departamento& depto = it->second;
+    --depto.colaboradores;
+    depto.ferias -= totais.ferias;
+    depto.faltas -= totais.faltas;
+    depto.porAusencias.erase({ausencias, id});
+    if (depto.colaboradores <= 0) {
+        porDepartamento.erase(it);
+    } else {
+        porMedia.insert(chaveDe(it->first, depto));
+    }
+}
+
+void RankingAusencias::acrescentar(const Colaborador& colab) {
+    if (porId.count(colab.id)) retirar(colab.id);
+    Totais totais{colab.nome, colab.departamento, 0, 0};
+    for (const auto& par : colab.calendario) {
+        totais.ferias += contaTipo(MASCARA_FERIAS, par.second);
+        totais.faltas += contaTipo(MASCARA_FALTAS, par.second);
+    }
+    entrar(colab.id, totais);
+    porId.emplace(colab.id, std::move(totais));
+}
+
+void RankingAusencias::retirar(int id) {
+    auto it = porId.find(id);
+    if (it == porId.end()) return;
+    sair(id, it->second);
+    porId.erase(it);
+}
+
+void RankingAusencias::alterarDia(int id, TipoMarcacao antes, TipoMarcacao depois) {
+    auto it = porId.find(id);
+    if (it == porId.end() || antes == depois) return;
+    const int ferias = contaTipo(MASCARA_FERIAS, depois) - contaTipo(MASCARA_FERIAS, antes);
+    const int faltas = contaTipo(MASCARA_FALTAS, depois) - contaTipo(MASCARA_FALTAS, antes);
+    if (ferias == 0 && faltas == 0) return;
+
+    sair(id, it->second);
+    it->second.ferias += ferias;
+    it->second.faltas += faltas;
+    entrar(id, it->second);
+}
+
+// ===============================================
+// CONSULTAS
+// ===============================================
+
+std::vector<LinhaRanking> RankingAusencias::linhas(const Ordem& ordem, size_t k, CriterioRanking criterio) const {
+    std::vector<LinhaRanking> resultado;
+    resultado.reserve(std::min(k, ordem.size()));
+    for (auto it = ordem.begin(); it != ordem.end() && resultado.size() < k; ++it) {
+        const Totais& totais = porId.at(it->id);
+        LinhaRanking linha;
+        linha.id = it->id;
+        linha.nome = totais.nome;
+        linha.departamento = totais.departamento;
+        linha.ferias = totais.ferias;
+        linha.faltas = totais.faltas;
+        // Empates partilham a posição (1, 2, 2, 4...)
+        const bool empate = !resultado.empty() &&
+                            totalDe(resultado.back().ferias, resultado.back().faltas, criterio) == it->total;
+        linha.posicao = empate ? resultado.back().posicao : static_cast<int>(resultado.size()) + 1;
+        resultado.push_back(std::move(linha));
+    }
+    return resultado;
+}
+
+std::vector<LinhaRanking> RankingAusencias::top(size_t k, CriterioRanking criterio) const {
+    return linhas(criterio == CriterioRanking::FALTAS ? porFaltas : porAusencias, k, criterio);
+}
+
+std::vector<LinhaRanking> RankingAusencias::topDepartamento(const std::string& departamento, size_t k) const {
+    auto it = porDepartamento.find(departamento);
+    if (it == porDepartamento.end()) return {};
+    return linhas(it->second.porAusencias, k, CriterioRanking::AUSENCIAS);
+}
+
+std::vector<LinhaRankingDepartamento> RankingAusencias::departamentos(size_t k) const {
+    std::vector<LinhaRankingDepartamento> resultado;
+    for (auto it = porMedia.begin(); it != porMedia.end() && resultado.size() < k; ++it) {
+        const Departamento& depto = porDepartamento.at(it->departamento);
+        resultado.push_back({it->departamento, depto.colaboradores, depto.ferias, depto.faltas});
+    }
+    return resultado;
+}
+
+int RankingAusencias::posicaoDe(int id, CriterioRanking criterio) const {
+    auto it = porId.find(id);
+    if (it == porId.end()) return 0;
+    const ArvoreFenwick& contagem = criterio == CriterioRanking::FALTAS ? contagemFaltas : contagemAusencias;
+    const int total = totalDe(it->second.ferias, it->second.faltas, criterio);
+    // Colaboradores com total maior = todos menos os que têm total <= este
+    const int maiores = static_cast<int>(porId.size()) - contagem.somaAte(indiceTotal(total));
+    return maiores + 1;
+}
+
+// ===============================================
+// GANCHOS
+// ===============================================
+
+static RankingAusencias* rankingAtivo = nullptr;
+
+void ativarRanking(RankingAusencias* ranking) {
+    rankingAtivo = ranking;
+}
+
+void registarColaboradorRanking(const Colaborador& colab) {
+    if (rankingAtivo != nullptr) rankingAtivo->acrescentar(colab);
+}
+
+void retirarColaboradorRanking(const Colaborador& colab) {
+    if (rankingAtivo != nullptr) rankingAtivo->retirar(colab.id);
+}
+
+void registarAlteracaoDia(const Colaborador& colab, TipoMarcacao antes, TipoMarcacao depois) {
+    if (rankingAtivo != nullptr) rankingAtivo->alterarDia(colab.id, antes, depois);
+}
+
+// ===============================================
+// MENU
+// ===============================================
+
+// Pede um inteiro; ENTER mantém 'valor'
+static bool lerInteiroOpcional(const std::string& pergunta, int& valor) {
+    std::string texto;
+    std::cout << pergunta;
+    std::getline(std::cin, texto);
+    if (texto.empty()) return true;
+    try {
+        valor = std::stoi(texto);
+    } catch (const std::exception&) {
+        std::cout << COR_VERMELHA << "ERRO: Valor invalido.\n" << RESET_COR;
+        return false;
+    }
+    return true;
+}
+
+static void mostrarLinhas(const std::vector<LinhaRanking>& linhas) {
+    if (linhas.empty()) {
+        std::cout << COR_AMARELA << "Sem colaboradores para mostrar.\n" << RESET_COR;
+        return;
+    }
+    std::cout << COR_CIANO << std::left << std::setw(6) << "Pos." << std::setw(7) << "ID" << std::setw(28) << "Nome"
+              << std::setw(18) << "Departamento" << std::setw(8) << "Ferias" << std::setw(8) << "Faltas" << "Total"
+              << RESET_COR << "\n";
+    for (const auto& linha : linhas) {
+        std::cout << std::left << std::setw(6) << linha.posicao << std::setw(7) << linha.id << std::setw(28)
+                  << linha.nome.substr(0, 27) << std::setw(18) << linha.departamento.substr(0, 17) << std::setw(8)
+                  << linha.ferias << std::setw(8) << linha.faltas << linha.ferias + linha.faltas << "\n";
+    }
+}
+
+void menuRanking(const RankingAusencias& ranking) {
+    std::cout << COR_AZUL << "\n--- Rankings de Ausencias (" << obterAnoAtual() << ") ---\n" << RESET_COR;
+    std::cout << ranking.colaboradores() << " colaboradores.\n";
+    std::cout << " 1. Colaboradores com mais ausencias (ferias + faltas)\n";
+    std::cout << " 2. Colaboradores com mais faltas\n";
+    std::cout << " 3. Departamentos por media de ausencias\n";
+    std::cout << " 4. Classificacao de um departamento\n";
+    std::cout << " 5. Posicao de um colaborador\n";
+    int opcao = 0;
+    if (!lerInteiroOpcional("Opcao: ", opcao)) return;
+    if (opcao < 1 || opcao > 5) {
+        std::cout << COR_VERMELHA << "Opcao invalida.\n" << RESET_COR;
+        return;
+    }
+
+    if (opcao == 5) {
+        int id = 0;
+        if (!lerInteiroOpcional("ID do colaborador: ", id)) return;
+        const int ausencias = ranking.posicaoDe(id, CriterioRanking::AUSENCIAS);
+        if (ausencias == 0) {
+            std::cout << COR_VERMELHA << "ERRO: Colaborador nao encontrado.\n" << RESET_COR;
+            return;
+        }
+        std::cout << "Posicao por ausencias: " << ausencias << " de " << ranking.colaboradores() << "\n";
+        std::cout << "Posicao por faltas:    " << ranking.posicaoDe(id, CriterioRanking::FALTAS) << " de "
+                  << ranking.colaboradores() << "\n";
+        return;
+    }
+
+    std::string departamento;
+    if (opcao == 4) {
+        std::cout << "Departamento: ";
+        std::getline(std::cin, departamento);
+    }
+    int k = 20;
+    if (!lerInteiroOpcional("Quantos mostrar (ENTER = 20): ", k)) return;
+    if (k < 1) {
+        std::cout << COR_VERMELHA << "ERRO: O numero tem de ser positivo.\n" << RESET_COR;
+        return;
+    }
+    const size_t limite = static_cast<size_t>(k);
+
+    if (opcao == 1) {
+        mostrarLinhas(ranking.top(limite, CriterioRanking::AUSENCIAS));
+    } else if (opcao == 2) {
+        mostrarLinhas(ranking.top(limite, CriterioRanking::FALTAS));
+    } else if (opcao == 4) {
+        std::vector<LinhaRanking> linhas = ranking.topDepartamento(departamento, limite);
+        if (linhas.empty()) {
+            std::cout << COR_VERMELHA << "ERRO: Departamento nao encontrado.\n" << RESET_COR;
+            return;
+        }
+        mostrarLinhas(linhas);
+    } else {
+        std::vector<LinhaRankingDepartamento> deptos = ranking.departamentos(limite);
+        std::cout << COR_CIANO << std::left << std::setw(6) << "Pos." << std::setw(22) << "Departamento" << std::setw(14)
+                  << "Colaboradores" << std::setw(8) << "Ferias" << std::setw(8) << "Faltas" << "Media/Colab." << RESET_COR << "\n";
+        for (size_t i = 0; i < deptos.size(); ++i) {
+            const LinhaRankingDepartamento& d = deptos[i];
+            std::cout << std::left << std::setw(6) << i + 1 << std::setw(22) << d.departamento.substr(0, 21) << std::setw(14)
+                      << d.colaboradores << std::setw(8) << d.ferias << std::setw(8) << d.faltas << std::fixed
+                      << std::setprecision(2) << d.mediaPorColaborador() << "\n";
+        }
+        std::cout << std::defaultfloat << std::setprecision(6);
+    }
+}
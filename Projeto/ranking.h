@@ -0,0 +1,125 @@
+#ifndef RANKING_H
+#define RANKING_H
+
+#include "colaborador.h"
+#include "ausencias.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+// ===============================================
+// RANKINGS DE AUSÊNCIAS
+// ===============================================
+// Totais de férias e faltas do calendário em memória (ano atual) por colaborador, mantidos por
+// ordem em árvores equilibradas (std::set): a lista da empresa por ausências e por faltas, a de
+// cada departamento por ausências e a dos departamentos pela média de ausências por colaborador.
+// Uma árvore de Fenwick com o número de colaboradores por total dá a posição de qualquer
+// colaborador em O(log 366) (empates partilham a posição).
+//
+// Cada marcação ou desmarcação move o colaborador nas árvores em O(log N), por isso um top-K
+// custa O(log N + K) sem voltar a contar a lista. O menu de marcações, o planeamento de férias e
+// o CRUD de colaboradores atualizam o ranking ativo através dos ganchos no fim do ficheiro.
+
+enum class CriterioRanking {
+    AUSENCIAS, // Férias + faltas
+    FALTAS
+};
+
+struct LinhaRanking {
+    int id = 0;
+    std::string nome;
+    std::string departamento;
+    int ferias = 0;
+    int faltas = 0;
+    int posicao = 0; // 1 = mais ausências
+};
+
+struct LinhaRankingDepartamento {
+    std::string departamento;
+    int colaboradores = 0;
+    long long ferias = 0;
+    long long faltas = 0;
+
+    double mediaPorColaborador() const {
+        return colaboradores > 0 ? static_cast<double>(ferias + faltas) / colaboradores : 0.0;
+    }
+};
+
+struct RankingAusencias {
+    void construir(const std::vector<Colaborador>& lista);
+    void acrescentar(const Colaborador& colab);
+    void retirar(int id);
+    void alterarDia(int id, TipoMarcacao antes, TipoMarcacao depois);
+
+    // Os K colaboradores com mais ausências (ou faltas) da empresa, ou só de um departamento
+    std::vector<LinhaRanking> top(size_t k, CriterioRanking criterio) const;
+    std::vector<LinhaRanking> topDepartamento(const std::string& departamento, size_t k) const;
+
+    // Departamentos por média de ausências por colaborador (os K primeiros)
+    std::vector<LinhaRankingDepartamento> departamentos(size_t k) const;
+
+    // Posição do colaborador na empresa (0 se não existir)
+    int posicaoDe(int id, CriterioRanking criterio) const;
+
+    size_t colaboradores() const { return porId.size(); }
+
+private:
+    struct Totais {
+        std::string nome;
+        std::string departamento;
+        int ferias = 0;
+        int faltas = 0;
+    };
+    struct Chave {
+        int total = 0;
+        int id = 0;
+    };
+    struct MaisAusente {
+        bool operator()(const Chave& a, const Chave& b) const {
+            return a.total != b.total ? a.total > b.total : a.id < b.id;
+        }
+    };
+    using Ordem = std::set<Chave, MaisAusente>;
+
+    struct Departamento {
+        int colaboradores = 0;
+        long long ferias = 0;
+        long long faltas = 0;
+        Ordem porAusencias;
+    };
+    struct ChaveDepartamento {
+        long long ausencias = 0;
+        int colaboradores = 0;
+        std::string departamento;
+    };
+    struct MaiorMedia {
+        bool operator()(const ChaveDepartamento& a, const ChaveDepartamento& b) const;
+    };
+
+    std::unordered_map<int, Totais> porId;
+    Ordem porAusencias;
+    Ordem porFaltas;
+    ArvoreFenwick contagemAusencias; // Índice = total + 1
+    ArvoreFenwick contagemFaltas;
+    std::map<std::string, Departamento> porDepartamento;
+    std::set<ChaveDepartamento, MaiorMedia> porMedia;
+
+    static ChaveDepartamento chaveDe(const std::string& nome, const Departamento& depto);
+    void entrar(int id, const Totais& totais);
+    void sair(int id, const Totais& totais);
+    std::vector<LinhaRanking> linhas(const Ordem& ordem, size_t k, CriterioRanking criterio) const;
+};
+
+// Ganchos: atualizam o ranking ativo (se houver)
+void ativarRanking(RankingAusencias* ranking);
+void registarColaboradorRanking(const Colaborador& colab);
+void retirarColaboradorRanking(const Colaborador& colab);
+void registarAlteracaoDia(const Colaborador& colab, TipoMarcacao antes, TipoMarcacao depois);
+
+// Opção do menu: top-K da empresa, departamentos ordenados, classificação de um departamento
+// e posição de um colaborador
+void menuRanking(const RankingAusencias& ranking);
+
+#endif // RANKING_H
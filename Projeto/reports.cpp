@@ -8,9 +8,14 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
-#include <fstream>
 #include <ctime>
 #include <limits>
+#include <map>
+#include <atomic>
+#include "paralelo.h"
+#include "metricas.h"
+#include "arquivo.h"
+#include "ausencias.h"
 
 extern const std::string COR_AMARELA;
 extern const std::string COR_VERMELHA;
@@ -21,6 +26,7 @@ extern const std::string RESET_COR;
 
 // --- Implementação do Dashboard Resumido  ---
 void dashboardResumido(const std::vector<Colaborador>& lista) {
+    MEDIR_ESCOPO(Metrica::DASHBOARD);
     if (lista.empty()) {
         std::cout << COR_AMARELA << "AVISO: Nao ha colaboradores para gerar o Dashboard.\n" << RESET_COR;
         return;
@@ -52,9 +58,9 @@ void dashboardResumido(const std::vector<Colaborador>& lista) {
 
         std::cout << std::left
                   << std::setw(30) << colab.nome
-                  << std::setw(10) << total_ferias_contadas
-                  << std::setw(10) << total_faltas_contadas
-                  << std::setw(15) << colab.dias_ferias_restantes
+                  << std::setw(10) << formatarDias(total_ferias_contadas)
+                  << std::setw(10) << formatarDias(total_faltas_contadas)
+                  << std::setw(15) << formatarDias(colab.saldo_ferias)
                   << colab.departamento << "\n";
     }
     std::cout << "==================================================================\n";
@@ -62,6 +68,7 @@ void dashboardResumido(const std::vector<Colaborador>& lista) {
 
 // --- Implementação dos Relatórios Mensais ---
 void relatorioMensal(const std::vector<Colaborador>& lista) {
+    MEDIR_ESCOPO(Metrica::RELATORIO_MENSAL);
     if (lista.empty()) {
         std::cout << COR_AMARELA << "AVISO: Nao ha colaboradores para gerar relatorios.\n" << RESET_COR;
         return;
@@ -93,8 +100,8 @@ void relatorioMensal(const std::vector<Colaborador>& lista) {
 
         std::cout << std::setfill(' ') << std::left
                   << std::setw(30) << colab.nome
-                  << std::setw(10) << ferias
-                  << faltas << "\n";
+                  << std::setw(10) << formatarDias(ferias)
+                  << formatarDias(faltas) << "\n";
     }
     std::cout << "============================================\n";
 }
@@ -106,6 +113,12 @@ void estatisticasDepartamento(const std::vector<Colaborador>& lista) {
         std::cout << COR_AMARELA << "AVISO: Nao ha colaboradores para gerar estatisticas.\n" << RESET_COR;
         return;
     }
+    estatisticasDepartamentoPorPartes([&](const VisitarParte& visitar) { visitar(lista); });
+}
+
+// Os totais são acumulados parte a parte, por isso a empresa nunca precisa de estar toda em memória
+void estatisticasDepartamentoPorPartes(const PercorrerEmpresa& empresa) {
+    MEDIR_ESCOPO(Metrica::ESTATISTICAS_DEPTO);
 
     // Obter o ano atual para a estatística
     std::time_t t = std::time(nullptr);
@@ -123,14 +136,21 @@ void estatisticasDepartamento(const std::vector<Colaborador>& lista) {
     std::string deptMaisAusente = "N/A";
     int maxAusencias = -1;
 
-    for (const auto& colab : lista) {
-        int ferias = 0;
-        int faltas = 0;
-        // Contar ausências anuais para o departamento
-        contarAusencias(colab, anoAtual, ferias, faltas);
+    empresa([&](const std::vector<Colaborador>& parte) {
+        for (const auto& colab : parte) {
+            int ferias = 0;
+            int faltas = 0;
+            // Contar ausências anuais para o departamento
+            contarAusencias(colab, anoAtual, ferias, faltas);
 
-        stats[colab.departamento].total_ferias += ferias;
-        stats[colab.departamento].total_faltas += faltas;
+            stats[colab.departamento].total_ferias += ferias;
+            stats[colab.departamento].total_faltas += faltas;
+        }
+    });
+
+    if (stats.empty()) {
+        std::cout << COR_AMARELA << "AVISO: Nao ha colaboradores para gerar estatisticas.\n" << RESET_COR;
+        return;
     }
 
     std::cout << COR_AZUL << "\n--- Estatisticas de Departamento (" << anoAtual << ") ---\n" << RESET_COR;
@@ -144,9 +164,9 @@ void estatisticasDepartamento(const std::vector<Colaborador>& lista) {
 
         std::cout << std::left
                   << std::setw(25) << dept
-                  << std::setw(10) << s.total_ferias
-                  << std::setw(10) << s.total_faltas
-                  << s.total_ausencias() << "\n";
+                  << std::setw(10) << formatarDias(s.total_ferias)
+                  << std::setw(10) << formatarDias(s.total_faltas)
+                  << formatarDias(s.total_ausencias()) << "\n";
 
         // Determinar o departamento com mais ausências
         if (s.total_ausencias() > maxAusencias) {
@@ -156,16 +176,220 @@ void estatisticasDepartamento(const std::vector<Colaborador>& lista) {
     }
     std::cout << "==================================================\n";
     if (maxAusencias > 0) {
-        std::cout << COR_AMARELA << "Departamento com mais ausencias (" << maxAusencias << " dias): " << deptMaisAusente << RESET_COR << "\n";
+        std::cout << COR_AMARELA << "Departamento com mais ausencias (" << formatarDias(maxAusencias) << " dias): " << deptMaisAusente << RESET_COR << "\n";
     } else {
         std::cout << COR_AMARELA << "Nao foram encontradas ausencias registadas neste ano.\n" << RESET_COR;
     }
 }
 
 
+// --- Implementação do Relatório por Intervalo ---
+
+// Lê uma data "Dia Mes Ano" (retorna false se não for numérica ou válida)
+static bool pedirData(const std::string& pergunta, int& dia, int& mes, int& ano) {
+    std::cout << pergunta;
+    if (!(std::cin >> dia >> mes >> ano)) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        return false;
+    }
+    return dataValida(dia, mes, ano);
+}
+
+// O índice de ausências do ano em curso é o da sessão; o de um ano fechado é construído uma vez
+// (uma parte de cada vez). Depois cada total de departamento, e cada mês dentro do intervalo, é
+// uma consulta O(log 366) às árvores de Fenwick
+void relatorioAusenciasIntervalo(const PercorrerEmpresa& empresa, const IndiceAusencias& indiceAtual) {
+    int diaInicio, mesInicio, anoInicio, diaFim, mesFim, anoFim;
+    std::cout << COR_AZUL << "\n--- Ausencias por Intervalo ---\n" << RESET_COR;
+    bool valido = pedirData("Data inicial (Dia Mes Ano): ", diaInicio, mesInicio, anoInicio) &&
+                  pedirData("Data final (Dia Mes Ano): ", diaFim, mesFim, anoFim);
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    if (!valido) {
+        std::cout << COR_VERMELHA << "ERRO: Data invalida.\n" << RESET_COR;
+        return;
+    }
+    if (anoInicio != anoFim) {
+        std::cout << COR_VERMELHA << "ERRO: O intervalo tem de estar dentro do mesmo ano.\n" << RESET_COR;
+        return;
+    }
+    const int ano = anoInicio;
+    int inicio = dataParaDiaDoAno(diaInicio, mesInicio, ano);
+    int fim = dataParaDiaDoAno(diaFim, mesFim, ano);
+    if (inicio > fim) {
+        std::cout << COR_VERMELHA << "ERRO: A data inicial e posterior a data final.\n" << RESET_COR;
+        return;
+    }
+
+    // O índice da sessão é o do calendário em memória; um ano fechado vem do arquivo
+    IndiceAusencias arquivado;
+    const IndiceAusencias* indiceAno = &indiceAtual;
+    if (ano < obterAnoAtual()) {
+        empresa([&](const std::vector<Colaborador>& parte) { arquivado.acrescentar(parte, ano); });
+        indiceAno = &arquivado;
+    }
+    const IndiceAusencias& indice = *indiceAno;
+    if (indice.porDepartamento.empty()) {
+        std::cout << COR_AMARELA << "AVISO: Nao ha colaboradores para gerar relatorios.\n" << RESET_COR;
+        return;
+    }
+
+    std::cout << "\n==================================================\n";
+    std::cout << COR_AZUL << " Ausencias de " << diaInicio << "/" << mesInicio << " a " << diaFim << "/" << mesFim
+              << "/" << ano << RESET_COR << "\n";
+    std::cout << "==================================================\n";
+    std::cout << std::left << std::setw(25) << "Departamento" << std::setw(10) << "Ferias" << std::setw(10) << "Faltas" << "Total Ausencias\n";
+    std::cout << "--------------------------------------------------\n";
+    // Totais em unidades, em dias com formatarDias (um meio dia conta 0.5)
+    long long totalFerias = 0, totalFaltas = 0;
+    for (const auto& par : indice.porDepartamento) {
+        int ferias = 0, faltas = 0;
+        indice.contarUnidadesIntervalo(par.first, inicio, fim, ferias, faltas);
+        totalFerias += ferias;
+        totalFaltas += faltas;
+        std::cout << std::left << std::setw(25) << par.first << std::setw(10) << formatarDias(ferias) << std::setw(10)
+                  << formatarDias(faltas) << formatarDias(ferias + faltas) << "\n";
+    }
+    std::cout << "--------------------------------------------------\n";
+    std::cout << std::left << std::setw(25) << "Empresa" << std::setw(10) << formatarDias(totalFerias) << std::setw(10)
+              << formatarDias(totalFaltas) << formatarDias(totalFerias + totalFaltas) << "\n";
+
+    // Repartição por mês (só a parte de cada mês que cai dentro do intervalo)
+    if (mesInicio != mesFim) {
+        std::cout << "--------------------------------------------------\n";
+        for (int mes = mesInicio; mes <= mesFim; ++mes) {
+            int inicioMes = std::max(inicio, dataParaDiaDoAno(1, mes, ano));
+            int fimMes = std::min(fim, dataParaDiaDoAno(diasNoMes(mes, ano), mes, ano));
+            long long feriasMes = 0, faltasMes = 0;
+            for (const auto& par : indice.porDepartamento) {
+                feriasMes += par.second.unidadesFerias.somaIntervalo(inicioMes, fimMes);
+                faltasMes += par.second.unidadesFaltas.somaIntervalo(inicioMes, fimMes);
+            }
+            std::cout << std::left << std::setw(25) << nomeMes(mes) << std::setw(10) << formatarDias(feriasMes) << std::setw(10)
+                      << formatarDias(faltasMes) << formatarDias(feriasMes + faltasMes) << "\n";
+        }
+    }
+    std::cout << "==================================================\n";
+}
+
 // --- Implementação da Exportação  ---
-void exportarDados(const std::vector<Colaborador>& lista) {
-    if (lista.empty()) {
+
+// Escreve as ausências (Férias/Faltas) datadas de um colaborador. Retorna o número de linhas.
+// A chave do calendário é o dia do ano (1 a 366), por isso a data é reconstruída com o ano pedido.
+size_t escreverAusenciasColaborador(BufferEscrita& saida, const Colaborador& colab, int ano) {
+    size_t linhas = 0;
+    std::map<int, TipoMarcacao> arquivado;
+    for (const auto& par : calendarioDoAno(colab, ano, arquivado)) {
+        // Fins de semana, dias livres, formação e teletrabalho não são ausências
+        if (!temTipo(MASCARA_AUSENCIA, par.second)) continue;
+        char tipo_char = propriedadesMarcacao(par.second).simbolo;
+
+        int dia = 0, mes = 0;
+        if (!diaDoAnoParaData(par.first, ano, dia, mes)) continue;
+
+        saida.escreverInt(colab.id);
+        saida.escreverChar(',');
+        saida.escrever(colab.nome);
+        saida.escreverChar(',');
+        saida.escrever(colab.departamento);
+        saida.escreverChar(',');
+        saida.escreverData(dia, mes, ano);
+        saida.escreverChar(',');
+        saida.escreverChar(tipo_char);
+        saida.escreverChar('\n');
+        ++linhas;
+    }
+    return linhas;
+}
+
+// Exporta as ausências datadas de todos os colaboradores para um único ficheiro
+size_t exportarAusenciasEmpresa(const std::vector<Colaborador>& lista, int ano, const std::string& nomeFicheiro) {
+    return exportarAusenciasEmpresaPorPartes([&](const VisitarParte& visitar) { visitar(lista); }, ano, nomeFicheiro);
+}
+
+size_t exportarAusenciasEmpresaPorPartes(const PercorrerEmpresa& empresa, int ano, const std::string& nomeFicheiro) {
+    MEDIR_ESCOPO(Metrica::EXPORTAR_AUSENCIAS_EMPRESA);
+    BufferEscrita saida(nomeFicheiro);
+    if (!saida.aberto()) {
+        std::cout << COR_VERMELHA << "ERRO: Nao foi possivel abrir o ficheiro " << nomeFicheiro << " para escrita.\n" << RESET_COR;
+        return 0;
+    }
+
+    saida.escrever("ID, Nome, Departamento, Data, Tipo_Marcacao\n");
+    size_t linhas = 0;
+    empresa([&](const std::vector<Colaborador>& parte) {
+        for (const auto& colab : parte) {
+            linhas += escreverAusenciasColaborador(saida, colab, ano);
+        }
+    });
+    CONTAR_EVENTO(Contador::LINHAS_EXPORTADAS, linhas);
+    return linhas;
+}
+
+static const char CABECALHO_RELATORIO_DEPARTAMENTO[] =
+    "Departamento, Nome, Ferias ao Ano, Faltas ao Ano, Dias Restantes de Ferias\n";
+
+// Uma linha do relatório anual de departamento
+static void escreverLinhaRelatorioDepartamento(BufferEscrita& saida, const Colaborador& colab, int ano) {
+    int total_ferias = 0;
+    int total_faltas = 0;
+    contarAusencias(colab, ano, total_ferias, total_faltas);
+
+    saida.escrever(colab.departamento);
+    saida.escreverChar(',');
+    saida.escrever(colab.nome);
+    saida.escreverChar(',');
+    saida.escreverDias(total_ferias);
+    saida.escreverChar(',');
+    saida.escreverDias(total_faltas);
+    saida.escreverChar(',');
+    saida.escreverDias(colab.saldo_ferias);
+    saida.escreverChar('\n');
+}
+
+// Exporta o relatório anual de cada departamento para o seu próprio ficheiro.
+// Os ficheiros são gerados em paralelo (um departamento por tarefa do pool). Retorna o número de ficheiros.
+size_t exportarRelatoriosDepartamentos(const std::vector<Colaborador>& lista, int ano) {
+    MEDIR_ESCOPO(Metrica::EXPORTAR_RELATORIOS_DEPTOS);
+    // Agrupar os índices dos colaboradores por departamento
+    std::map<std::string, std::vector<size_t>> porDepto;
+    for (size_t i = 0; i < lista.size(); ++i) {
+        porDepto[lista[i].departamento].push_back(i);
+    }
+
+    std::vector<const std::pair<const std::string, std::vector<size_t>>*> deptos;
+    deptos.reserve(porDepto.size());
+    for (const auto& par : porDepto) deptos.push_back(&par);
+
+    // Cada tarefa só marca a sua posição; os erros são escritos depois, pela ordem dos departamentos
+    std::vector<char> semFicheiro(deptos.size(), 0);
+    std::atomic<size_t> ficheirosCriados(0);
+    executarParalelo(deptos.size(), [&](size_t d) {
+        const std::string& dept = deptos[d]->first;
+        BufferEscrita saida(dept + "_relatorio_" + std::to_string(ano) + ".txt");
+        if (!saida.aberto()) {
+            semFicheiro[d] = 1;
+            return;
+        }
+
+        saida.escrever(CABECALHO_RELATORIO_DEPARTAMENTO);
+        for (size_t i : deptos[d]->second) {
+            escreverLinhaRelatorioDepartamento(saida, lista[i], ano);
+        }
+        CONTAR_EVENTO(Contador::LINHAS_EXPORTADAS, deptos[d]->second.size());
+        ++ficheirosCriados;
+    });
+    for (size_t d = 0; d < deptos.size(); ++d) {
+        if (!semFicheiro[d]) continue;
+        const std::string nome = deptos[d]->first + "_relatorio_" + std::to_string(ano) + ".txt";
+        std::cout << COR_VERMELHA << "ERRO: Nao foi possivel abrir o ficheiro " << nome << " para escrita.\n" << RESET_COR;
+    }
+    return ficheirosCriados;
+}
+
+void exportarDados(const std::vector<Colaborador>& lista, const PercorrerEmpresa& empresa) {
+    MEDIR_ESCOPO(Metrica::EXPORTAR_DADOS);
+    if (lista.empty() && !empresa) {
         std::cout << COR_AMARELA << "AVISO: Nao ha dados para exportar.\n" << RESET_COR;
         return;
     }
@@ -174,15 +398,34 @@ void exportarDados(const std::vector<Colaborador>& lista) {
     std::cout << COR_AZUL << "\n--- Exportacao de Dados ---\n" << RESET_COR;
     std::cout << "1. Exportar Calendario de um Colaborador\n";
     std::cout << "2. Exportar Relatorio de Departamento\n";
+    std::cout << "3. Exportar Ausencias de Todos os Colaboradores\n";
+    std::cout << "4. Exportar Relatorios de Todos os Departamentos\n";
     std::cout << COR_AMARELA << "Opcao: " << RESET_COR;
 
-    if (!(std::cin >> op) || (op != 1 && op != 2)) {
+    if (!(std::cin >> op) || op < 1 || op > 4) {
         std::cout << COR_VERMELHA << "Opcao invalida. A exportacao foi cancelada.\n" << RESET_COR;
         std::cin.clear(); std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         return;
     }
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
+    // O calendário guarda o dia do ano: as datas são exportadas para o ano atual ou,
+    // para um ano fechado, a partir do arquivo desse ano (arquivo.h)
+    int ano = obterAnoAtual();
+    std::string textoAno;
+    std::cout << "Ano (ENTER = " << ano << "): ";
+    std::getline(std::cin, textoAno);
+    if (!textoAno.empty()) {
+        try {
+            ano = std::stoi(textoAno);
+        } catch (const std::exception&) {
+            std::cout << COR_VERMELHA << "ERRO: Ano invalido. A exportacao foi cancelada.\n" << RESET_COR;
+            return;
+        }
+        if (ano < obterAnoAtual() && !anoArquivado(ano)) {
+            std::cout << COR_AMARELA << "AVISO: O ano " << ano << " nao esta arquivado; sao usadas as marcacoes atuais.\n" << RESET_COR;
+        }
+    }
 
     if (op == 1) { // Exportar Calendário de Colaborador
         std::string nome, nomeFicheiro;
@@ -197,34 +440,15 @@ void exportarDados(const std::vector<Colaborador>& lista) {
         const Colaborador& colab = lista[static_cast<size_t>(indice)];
 
         nomeFicheiro = colab.nome + "_calendario.txt";
-        std::ofstream ficheiro(nomeFicheiro);
-
-        ficheiro << "ID, Nome, Departamento, Data, Tipo_Marcacao\n";
-        for (const auto& par : colab.calendario) {
-            int chave = par.first; // YYYYMMDD
-            int ano = chave / 10000;
-            int mes = (chave % 10000) / 100;
-            int dia = chave % 100;
-            TipoMarcacao tipo = TipoMarcacao::LIVRE;
-            // Converter int de volta para TipoMarcacao
-            char tipo_char = ' ';
-            if (par.second == TipoMarcacao::FERIAS) tipo_char = 'F';
-            else if (par.second == TipoMarcacao::FALTA) tipo_char = 'X';
-            if (tipo_char != ' ') {
-                tipo = stringParaTipo(std::string(1, tipo_char));
+        {
+            BufferEscrita saida(nomeFicheiro);
+            if (!saida.aberto()) {
+                std::cout << COR_VERMELHA << "ERRO: Nao foi possivel abrir o ficheiro " << nomeFicheiro << " para escrita.\n" << RESET_COR;
+                return;
             }
-
-
-            std::string tipoMarcacao = (par.second == TipoMarcacao::FERIAS) ? "F" : "X";
-            ficheiro << colab.id << ","
-                     << colab.nome << ","
-                     << colab.departamento << ","
-                     << std::setw(2) << std::setfill('0') << dia << "/"
-                        << std::setw(2) << std::setfill('0') << mes << "/"
-                        << ano << ","
-                        << tipoMarcacao << "\n";
+            saida.escrever("ID, Nome, Departamento, Data, Tipo_Marcacao\n");
+            escreverAusenciasColaborador(saida, colab, ano);
         }
-        ficheiro.close();
         std::cout << COR_VERDE << "Calendario de " << colab.nome << " exportado para " << nomeFicheiro << "\n" << RESET_COR;
 
     } else if (op == 2) { // Exportar Relatório de Departamento
@@ -232,36 +456,47 @@ void exportarDados(const std::vector<Colaborador>& lista) {
         std::cout << "Nome do Departamento a exportar: ";
         std::getline(std::cin >> std::ws, dept);
 
-        // Obter o ano atual para a estatística
-        std::time_t t = std::time(nullptr);
-        std::tm* tm_local = std::localtime(&t);
-        int anoAtual = tm_local->tm_year + 1900;
-
-        std::string nomeFicheiro = dept + "_relatorio_" + std::to_string(anoAtual) + ".txt";
-        std::ofstream ficheiro(nomeFicheiro);
-
-        ficheiro << "Departamento, Nome, Ferias ao Ano, Faltas ao Ano, Dias Restantes de Ferias\n";
-
-        bool foundDept = false;
-        for (const auto& colab : lista) {
-            if (colab.departamento == dept) {
-                foundDept = true;
-                int total_ferias = 0;
-                int total_faltas = 0;
-                contarAusencias(colab, anoAtual, total_ferias, total_faltas);
-
-                ficheiro << colab.departamento << ","
-                         << colab.nome << ","
-                         << total_ferias << ","
-                         << total_faltas << ","
-                         << colab.dias_ferias_restantes << "\n";
+        const bool existeDept = std::any_of(lista.begin(), lista.end(),
+                                            [&](const Colaborador& colab) { return colab.departamento == dept; });
+        if (!existeDept) {
+            std::cout << COR_AMARELA << "AVISO: Nao foi encontrado o departamento '" << dept << "'. Exportacao cancelada.\n" << RESET_COR;
+            return;
+        }
+
+        std::string nomeFicheiro = dept + "_relatorio_" + std::to_string(ano) + ".txt";
+        {
+            BufferEscrita saida(nomeFicheiro);
+            if (!saida.aberto()) {
+                std::cout << COR_VERMELHA << "ERRO: Nao foi possivel abrir o ficheiro " << nomeFicheiro << " para escrita.\n" << RESET_COR;
+                return;
+            }
+            saida.escrever(CABECALHO_RELATORIO_DEPARTAMENTO);
+            for (const auto& colab : lista) {
+                if (colab.departamento == dept) escreverLinhaRelatorioDepartamento(saida, colab, ano);
             }
         }
-        ficheiro.close();
-        if (foundDept) {
-            std::cout << COR_VERDE << "Relatorio anual do departamento '" << dept << "' exportado para " << nomeFicheiro << "\n" << RESET_COR;
+        std::cout << COR_VERDE << "Relatorio anual do departamento '" << dept << "' exportado para " << nomeFicheiro << "\n" << RESET_COR;
+
+    } else if (op == 3) { // Exportar Ausências de toda a empresa
+        std::string nomeFicheiro = "ausencias_empresa_" + std::to_string(ano) + ".txt";
+        size_t colaboradores = 0;
+        PercorrerEmpresa percorrer = empresa ? empresa : [&](const VisitarParte& visitar) { visitar(lista); };
+        size_t linhas = exportarAusenciasEmpresaPorPartes([&](const VisitarParte& visitar) {
+            percorrer([&](const std::vector<Colaborador>& parte) {
+                colaboradores += parte.size();
+                visitar(parte);
+            });
+        }, ano, nomeFicheiro);
+        std::cout << COR_VERDE << linhas << " ausencias de " << colaboradores << " colaboradores exportadas para " << nomeFicheiro << "\n" << RESET_COR;
+
+    } else if (op == 4) { // Exportar Relatórios de todos os departamentos
+        // Com partes, cada parte é um departamento completo (um ficheiro por parte)
+        size_t ficheiros = 0;
+        if (empresa) {
+            empresa([&](const std::vector<Colaborador>& parte) { ficheiros += exportarRelatoriosDepartamentos(parte, ano); });
         } else {
-            std::cout << COR_AMARELA << "AVISO: Nao foi encontrado o departamento '" << dept << "'. Exportacao cancelada.\n" << RESET_COR;
+            ficheiros = exportarRelatoriosDepartamentos(lista, ano);
         }
+        std::cout << COR_VERDE << ficheiros << " relatorios de departamento exportados (ano " << ano << ").\n" << RESET_COR;
     }
 }
@@ -4,8 +4,15 @@
 // Inclui as dependências essenciais para as funções usarem os tipos Colaborador, etc.
 #include "colaborador.h" 
 #include "calendario.h" 
+#include "io.h"
 #include <vector>
 #include <string>
+#include <functional>
+
+// Percorre a empresa por partes, por exemplo um fragmento de departamento de cada vez
+// (ver fragmentos.h). Cada parte só é válida durante a chamada de 'visitar'.
+using VisitarParte = std::function<void(const std::vector<Colaborador>&)>;
+using PercorrerEmpresa = std::function<void(const VisitarParte&)>;
 
 // --- DECLARAÇÕES DE FUNÇÕES ---
 
@@ -17,9 +24,25 @@ void relatorioMensal(const std::vector<Colaborador>& lista);
 
 // Gera estatisticas de ausencias por departamento
 void estatisticasDepartamento(const std::vector<Colaborador>& lista);
+void estatisticasDepartamentoPorPartes(const PercorrerEmpresa& empresa);
+
+// Ausencias por departamento entre duas datas do mesmo ano (com reparticao por mes). 'indiceAtual'
+// e o indice do calendario em memoria; um ano fechado e contado a partir do arquivo.
+void relatorioAusenciasIntervalo(const PercorrerEmpresa& empresa, const IndiceAusencias& indiceAtual);
+
+// Menu para exportacao de dados (colaborador ou departamento).
+// Se 'empresa' for indicado, as exportacoes da empresa inteira (3 e 4) usam-no em vez da lista.
+void exportarDados(const std::vector<Colaborador>& lista, const PercorrerEmpresa& empresa = nullptr);
+
+// Escreve as ausencias datadas de um colaborador no buffer (retorna o numero de linhas)
+size_t escreverAusenciasColaborador(BufferEscrita& saida, const Colaborador& colab, int ano);
+
+// Exporta as ausencias datadas de todos os colaboradores (retorna o numero de linhas)
+size_t exportarAusenciasEmpresa(const std::vector<Colaborador>& lista, int ano, const std::string& nomeFicheiro);
+size_t exportarAusenciasEmpresaPorPartes(const PercorrerEmpresa& empresa, int ano, const std::string& nomeFicheiro);
 
-// Menu para exportacao de dados (colaborador ou departamento)
-void exportarDados(const std::vector<Colaborador>& lista);
+// Exporta um relatorio anual por departamento, em paralelo (retorna o numero de ficheiros)
+size_t exportarRelatoriosDepartamentos(const std::vector<Colaborador>& lista, int ano);
 
 
 #endif // REPORTS_H
\ No newline at end of file
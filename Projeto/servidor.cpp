@@ -0,0 +1,536 @@
+#include "servidor.h"
+#include "calendario.h"
+#include "io.h"
+#include "cores.h"
+#include "reports.h"
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <map>
+#include <algorithm>
+#include <cctype>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <csignal>
+#include <cstring>
+#endif
+
+const std::string SOCKET_POR_OMISSAO = "rh.sock";
+
+// ===============================================
+// AUXILIARES DO PROTOCOLO
+// ===============================================
+
+static std::vector<std::string> dividirCampos(const std::string& linha, char separador) {
+    std::vector<std::string> campos;
+    std::stringstream ss(linha);
+    std::string campo;
+    while (std::getline(ss, campo, separador)) {
+        campos.push_back(campo);
+    }
+    return campos;
+}
+
+static std::string respostaOk(const std::vector<std::string>& linhas = {}) {
+    std::string r = "OK " + std::to_string(linhas.size()) + "\n";
+    for (const auto& l : linhas) {
+        r += l;
+        r += '\n';
+    }
+    return r;
+}
+
+static std::string respostaErro(const std::string& mensagem) {
+    return "ERRO " + mensagem + "\n";
+}
+
+static std::mutex& shardDe(EstadoServidor& estado, int id) {
+    return estado.shards[static_cast<unsigned>(id) % NUM_SHARDS];
+}
+
+void reconstruirIndice(EstadoServidor& estado) {
+    SnapshotRoster snap = estado.roster.snapshot();
+    estado.indicePorId.clear();
+    estado.indicePorId.reserve(snap.size());
+    for (size_t i = 0; i < snap.size(); ++i) {
+        estado.indicePorId[snap[i].id] = i;
+    }
+}
+
+// Posição do colaborador pelo ID, ou -1 (chamar com o lock do roster, partilhado ou exclusivo)
+static long posicaoPorId(const EstadoServidor& estado, int id) {
+    auto it = estado.indicePorId.find(id);
+    return it == estado.indicePorId.end() ? -1 : static_cast<long>(it->second);
+}
+
+// Grava o roster no ficheiro de dados. As gravações esperam a sua vez (partilham o ficheiro
+// temporário) e o snapshot é tirado já com a vez, por isso a última gravação é a versão mais recente.
+static void guardarServidor(EstadoServidor& estado) {
+    std::lock_guard<std::mutex> lock(estado.mutexGravacao);
+    guardarDados(estado.roster.snapshot().copiarLista(), estado.ficheiroDados);
+}
+
+static std::string linhaColaborador(const Colaborador& c) {
+    return std::to_string(c.id) + ";" + c.nome + ";" + c.departamento + ";" + formatarDias(c.saldo_ferias);
+}
+
+static std::string paraMinusculas(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+
+static std::string mensagemResultado(ResultadoMarcacao r) {
+    switch (r) {
+        case ResultadoMarcacao::DATA_INVALIDA: return "Data invalida";
+        case ResultadoMarcacao::FIM_SEMANA: return "O dia e um Fim de Semana";
+        case ResultadoMarcacao::SEM_FERIAS: return "Nao ha dias de ferias restantes";
+        case ResultadoMarcacao::NAO_MARCADO: return "O dia nao estava marcado";
+        case ResultadoMarcacao::DURACAO_INVALIDA: return "Duracao invalida (1 a " + std::to_string(UNIDADES_POR_DIA) + " horas)";
+        default: return "";
+    }
+}
+
+// ===============================================
+// PROCESSAMENTO DE PEDIDOS
+// ===============================================
+
+std::string processarPedido(EstadoServidor& estado, const std::string& linha, bool& fecharLigacao) {
+    std::vector<std::string> campos = dividirCampos(linha, ';');
+    if (campos.empty()) return respostaErro("Pedido vazio");
+
+    std::string comando = campos[0];
+    std::transform(comando.begin(), comando.end(), comando.begin(), ::toupper);
+
+    try {
+        if (comando == "SAIR") {
+            fecharLigacao = true;
+            return respostaOk();
+        }
+
+        if (comando == "DESLIGAR") {
+            // O socket de escuta é fechado depois de a resposta ser enviada (ver atenderCliente)
+            fecharLigacao = true;
+            estado.aExecutar = false;
+            return respostaOk();
+        }
+
+        if (comando == "LISTAR") {
+            SnapshotRoster snap = estado.roster.snapshot();
+            std::vector<std::string> linhas;
+            linhas.reserve(snap.size());
+            snap.paraCada([&](const Colaborador& c) { linhas.push_back(linhaColaborador(c)); });
+            return respostaOk(linhas);
+        }
+
+        if (comando == "PROCURAR" && campos.size() == 2) {
+            const std::string& query = campos[1];
+            bool isID = !query.empty() && std::all_of(query.begin(), query.end(), ::isdigit);
+            SnapshotRoster snap;
+            long pos = -1;
+            {
+                std::shared_lock<std::shared_mutex> lock(estado.mutexRoster);
+                snap = estado.roster.snapshot();
+                if (isID) pos = posicaoPorId(estado, std::stoi(query));
+            }
+            if (pos >= 0) return respostaOk({linhaColaborador(snap[static_cast<size_t>(pos)])});
+
+            // Procurar por nome (parcial e insensível a maiúsculas/minúsculas), como encontrarColaborador
+            std::string queryLower = paraMinusculas(query);
+            for (size_t i = 0; i < snap.size(); ++i) {
+                if (paraMinusculas(snap[i].nome).find(queryLower) != std::string::npos) {
+                    return respostaOk({linhaColaborador(snap[i])});
+                }
+            }
+            return respostaErro("Colaborador nao encontrado");
+        }
+
+        if (comando == "CALENDARIO" && campos.size() == 4) {
+            int id = std::stoi(campos[1]), mes = std::stoi(campos[2]), ano = std::stoi(campos[3]);
+            if (!dataValida(1, mes, ano)) return respostaErro("Mes/Ano invalido");
+
+            RegistoColaborador c;
+            {
+                std::shared_lock<std::shared_mutex> lock(estado.mutexRoster);
+                long pos = posicaoPorId(estado, id);
+                if (pos < 0) return respostaErro("Colaborador nao encontrado");
+                c = estado.roster.snapshot().registo(static_cast<size_t>(pos));
+            }
+
+            std::vector<std::string> linhas;
+            int inicio = dataParaDiaDoAno(1, mes, ano);
+            auto it = c->calendario.lower_bound(inicio);
+            for (; it != c->calendario.end() && it->first < inicio + diasNoMes(mes, ano); ++it) {
+                if (temTipo(MASCARA_MARCAVEL, it->second)) {
+                    linhas.push_back(std::to_string(it->first - inicio + 1) + ";" + tipoParaString(it->second));
+                    // Dia parcial: as horas marcadas num terceiro campo
+                    auto parcial = c->parciais.find(it->first);
+                    if (parcial != c->parciais.end()) linhas.back() += ";" + std::to_string(parcial->second);
+                }
+            }
+            return respostaOk(linhas);
+        }
+
+        if ((comando == "MARCAR" && (campos.size() == 6 || campos.size() == 7)) || (comando == "DESMARCAR" && campos.size() == 5)) {
+            int id = std::stoi(campos[1]), dia = std::stoi(campos[2]), mes = std::stoi(campos[3]), ano = std::stoi(campos[4]);
+            int unidades = campos.size() == 7 ? std::stoi(campos[6]) : UNIDADES_POR_DIA;
+            TipoMarcacao tipo = comando == "MARCAR" ? stringParaTipo(campos[5]) : TipoMarcacao::LIVRE;
+            if (comando == "MARCAR" && tipo == TipoMarcacao::LIVRE) return respostaErro("Tipo invalido (" + legendaMarcacoes() + ")");
+
+            // O lock partilhado garante que as posições não mudam (adicionar/remover) durante a marcação
+            std::shared_lock<std::shared_mutex> lock(estado.mutexRoster);
+            long pos = posicaoPorId(estado, id);
+            if (pos < 0) return respostaErro("Colaborador nao encontrado");
+            size_t indice = static_cast<size_t>(pos);
+
+            // Marcações ao mesmo colaborador são feitas uma de cada vez
+            std::lock_guard<std::mutex> lockShard(shardDe(estado, id));
+            SnapshotRoster snap = estado.roster.snapshot();
+            const Colaborador& atual = snap[indice];
+
+            // Conflitos de férias: o índice diz se há colegas de férias no dia; só nesse caso
+            // o snapshot é percorrido para saber quem são (sem bloquear os colegas)
+            std::vector<std::string> avisos;
+            int diaDoAno = dataValida(dia, mes, ano) ? dataParaDiaDoAno(dia, mes, ano) : 0;
+            bool colegasDeFerias = false;
+            if (temTipo(MASCARA_FERIAS, tipo) && diaDoAno != 0) {
+                auto proprio = atual.calendario.find(diaDoAno);
+                int doProprio = proprio != atual.calendario.end() ? contaTipo(MASCARA_FERIAS, proprio->second) : 0;
+                std::lock_guard<std::mutex> lockAusencias(estado.mutexAusencias);
+                colegasDeFerias = estado.ausencias.feriasNoDia(atual.departamento, diaDoAno) > doProprio;
+            }
+            if (colegasDeFerias) {
+                snap.paraCada([&](const Colaborador& outro) {
+                    if (outro.id == id || outro.departamento != atual.departamento) return;
+                    auto it = outro.calendario.find(diaDoAno);
+                    if (it != outro.calendario.end() && temTipo(MASCARA_FERIAS, it->second)) {
+                        avisos.push_back("AVISO;conflito;" + outro.nome);
+                    }
+                });
+            }
+
+            // A verificação da cobertura mínima, a marcação e a atualização dos contadores são feitas
+            // sem largar o lock, para que duas ausências no mesmo departamento não passem as duas
+            std::lock_guard<std::mutex> lockAusencias(estado.mutexAusencias);
+            if (comando == "MARCAR" && diaDoAno != 0 && temTipo(MASCARA_AUSENCIA, tipo)) {
+                std::vector<ViolacaoCobertura> violacoes = estado.cobertura.verificarAusencia(atual, diaDoAno, diaDoAno, ano);
+                if (!violacoes.empty()) {
+                    // Férias são planeadas e podem ser recusadas; uma falta já aconteceu e fica só o aviso
+                    if (tipo == TipoMarcacao::FERIAS) return respostaErro("Cobertura minima: " + descreverViolacao(violacoes[0], ano));
+                    avisos.push_back("AVISO;cobertura;" + descreverViolacao(violacoes[0], ano));
+                }
+            }
+
+            // Copy-on-write: altera uma cópia do registo e publica a nova versão
+            Colaborador copia = atual;
+            ResultadoMarcacao r = comando == "MARCAR" ? aplicarMarcacao(copia, dia, mes, ano, tipo, unidades)
+                                                      : aplicarDesmarcacao(copia, dia, mes, ano);
+            if (r != ResultadoMarcacao::OK && r != ResultadoMarcacao::FIM_SEMANA) return respostaErro(mensagemResultado(r));
+            if (diaDoAno != 0) {
+                auto antes = atual.calendario.find(diaDoAno);
+                auto depois = copia.calendario.find(diaDoAno);
+                TipoMarcacao tipoAntes = antes == atual.calendario.end() ? TipoMarcacao::LIVRE : antes->second;
+                TipoMarcacao tipoDepois = depois == copia.calendario.end() ? TipoMarcacao::LIVRE : depois->second;
+                estado.ausencias.alterarDia(atual.departamento, diaDoAno, tipoAntes, tipoDepois, unidadesDoDia(atual, diaDoAno),
+                                            unidadesDoDia(copia, diaDoAno));
+                estado.cobertura.alterarDia(atual.departamento, diaDoAno, tipoAntes, tipoDepois);
+            }
+            estado.roster.substituir(indice, std::move(copia));
+            if (r == ResultadoMarcacao::FIM_SEMANA) return respostaErro(mensagemResultado(r));
+            return respostaOk(avisos);
+        }
+
+        if (comando == "ADICIONAR" && campos.size() == 3) {
+            if (campos[1].empty() || campos[2].empty()) return respostaErro("Nome e departamento obrigatorios");
+            std::unique_lock<std::shared_mutex> lock(estado.mutexRoster);
+            SnapshotRoster snap = estado.roster.snapshot();
+
+            Colaborador novoColab;
+            novoColab.nome = campos[1];
+            novoColab.departamento = campos[2];
+            int maxId = 0;
+            bool duplicado = false;
+            std::string nomeLower = paraMinusculas(novoColab.nome);
+            snap.paraCada([&](const Colaborador& c) {
+                maxId = std::max(maxId, c.id);
+                if (paraMinusculas(c.nome) == nomeLower) duplicado = true;
+            });
+            novoColab.id = maxId + 1;
+
+            std::vector<std::string> linhas;
+            if (duplicado) linhas.push_back("AVISO;duplicado;" + novoColab.nome);
+            linhas.push_back(linhaColaborador(novoColab));
+            {
+                std::lock_guard<std::mutex> lockAusencias(estado.mutexAusencias);
+                estado.cobertura.adicionarColaborador(novoColab);
+            }
+            estado.roster.adicionar(novoColab);
+            estado.indicePorId[novoColab.id] = snap.size();
+            return respostaOk(linhas);
+        }
+
+        if (comando == "REMOVER" && campos.size() == 2) {
+            int id = std::stoi(campos[1]);
+            std::unique_lock<std::shared_mutex> lock(estado.mutexRoster);
+            long pos = posicaoPorId(estado, id);
+            if (pos < 0) return respostaErro("Colaborador nao encontrado");
+            {
+                std::lock_guard<std::mutex> lockAusencias(estado.mutexAusencias);
+                const Colaborador& removido = estado.roster.snapshot()[static_cast<size_t>(pos)];
+                estado.ausencias.removerColaborador(removido);
+                estado.cobertura.removerColaborador(removido);
+            }
+            estado.roster.remover(static_cast<size_t>(pos));
+            reconstruirIndice(estado);
+            return respostaOk();
+        }
+
+        // Relatórios: trabalham sobre um snapshot, sem locks durante o varrimento
+        if (comando == "DASHBOARD" && campos.size() == 2) {
+            int ano = std::stoi(campos[1]);
+            SnapshotRoster snap = estado.roster.snapshot();
+            std::vector<std::string> linhas;
+            linhas.reserve(snap.size());
+            snap.paraCada([&](const Colaborador& c) {
+                int ferias = 0, faltas = 0;
+                contarAusencias(c, ano, ferias, faltas);
+                linhas.push_back(c.nome + ";" + formatarDias(ferias) + ";" + formatarDias(faltas) + ";" +
+                                 formatarDias(c.saldo_ferias) + ";" + c.departamento);
+            });
+            return respostaOk(linhas);
+        }
+
+        if (comando == "RELATORIO_MENSAL" && campos.size() == 3) {
+            int mes = std::stoi(campos[1]), ano = std::stoi(campos[2]);
+            if (!dataValida(1, mes, ano)) return respostaErro("Mes/Ano invalido");
+            SnapshotRoster snap = estado.roster.snapshot();
+            std::vector<std::string> linhas;
+            linhas.reserve(snap.size());
+            snap.paraCada([&](const Colaborador& c) {
+                int ferias = 0, faltas = 0;
+                contarAusenciasMes(c, mes, ano, ferias, faltas);
+                linhas.push_back(c.nome + ";" + formatarDias(ferias) + ";" + formatarDias(faltas));
+            });
+            return respostaOk(linhas);
+        }
+
+        if (comando == "ESTATISTICAS" && campos.size() == 2) {
+            int ano = std::stoi(campos[1]);
+            std::map<std::string, std::pair<int, int>> stats;
+            estado.roster.snapshot().paraCada([&](const Colaborador& c) {
+                int ferias = 0, faltas = 0;
+                contarAusencias(c, ano, ferias, faltas);
+                stats[c.departamento].first += ferias;
+                stats[c.departamento].second += faltas;
+            });
+            std::vector<std::string> linhas;
+            for (const auto& par : stats) {
+                linhas.push_back(par.first + ";" + formatarDias(par.second.first) + ";" +
+                                 formatarDias(par.second.second) + ";" + formatarDias(par.second.first + par.second.second));
+            }
+            return respostaOk(linhas);
+        }
+
+        if (comando == "AUSENCIAS" && campos.size() == 6) {
+            int diaInicio = std::stoi(campos[1]), mesInicio = std::stoi(campos[2]);
+            int diaFim = std::stoi(campos[3]), mesFim = std::stoi(campos[4]), ano = std::stoi(campos[5]);
+            if (!dataValida(diaInicio, mesInicio, ano) || !dataValida(diaFim, mesFim, ano)) return respostaErro("Data invalida");
+            int inicio = dataParaDiaDoAno(diaInicio, mesInicio, ano), fim = dataParaDiaDoAno(diaFim, mesFim, ano);
+            if (inicio > fim) return respostaErro("A data inicial e posterior a data final");
+
+            std::vector<std::string> linhas;
+            std::lock_guard<std::mutex> lockAusencias(estado.mutexAusencias);
+            for (const auto& par : estado.ausencias.porDepartamento) {
+                int ferias = 0, faltas = 0;
+                estado.ausencias.contarIntervalo(par.first, inicio, fim, ferias, faltas);
+                linhas.push_back(par.first + ";" + std::to_string(ferias) + ";" + std::to_string(faltas) + ";" +
+                                 std::to_string(ferias + faltas));
+            }
+            return respostaOk(linhas);
+        }
+
+        // Capacidade restante de um departamento em cada dia do mês: dia;presentes;capacidade
+        if (comando == "COBERTURA" && campos.size() == 4) {
+            int mes = std::stoi(campos[2]), ano = std::stoi(campos[3]);
+            if (!dataValida(1, mes, ano)) return respostaErro("Mes/Ano invalido");
+            std::vector<std::string> linhas;
+            std::lock_guard<std::mutex> lockAusencias(estado.mutexAusencias);
+            if (estado.cobertura.colaboradores(campos[1]) == 0) return respostaErro("Departamento sem colaboradores");
+            linhas.push_back("MINIMO;" + std::to_string(estado.cobertura.minimoDe(campos[1])));
+            for (int dia = 1; dia <= diasNoMes(mes, ano); ++dia) {
+                int diaDoAno = dataParaDiaDoAno(dia, mes, ano);
+                linhas.push_back(std::to_string(dia) + ";" + std::to_string(estado.cobertura.presentes(campos[1], diaDoAno)) + ";" +
+                                 std::to_string(estado.cobertura.capacidadeRestante(campos[1], diaDoAno, ano)));
+            }
+            return respostaOk(linhas);
+        }
+
+        if (comando == "MINIMO" && campos.size() == 3) {
+            int minimo = std::stoi(campos[2]);
+            if (campos[1].empty() || minimo < 0) return respostaErro("Departamento e minimo (>= 0) obrigatorios");
+            std::lock_guard<std::mutex> lockAusencias(estado.mutexAusencias);
+            estado.cobertura.definirMinimo(campos[1], minimo);
+            if (!estado.cobertura.gravarRegras(FICHEIRO_COBERTURA)) return respostaErro("Nao foi possivel gravar " + FICHEIRO_COBERTURA);
+            return respostaOk();
+        }
+
+        if (comando == "EXPORTAR" && campos.size() == 2) {
+            int ano = std::stoi(campos[1]);
+            SnapshotRoster snap = estado.roster.snapshot();
+            std::string nomeFicheiro = "ausencias_empresa_" + std::to_string(ano) + ".txt";
+            BufferEscrita saida(nomeFicheiro);
+            if (!saida.aberto()) return respostaErro("Nao foi possivel abrir " + nomeFicheiro);
+            saida.escrever("ID, Nome, Departamento, Data, Tipo_Marcacao\n");
+            size_t linhas = 0;
+            snap.paraCada([&](const Colaborador& c) { linhas += escreverAusenciasColaborador(saida, c, ano); });
+            return respostaOk({nomeFicheiro + ";" + std::to_string(linhas) + ";versao " + std::to_string(snap.versao())});
+        }
+
+        if (comando == "GUARDAR") {
+            guardarServidor(estado);
+            return respostaOk();
+        }
+    } catch (const std::exception& e) {
+        return respostaErro(std::string("Argumento invalido: ") + e.what());
+    }
+
+    return respostaErro("Comando desconhecido ou numero de campos errado: " + campos[0]);
+}
+
+// ===============================================
+// SOCKET
+// ===============================================
+
+#ifdef _WIN32
+
+int executarServidor(const std::string&, const std::string&) {
+    std::cerr << COR_VERMELHA << "ERRO: O modo servidor (socket Unix) nao esta disponivel em Windows.\n" << RESET_COR;
+    return 1;
+}
+
+#else
+
+// Envia todos os bytes (o send pode escrever só uma parte)
+static bool enviarTudo(int fd, const std::string& dados) {
+    size_t enviado = 0;
+    while (enviado < dados.size()) {
+        ssize_t n = ::send(fd, dados.data() + enviado, dados.size() - enviado, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        enviado += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Atende um cliente até SAIR/DESLIGAR ou até a ligação fechar
+static void atenderCliente(EstadoServidor& estado, int fd) {
+    std::string pendente;
+    char buffer[4096];
+    bool fechar = false;
+
+    while (!fechar) {
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        pendente.append(buffer, static_cast<size_t>(n));
+
+        size_t pos;
+        while (!fechar && (pos = pendente.find('\n')) != std::string::npos) {
+            std::string linha = pendente.substr(0, pos);
+            pendente.erase(0, pos + 1);
+            if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+            if (linha.empty()) continue;
+            if (!enviarTudo(fd, processarPedido(estado, linha, fechar))) {
+                fechar = true;
+            }
+        }
+    }
+
+    // Pedido DESLIGAR: desbloqueia o accept() do ciclo principal
+    if (!estado.aExecutar) {
+        int escuta = estado.fdEscuta.exchange(-1);
+        if (escuta >= 0) {
+            ::shutdown(escuta, SHUT_RDWR);
+            ::close(escuta);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(estado.mutexClientes);
+        estado.fdsClientes.erase(fd);
+        if (estado.fdsClientes.empty()) estado.semClientes.notify_all();
+    }
+    ::close(fd);
+}
+
+int executarServidor(const std::string& caminhoSocket, const std::string& ficheiroDados) {
+    EstadoServidor estado;
+    estado.ficheiroDados = ficheiroDados;
+    {
+        std::vector<Colaborador> lista;
+        carregarDados(lista, ficheiroDados);
+        estado.roster.reiniciar(lista);
+        estado.ausencias.construir(lista);
+        estado.cobertura.lerRegras(FICHEIRO_COBERTURA);
+        estado.cobertura.construir(lista);
+    }
+    reconstruirIndice(estado);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel criar o socket.\n" << RESET_COR;
+        return 1;
+    }
+
+    sockaddr_un endereco;
+    std::memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (caminhoSocket.size() >= sizeof(endereco.sun_path)) {
+        std::cerr << COR_VERMELHA << "ERRO: Caminho do socket demasiado longo.\n" << RESET_COR;
+        ::close(fd);
+        return 1;
+    }
+    std::strncpy(endereco.sun_path, caminhoSocket.c_str(), sizeof(endereco.sun_path) - 1);
+    ::unlink(caminhoSocket.c_str()); // Remove um socket antigo que tenha ficado para trás
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) < 0 || ::listen(fd, 64) < 0) {
+        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel escutar em " << caminhoSocket << ": " << std::strerror(errno) << "\n" << RESET_COR;
+        ::close(fd);
+        return 1;
+    }
+    estado.fdEscuta = fd;
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::cout << COR_VERDE << "[INFO] Servidor RH a escutar em " << caminhoSocket << " (" << estado.roster.snapshot().size() << " colaboradores).\n" << RESET_COR;
+
+    while (estado.aExecutar) {
+        int escuta = estado.fdEscuta.load();
+        if (escuta < 0) break;
+        int cliente = ::accept(escuta, nullptr, nullptr);
+        if (cliente < 0) {
+            if (errno == EINTR) continue;
+            break; // Socket de escuta fechado (DESLIGAR)
+        }
+        {
+            std::lock_guard<std::mutex> lock(estado.mutexClientes);
+            estado.fdsClientes.insert(cliente);
+        }
+        std::thread(atenderCliente, std::ref(estado), cliente).detach();
+    }
+
+    int restante = estado.fdEscuta.exchange(-1);
+    if (restante >= 0) ::close(restante);
+    ::unlink(caminhoSocket.c_str());
+
+    // Fechar as ligações que ainda estão abertas e esperar que as threads terminem
+    {
+        std::unique_lock<std::mutex> lock(estado.mutexClientes);
+        for (int c : estado.fdsClientes) ::shutdown(c, SHUT_RDWR);
+        estado.semClientes.wait(lock, [&] { return estado.fdsClientes.empty(); });
+    }
+
+    guardarServidor(estado);
+    std::cout << COR_VERDE << "[INFO] Servidor terminado.\n" << RESET_COR;
+    return 0;
+}
+
+#endif
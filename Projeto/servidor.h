@@ -0,0 +1,84 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include "colaborador.h"
+#include "snapshot.h"
+#include "ausencias.h"
+#include "cobertura.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <set>
+
+// ===============================================
+// MODO SERVIDOR (DAEMON) - SOCKET UNIX LOCAL
+// ===============================================
+// O roster fica em memória num único processo e vários operadores ligam-se com o cliente.
+//
+// Protocolo (uma linha por pedido, campos separados por ';'):
+//   PROCURAR;<nome ou id>            LISTAR
+//   CALENDARIO;<id>;<mes>;<ano>      MARCAR;<id>;<dia>;<mes>;<ano>;<tipo>[;<horas>]
+//   DESMARCAR;<id>;<dia>;<mes>;<ano> ADICIONAR;<nome>;<departamento>
+//   REMOVER;<id>                     DASHBOARD;<ano>
+//   RELATORIO_MENSAL;<mes>;<ano>     ESTATISTICAS;<ano>
+//   EXPORTAR;<ano>                   GUARDAR
+//   AUSENCIAS;<dia>;<mes>;<dia>;<mes>;<ano> (por departamento, entre as duas datas)
+//   COBERTURA;<departamento>;<mes>;<ano> MINIMO;<departamento>;<minimo> (0 remove a regra)
+//   SAIR (fecha a ligação)
+//   DESLIGAR (guarda e termina o servidor)
+//   <tipo> é o símbolo de um tipo marcável de marcacoes.h (F, X, B, C, T ou P); <horas> (1 a 7)
+//   marca só parte do dia. Os dias e saldos das respostas podem ter casas decimais ("21.5").
+// Resposta: "OK <n>" seguido de n linhas de dados, ou "ERRO <mensagem>".
+//
+// Concorrência: pesquisas, calendários, relatórios, exportações e gravações trabalham sobre um
+// snapshot (RosterCOW) e nunca bloqueiam nem são bloqueados pelas marcações. As gravações (GUARDAR
+// e a do fim) escrevem todas no mesmo ficheiro temporário, por isso esperam a sua vez no mutexGravacao
+// e tiram o snapshot já com ele, para que uma versão antiga nunca substitua uma mais recente. Marcações ao mesmo
+// colaborador são serializadas pela sua "shard" (id % NUM_SHARDS) e publicam uma nova versão do
+// registo. Adicionar/remover usam o lock exclusivo do roster (mudam as posições e o índice).
+// O índice de ausências por departamento (ausencias.h) é atualizado a cada marcação; serve as
+// contagens por intervalo e evita percorrer o roster na verificação de conflitos sem colegas de férias.
+// Com uma regra de cobertura mínima (cobertura.h), MARCAR recusa férias que deixem o departamento
+// abaixo do mínimo; uma falta é marcada na mesma, com a linha "AVISO;cobertura;...".
+
+const int NUM_SHARDS = 64;
+
+// Caminho por omissão do socket (relativo à pasta atual, como o rh_data.txt)
+extern const std::string SOCKET_POR_OMISSAO;
+
+struct EstadoServidor {
+    RosterCOW roster;
+    std::unordered_map<int, size_t> indicePorId; // id -> posição no roster
+    std::string ficheiroDados;
+
+    IndiceAusencias ausencias;
+    MotorCobertura cobertura;   // Protegido também por mutexAusencias
+    std::mutex mutexAusencias;
+
+    std::shared_mutex mutexRoster;
+    std::mutex shards[NUM_SHARDS];
+    std::mutex mutexGravacao; // Uma gravação do ficheiro de dados de cada vez
+    std::atomic<bool> aExecutar{true};
+    std::atomic<int> fdEscuta{-1}; // Socket de escuta (fechado pelo DESLIGAR)
+
+    // Ligações abertas (para as fechar e esperar por elas ao desligar)
+    std::mutex mutexClientes;
+    std::condition_variable semClientes;
+    std::set<int> fdsClientes;
+};
+
+// Reconstrói o índice id -> posição (chamar com o lock exclusivo)
+void reconstruirIndice(EstadoServidor& estado);
+
+// Processa um pedido do protocolo e devolve a resposta completa (com "\n" no fim).
+// fecharLigacao fica a true quando o cliente pede SAIR ou DESLIGAR.
+std::string processarPedido(EstadoServidor& estado, const std::string& linha, bool& fecharLigacao);
+
+// Carrega os dados e serve pedidos no socket até receber DESLIGAR. Retorna o código de saída.
+int executarServidor(const std::string& caminhoSocket, const std::string& ficheiroDados);
+
+#endif // SERVIDOR_H
@@ -0,0 +1,91 @@
+#include "snapshot.h"
+#include <algorithm>
+
+std::vector<Colaborador> SnapshotRoster::copiarLista() const {
+    std::vector<Colaborador> lista;
+    lista.reserve(size());
+    paraCada([&](const Colaborador& c) { lista.push_back(c); });
+    return lista;
+}
+
+// Agrupa os registos em blocos de TAMANHO_BLOCO_SNAPSHOT
+static std::shared_ptr<RaizRoster> construirRaiz(const std::vector<RegistoColaborador>& registos, uint64_t versao) {
+    auto raiz = std::make_shared<RaizRoster>();
+    raiz->tamanho = registos.size();
+    raiz->versao = versao;
+    for (size_t inicio = 0; inicio < registos.size(); inicio += TAMANHO_BLOCO_SNAPSHOT) {
+        size_t fim = std::min(registos.size(), inicio + TAMANHO_BLOCO_SNAPSHOT);
+        raiz->blocos.push_back(std::make_shared<const BlocoRegistos>(registos.begin() + static_cast<std::ptrdiff_t>(inicio),
+                                                                      registos.begin() + static_cast<std::ptrdiff_t>(fim)));
+    }
+    return raiz;
+}
+
+void RosterCOW::reiniciar(const std::vector<Colaborador>& lista) {
+    std::vector<RegistoColaborador> registos;
+    registos.reserve(lista.size());
+    for (const auto& c : lista) registos.push_back(std::make_shared<const Colaborador>(c));
+    auto nova = construirRaiz(registos, 1);
+
+    std::lock_guard<std::mutex> lock(mutexRaiz);
+    nova->versao = raiz ? raiz->versao + 1 : 1;
+    publicar(std::move(nova));
+}
+
+SnapshotRoster RosterCOW::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutexRaiz);
+    return SnapshotRoster{raiz};
+}
+
+void RosterCOW::publicar(std::shared_ptr<RaizRoster> nova) {
+    // Chamado com mutexRaiz bloqueado
+    raiz = std::move(nova);
+}
+
+void RosterCOW::substituir(size_t indice, Colaborador novo) {
+    // O novo registo é criado fora da secção crítica
+    RegistoColaborador registo = std::make_shared<const Colaborador>(std::move(novo));
+
+    std::lock_guard<std::mutex> lock(mutexRaiz);
+    if (indice >= raiz->tamanho) return;
+
+    // Cópia rasa da raiz (só ponteiros para blocos) e do bloco afetado
+    auto nova = std::make_shared<RaizRoster>(*raiz);
+    nova->versao++;
+    size_t b = indice / TAMANHO_BLOCO_SNAPSHOT;
+    auto bloco = std::make_shared<BlocoRegistos>(*nova->blocos[b]);
+    (*bloco)[indice % TAMANHO_BLOCO_SNAPSHOT] = std::move(registo);
+    nova->blocos[b] = std::move(bloco);
+    publicar(std::move(nova));
+}
+
+void RosterCOW::adicionar(Colaborador novo) {
+    RegistoColaborador registo = std::make_shared<const Colaborador>(std::move(novo));
+
+    std::lock_guard<std::mutex> lock(mutexRaiz);
+    auto nova = std::make_shared<RaizRoster>(*raiz);
+    nova->versao++;
+    if (nova->tamanho % TAMANHO_BLOCO_SNAPSHOT == 0) {
+        nova->blocos.push_back(std::make_shared<const BlocoRegistos>(1, std::move(registo)));
+    } else {
+        auto bloco = std::make_shared<BlocoRegistos>(*nova->blocos.back());
+        bloco->push_back(std::move(registo));
+        nova->blocos.back() = std::move(bloco);
+    }
+    nova->tamanho++;
+    publicar(std::move(nova));
+}
+
+void RosterCOW::remover(size_t indice) {
+    std::lock_guard<std::mutex> lock(mutexRaiz);
+    if (indice >= raiz->tamanho) return;
+
+    // Os registos continuam partilhados, só os blocos de ponteiros são refeitos
+    std::vector<RegistoColaborador> registos;
+    registos.reserve(raiz->tamanho - 1);
+    SnapshotRoster atual{raiz};
+    for (size_t i = 0; i < atual.size(); ++i) {
+        if (i != indice) registos.push_back(atual.registo(i));
+    }
+    publicar(construirRaiz(registos, raiz->versao + 1));
+}
@@ -0,0 +1,87 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "colaborador.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+// ===============================================
+// SNAPSHOTS DO ROSTER (COPY-ON-WRITE)
+// ===============================================
+// Cada colaborador é um registo imutável partilhado (shared_ptr<const Colaborador>).
+// Os registos estão agrupados em blocos de TAMANHO_BLOCO_SNAPSHOT ponteiros.
+// Uma alteração copia só o registo alterado, o seu bloco e a raiz (lista de blocos).
+// Um snapshot é apenas uma cópia do ponteiro da raiz, por isso custa O(1). Continua válido e
+// inalterado enquanto existir, mesmo que o roster seja alterado a seguir.
+
+const size_t TAMANHO_BLOCO_SNAPSHOT = 1024;
+
+using RegistoColaborador = std::shared_ptr<const Colaborador>;
+using BlocoRegistos = std::vector<RegistoColaborador>;
+
+// Versão do roster num dado instante
+struct RaizRoster {
+    std::vector<std::shared_ptr<const BlocoRegistos>> blocos;
+    size_t tamanho = 0;
+    uint64_t versao = 0;
+};
+
+// Vista imutável e consistente do roster
+struct SnapshotRoster {
+    std::shared_ptr<const RaizRoster> raiz;
+
+    size_t size() const { return raiz ? raiz->tamanho : 0; }
+    bool empty() const { return size() == 0; }
+    uint64_t versao() const { return raiz ? raiz->versao : 0; }
+
+    const Colaborador& operator[](size_t i) const {
+        return *(*raiz->blocos[i / TAMANHO_BLOCO_SNAPSHOT])[i % TAMANHO_BLOCO_SNAPSHOT];
+    }
+    RegistoColaborador registo(size_t i) const {
+        return (*raiz->blocos[i / TAMANHO_BLOCO_SNAPSHOT])[i % TAMANHO_BLOCO_SNAPSHOT];
+    }
+
+    // Percorre todos os colaboradores pela ordem da lista
+    template <typename F>
+    void paraCada(F&& f) const {
+        if (!raiz) return;
+        for (const auto& bloco : raiz->blocos) {
+            for (const auto& registo : *bloco) f(*registo);
+        }
+    }
+
+    // Cópia completa para um vetor (ex: para guardarDados)
+    std::vector<Colaborador> copiarLista() const;
+};
+
+// Roster com publicação de versões. Leitores tiram snapshots sem bloquear os escritores;
+// escritores só ficam em exclusão mútua durante a cópia do bloco e a publicação da raiz.
+struct RosterCOW {
+    RosterCOW() : raiz(std::make_shared<RaizRoster>()) {}
+    explicit RosterCOW(const std::vector<Colaborador>& lista) { reiniciar(lista); }
+
+    // Substitui todo o conteúdo (ex: depois de carregar o ficheiro)
+    void reiniciar(const std::vector<Colaborador>& lista);
+
+    // Vista atual (O(1))
+    SnapshotRoster snapshot() const;
+
+    // Substitui o registo na posição indicada por uma nova versão
+    void substituir(size_t indice, Colaborador novo);
+
+    // Acrescenta um colaborador no fim
+    void adicionar(Colaborador novo);
+
+    // Remove o colaborador na posição indicada (reconstrói os blocos, operação rara)
+    void remover(size_t indice);
+
+private:
+    void publicar(std::shared_ptr<RaizRoster> nova);
+
+    mutable std::mutex mutexRaiz;
+    std::shared_ptr<const RaizRoster> raiz;
+};
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,355 @@
+#include "validades.h"
+#include "formacoes.h"
+#include "calendario.h"
+#include "io.h"
+#include "cores.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <unordered_set>
+
+const std::string FICHEIRO_VALIDADES = "rh_validades.txt";
+const std::string FICHEIRO_RENOVACOES = "renovacoes.csv";
+
+static uint64_t chaveFormacao(int idColaborador, int idCurso) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(idColaborador)) << 32) | static_cast<uint32_t>(idCurso);
+}
+
+static std::string textoSerial(int serial) {
+    int dia = 0, mes = 0, ano = 0;
+    serialParaData(serial, dia, mes, ano);
+    std::ostringstream texto;
+    texto << std::setw(2) << std::setfill('0') << dia << "/" << std::setw(2) << mes << "/" << ano;
+    return texto.str();
+}
+
+// ===============================================
+// REGRAS
+// ===============================================
+
+bool MotorValidades::lerRegras(const std::string& nomeFicheiro) {
+    std::ifstream ficheiro(nomeFicheiro);
+    if (!ficheiro.is_open()) return false;
+
+    regras.clear();
+    std::string linha;
+    while (std::getline(ficheiro, linha)) {
+        size_t separador = linha.rfind(';');
+        if (linha.empty() || separador == std::string::npos) continue;
+        try {
+            int meses = std::stoi(linha.substr(separador + 1));
+            if (meses > 0) definirValidade(linha.substr(0, separador), meses);
+        } catch (const std::exception&) {
+            std::cerr << COR_AMARELA << "[AVISO] Regra de validade invalida ignorada: " << linha << "\n" << RESET_COR;
+        }
+    }
+    return true;
+}
+
+bool MotorValidades::gravarRegras(const std::string& nomeFicheiro) const {
+    const std::string temporario = nomeFicheiro + ".tmp";
+    {
+        std::ofstream ficheiro(temporario);
+        if (!ficheiro.is_open()) return false;
+        for (const auto& par : regras) {
+            ficheiro << par.second.curso << ";" << par.second.meses << "\n";
+        }
+        if (!ficheiro) return false;
+    }
+    return publicarFicheiro(temporario, nomeFicheiro);
+}
+
+void MotorValidades::definirValidade(const std::string& curso, int meses) {
+    std::string chave = chaveCurso(curso);
+    if (meses <= 0) {
+        regras.erase(chave);
+    } else if (!chave.empty()) {
+        regras[chave] = {curso, meses};
+    }
+}
+
+int MotorValidades::mesesDe(const std::string& curso) const {
+    auto it = regras.find(chaveCurso(curso));
+    return it == regras.end() ? 0 : it->second.meses;
+}
+
+// ===============================================
+// HEAP DE EXPIRAÇÕES
+// ===============================================
+
+bool MotorValidades::valida(const EntradaHeap& entrada) const {
+    auto it = atuais.find(entrada.chave);
+    return it != atuais.end() && it->second.versao == entrada.versao;
+}
+
+void MotorValidades::empilhar(const EntradaHeap& entrada) {
+    size_t i = heap.size();
+    heap.push_back(entrada);
+    while (i > 0) {
+        size_t pai = (i - 1) / 2;
+        if (heap[pai].expira <= heap[i].expira) break;
+        std::swap(heap[pai], heap[i]);
+        i = pai;
+    }
+}
+
+// Tira as entradas obsoletas e refaz o heap (descer cada nó interno, do último para a raiz)
+void MotorValidades::compactar() {
+    heap.erase(std::remove_if(heap.begin(), heap.end(), [this](const EntradaHeap& e) { return !valida(e); }), heap.end());
+    for (size_t inicio = heap.size() / 2; inicio-- > 0;) {
+        size_t i = inicio;
+        while (true) {
+            size_t menor = i, esquerdo = 2 * i + 1, direito = 2 * i + 2;
+            if (esquerdo < heap.size() && heap[esquerdo].expira < heap[menor].expira) menor = esquerdo;
+            if (direito < heap.size() && heap[direito].expira < heap[menor].expira) menor = direito;
+            if (menor == i) break;
+            std::swap(heap[i], heap[menor]);
+            i = menor;
+        }
+    }
+    obsoletas = 0;
+}
+
+void MotorValidades::construir(const std::vector<Colaborador>& lista) {
+    heap.clear();
+    atuais.clear();
+    obsoletas = 0;
+    for (const auto& colab : lista) {
+        for (const auto& formacao : colab.formacoes) registar(colab, formacao);
+    }
+}
+
+void MotorValidades::registar(const Colaborador& colab, const Formacao& formacao) {
+    const int meses = mesesDe(formacao.nome_curso);
+    const int conclusao = dataTextoParaSerial(formacao.data_conclusao);
+    if (meses == 0 || conclusao == SERIAL_INVALIDO) {
+        retirar(colab.id, formacao.id_curso); // Pode ter deixado de expirar depois de editada
+        return;
+    }
+
+    EntradaHeap entrada;
+    entrada.expira = somarMeses(conclusao, meses);
+    entrada.versao = ++proximaVersao;
+    entrada.chave = chaveFormacao(colab.id, formacao.id_curso);
+    auto [it, nova] = atuais.try_emplace(entrada.chave);
+    if (!nova) ++obsoletas;
+    it->second = {entrada.expira, entrada.versao};
+    empilhar(entrada);
+    if (obsoletas >= 1024 && obsoletas > atuais.size()) compactar();
+}
+
+void MotorValidades::retirar(int idColaborador, int idCurso) {
+    if (atuais.erase(chaveFormacao(idColaborador, idCurso)) == 0) return;
+    ++obsoletas;
+    if (obsoletas >= 1024 && obsoletas > atuais.size()) compactar();
+}
+
+void MotorValidades::retirarColaborador(const Colaborador& colab) {
+    for (const auto& formacao : colab.formacoes) retirar(colab.id, formacao.id_curso);
+}
+
+std::vector<Vencimento> MotorValidades::expiramAte(int limite) const {
+    std::vector<Vencimento> resultado;
+    std::vector<size_t> pendentes;
+    if (!heap.empty()) pendentes.push_back(0);
+    while (!pendentes.empty()) {
+        size_t i = pendentes.back();
+        pendentes.pop_back();
+        if (heap[i].expira > limite) continue; // Toda a subárvore expira depois do limite
+
+        if (valida(heap[i])) {
+            resultado.push_back({static_cast<int>(heap[i].chave >> 32), static_cast<int>(heap[i].chave & 0xFFFFFFFFu), heap[i].expira});
+        }
+        if (2 * i + 1 < heap.size()) pendentes.push_back(2 * i + 1);
+        if (2 * i + 2 < heap.size()) pendentes.push_back(2 * i + 2);
+    }
+    std::sort(resultado.begin(), resultado.end(), [](const Vencimento& a, const Vencimento& b) {
+        if (a.expira != b.expira) return a.expira < b.expira;
+        return a.idColaborador != b.idColaborador ? a.idColaborador < b.idColaborador : a.idCurso < b.idCurso;
+    });
+    return resultado;
+}
+
+// ===============================================
+// GANCHOS DO CRUD
+// ===============================================
+
+static MotorValidades* motorAtivo = nullptr;
+
+void ativarMotorValidades(MotorValidades* motor) {
+    motorAtivo = motor;
+}
+
+void registarFormacao(const Colaborador& colab, const Formacao& formacao) {
+    if (motorAtivo != nullptr) motorAtivo->registar(colab, formacao);
+}
+
+void retirarFormacao(const Colaborador& colab, int idCurso) {
+    if (motorAtivo != nullptr) motorAtivo->retirar(colab.id, idCurso);
+}
+
+void retirarFormacoesColaborador(const Colaborador& colab) {
+    if (motorAtivo != nullptr) motorAtivo->retirarColaborador(colab);
+}
+
+// ===============================================
+// APRESENTAÇÃO, EXPORTAÇÃO E MENU
+// ===============================================
+
+// Colaborador e formação de cada vencimento (uma passagem pela lista)
+struct LinhaRenovacao {
+    const Colaborador* colab = nullptr;
+    const Formacao* formacao = nullptr;
+    int expira = 0;
+};
+
+static std::vector<LinhaRenovacao> linhasRenovacao(const std::vector<Vencimento>& vencimentos, const std::vector<Colaborador>& lista) {
+    std::unordered_set<int> ids;
+    for (const auto& v : vencimentos) ids.insert(v.idColaborador);
+    std::unordered_map<int, const Colaborador*> colaboradores;
+    for (const auto& colab : lista) {
+        if (ids.count(colab.id) != 0) colaboradores[colab.id] = &colab;
+    }
+
+    std::vector<LinhaRenovacao> linhas;
+    linhas.reserve(vencimentos.size());
+    for (const auto& v : vencimentos) {
+        auto it = colaboradores.find(v.idColaborador);
+        if (it == colaboradores.end()) continue;
+        const auto& formacoes = it->second->formacoes;
+        auto f = std::find_if(formacoes.begin(), formacoes.end(), [&](const Formacao& x) { return x.id_curso == v.idCurso; });
+        if (f != formacoes.end()) linhas.push_back({it->second, &*f, v.expira});
+    }
+    return linhas;
+}
+
+bool exportarRenovacoesCSV(const std::vector<Vencimento>& vencimentos, const std::vector<Colaborador>& lista,
+                           const std::string& nomeFicheiro) {
+    BufferEscrita saida(nomeFicheiro);
+    if (!saida.aberto()) return false;
+
+    const int hoje = serialHoje();
+    saida.escrever("ID,Nome,Departamento,Curso,Conclusao,Expira,Dias\n");
+    for (const auto& linha : linhasRenovacao(vencimentos, lista)) {
+        int dia = 0, mes = 0, ano = 0;
+        serialParaData(linha.expira, dia, mes, ano);
+        saida.escreverInt(linha.colab->id);
+        saida.escreverChar(',');
+        saida.escrever(linha.colab->nome);
+        saida.escreverChar(',');
+        saida.escrever(linha.colab->departamento);
+        saida.escreverChar(',');
+        saida.escrever(linha.formacao->nome_curso);
+        saida.escreverChar(',');
+        saida.escrever(linha.formacao->data_conclusao);
+        saida.escreverChar(',');
+        saida.escreverData(dia, mes, ano);
+        saida.escreverChar(',');
+        saida.escreverInt(linha.expira - hoje);
+        saida.escreverChar('\n');
+    }
+    return true;
+}
+
+static void mostrarRenovacoes(const std::vector<Vencimento>& vencimentos, const std::vector<Colaborador>& lista, size_t limite) {
+    if (vencimentos.empty()) {
+        std::cout << COR_VERDE << "Nenhuma formacao a renovar.\n" << RESET_COR;
+        return;
+    }
+    const int hoje = serialHoje();
+    std::vector<LinhaRenovacao> linhas = linhasRenovacao(vencimentos, lista);
+    std::cout << COR_CIANO << std::left << std::setw(7) << "ID" << std::setw(24) << "Nome" << std::setw(16) << "Departamento"
+              << std::setw(26) << "Curso" << std::setw(12) << "Expira" << "Dias" << RESET_COR << "\n";
+    for (size_t i = 0; i < linhas.size() && i < limite; ++i) {
+        const LinhaRenovacao& linha = linhas[i];
+        const int dias = linha.expira - hoje;
+        std::cout << std::left << std::setw(7) << linha.colab->id << std::setw(24) << linha.colab->nome.substr(0, 23)
+                  << std::setw(16) << linha.colab->departamento.substr(0, 15) << std::setw(26) << linha.formacao->nome_curso.substr(0, 25)
+                  << std::setw(12) << textoSerial(linha.expira);
+        if (dias < 0) {
+            std::cout << COR_VERMELHA << "expirada" << RESET_COR << "\n";
+        } else {
+            std::cout << dias << "\n";
+        }
+    }
+    if (linhas.size() > limite) {
+        std::cout << "... e mais " << linhas.size() - limite << " formacoes.\n";
+    }
+    std::cout << COR_AMARELA << linhas.size() << " formacoes a renovar.\n" << RESET_COR;
+}
+
+static bool lerInteiro(const std::string& pergunta, int& valor) {
+    std::string texto;
+    std::cout << pergunta;
+    std::getline(std::cin, texto);
+    try {
+        valor = std::stoi(texto);
+    } catch (const std::exception&) {
+        std::cout << COR_VERMELHA << "ERRO: Valor invalido.\n" << RESET_COR;
+        return false;
+    }
+    return true;
+}
+
+void menuValidades(MotorValidades& motor, const std::vector<Colaborador>& lista) {
+    std::cout << COR_AZUL << "\n--- Renovacao de Formacoes (Validades) ---\n" << RESET_COR;
+    if (motor.regras.empty()) {
+        std::cout << "Nenhum curso tem validade definida.\n";
+    } else {
+        std::cout << std::left << std::setw(30) << "Curso" << "Validade (meses)\n";
+        for (const auto& par : motor.regras) {
+            std::cout << std::left << std::setw(30) << par.second.curso.substr(0, 29) << par.second.meses << "\n";
+        }
+    }
+    std::cout << motor.acompanhadas() << " formacoes com data de expiracao.\n";
+
+    std::cout << " 1. Definir Validade de um Curso (0 remove a regra)\n";
+    std::cout << " 2. Formacoes a Expirar nos Proximos N Dias\n";
+    std::cout << " 3. Exportar Renovacoes (CSV)\n";
+    int op = 0;
+    if (!lerInteiro(COR_AMARELA + " Opcao: " + RESET_COR, op)) return;
+
+    if (op == 1) {
+        std::string curso;
+        std::cout << "Nome do curso: ";
+        std::getline(std::cin, curso);
+        if (chaveCurso(curso).empty()) {
+            std::cout << COR_VERMELHA << "ERRO: Nome do curso obrigatorio.\n" << RESET_COR;
+            return;
+        }
+        int meses = 0;
+        if (!lerInteiro("Validade em meses: ", meses)) return;
+        motor.definirValidade(curso, meses);
+        motor.construir(lista); // As datas de expiração deste curso mudam em todos os colaboradores
+        if (motor.gravarRegras(FICHEIRO_VALIDADES)) {
+            std::cout << COR_VERDE << "Regra guardada em " << FICHEIRO_VALIDADES << ".\n" << RESET_COR;
+        } else {
+            std::cout << COR_VERMELHA << "ERRO: Nao foi possivel gravar " << FICHEIRO_VALIDADES << ".\n" << RESET_COR;
+        }
+    } else if (op == 2 || op == 3) {
+        int dias = 0;
+        if (!lerInteiro("Numero de dias (inclui as ja expiradas): ", dias)) return;
+        if (dias < 0) {
+            std::cout << COR_VERMELHA << "ERRO: Numero de dias invalido.\n" << RESET_COR;
+            return;
+        }
+        std::vector<Vencimento> vencimentos = motor.expiramAte(serialHoje() + dias);
+        if (op == 2) {
+            mostrarRenovacoes(vencimentos, lista, 50);
+            return;
+        }
+        std::string nomeFicheiro;
+        std::cout << "Ficheiro (ENTER = " << FICHEIRO_RENOVACOES << "): ";
+        std::getline(std::cin, nomeFicheiro);
+        if (nomeFicheiro.empty()) nomeFicheiro = FICHEIRO_RENOVACOES;
+        if (exportarRenovacoesCSV(vencimentos, lista, nomeFicheiro)) {
+            std::cout << COR_VERDE << vencimentos.size() << " renovacoes escritas em " << nomeFicheiro << "\n" << RESET_COR;
+        } else {
+            std::cout << COR_VERMELHA << "ERRO: Nao foi possivel escrever " << nomeFicheiro << ".\n" << RESET_COR;
+        }
+    } else {
+        std::cout << COR_VERMELHA << "Opcao invalida.\n" << RESET_COR;
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef VALIDADES_H
+#define VALIDADES_H
+
+#include "colaborador.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+
+// ===============================================
+// VALIDADE DAS FORMAÇÕES (RENOVAÇÕES)
+// ===============================================
+// Cursos que têm de ser renovados periodicamente têm uma validade em meses, guardada em
+// rh_validades.txt (uma linha <curso>;<meses>; o nome do curso não distingue maiúsculas nem
+// espaços repetidos). Cada formação desses cursos expira em data_conclusao + validade.
+//
+// O motor guarda as datas de expiração num heap mínimo: "o que expira até à data D" percorre só
+// os nós do heap com data <= D (os filhos de um nó com data > D também são posteriores), por isso
+// custa O(k log k) para k resultados em vez de percorrer todas as formações. Editar ou remover uma
+// formação não mexe no heap: a entrada antiga fica obsoleta (versão diferente) e é ignorada; quando
+// as obsoletas passam a ser a maioria, o heap é reconstruído.
+// O CRUD de formações (colaborador.cpp) atualiza o motor ativo através de registarFormacao/retirarFormacao.
+
+extern const std::string FICHEIRO_VALIDADES;
+extern const std::string FICHEIRO_RENOVACOES; // Nome sugerido para a exportação
+
+struct RegraValidade {
+    std::string curso; // Nome como foi escrito na regra
+    int meses = 0;
+};
+
+struct Vencimento {
+    int idColaborador = 0;
+    int idCurso = 0;
+    int expira = 0; // Data em série
+};
+
+struct MotorValidades {
+    // --- Regras ---
+    std::map<std::string, RegraValidade> regras; // chaveCurso -> regra
+
+    bool lerRegras(const std::string& nomeFicheiro);
+    bool gravarRegras(const std::string& nomeFicheiro) const;
+    void definirValidade(const std::string& curso, int meses); // 0 remove a regra (reconstruir depois)
+    int mesesDe(const std::string& curso) const;               // 0 se o curso não expira
+
+    // --- Expirações ---
+    void construir(const std::vector<Colaborador>& lista);
+    void registar(const Colaborador& colab, const Formacao& formacao); // Nova ou editada
+    void retirar(int idColaborador, int idCurso);
+    void retirarColaborador(const Colaborador& colab);
+
+    // Formações que expiram até 'limite' (inclui as já expiradas), por data de expiração
+    std::vector<Vencimento> expiramAte(int limite) const;
+
+    size_t acompanhadas() const { return atuais.size(); }
+
+private:
+    struct EntradaHeap {
+        int expira = 0;
+        uint32_t versao = 0;
+        uint64_t chave = 0; // (idColaborador, idCurso)
+    };
+    struct Atual {
+        int expira = 0;
+        uint32_t versao = 0;
+    };
+
+    std::vector<EntradaHeap> heap;
+    std::unordered_map<uint64_t, Atual> atuais;
+    uint32_t proximaVersao = 0;
+    size_t obsoletas = 0;
+
+    bool valida(const EntradaHeap& entrada) const;
+    void empilhar(const EntradaHeap& entrada);
+    void compactar();
+};
+
+// Ganchos do CRUD de formações: atualizam o motor ativo (se houver)
+void ativarMotorValidades(MotorValidades* motor);
+void registarFormacao(const Colaborador& colab, const Formacao& formacao);
+void retirarFormacao(const Colaborador& colab, int idCurso);
+void retirarFormacoesColaborador(const Colaborador& colab);
+
+// CSV com uma linha por renovação: ID,Nome,Departamento,Curso,Conclusao,Expira,Dias
+bool exportarRenovacoesCSV(const std::vector<Vencimento>& vencimentos, const std::vector<Colaborador>& lista,
+                           const std::string& nomeFicheiro);
+
+// Opção do menu: regras de validade, formações a expirar nos próximos N dias e exportação
+void menuValidades(MotorValidades& motor, const std::vector<Colaborador>& lista);
+
+#endif // VALIDADES_H
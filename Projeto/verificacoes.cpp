@@ -0,0 +1,52 @@
+// Verificações de comportamento do Mini-Sistema RH.
+//
+// Compilação:
+//   g++ -std=c++17 -O2 -pthread verificacoes.cpp calendario.cpp colaborador.cpp cores.cpp io.cpp reports.cpp paralelo.cpp metricas.cpp autosave.cpp indice.cpp arquivo.cpp ausencias.cpp mapacalor.cpp cobertura.cpp planeador.cpp formacoes.cpp notas.cpp validades.cpp duplicados.cpp cifra.cpp padroes.cpp ranking.cpp viragem.cpp -o verificacoes.exe
+//
+// Cada verificação monta os dados de que precisa em memória (não lê nem escreve rh_data.txt).
+// Termina com código 0 se todas passarem; cada falha é indicada em std::cerr.
+
+#include "colaborador.h"
+#include "calendario.h"
+#include "viragem.h"
+
+#include <iostream>
+#include <vector>
+
+// ===============================================
+// VIRAGEM DO ANO
+// ===============================================
+
+// O saldo que a viragem transita é o que fica depois das férias marcadas: um colaborador com 22
+// dias que marca um dia e desmarca outro fecha o ano com 21 por gozar, 5 transitados e 16 perdidos.
+static bool verificarSaldosViragem() {
+    Colaborador colab;
+    colab.saldo_ferias = 22 * UNIDADES_POR_DIA;
+    aplicarMarcacao(colab, 6, 1, 2025, TipoMarcacao::FERIAS);
+    aplicarMarcacao(colab, 7, 1, 2025, TipoMarcacao::FERIAS, MEIO_DIA);
+    aplicarDesmarcacao(colab, 7, 1, 2025);
+
+    ResumoViragem resumo;
+    std::vector<Colaborador> lista{colab};
+    const SaldoViragem s = calcularViragem(lista, PoliticaViragem(), resumo).front();
+    const int U = UNIDADES_POR_DIA;
+    if (s.gozados == U && s.restantes == 21 * U && s.transitados == 5 * U && s.perdidos == 16 * U && s.novoSaldo == 27 * U) {
+        return true;
+    }
+    std::cerr << "ERRO: saldos da viragem incoerentes (gozados " << formatarDias(s.gozados) << ", restantes "
+              << formatarDias(s.restantes) << ", transitados " << formatarDias(s.transitados) << ", perdidos "
+              << formatarDias(s.perdidos) << ", novo saldo " << formatarDias(s.novoSaldo) << ").\n";
+    return false;
+}
+
+int main() {
+    int falhas = 0;
+    if (!verificarSaldosViragem()) ++falhas;
+
+    if (falhas > 0) {
+        std::cerr << falhas << " verificacao(oes) falharam.\n";
+        return 1;
+    }
+    std::cout << "Todas as verificacoes passaram.\n";
+    return 0;
+}
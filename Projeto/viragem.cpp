@@ -0,0 +1,390 @@
+#include "viragem.h"
+#include "calendario.h"
+#include "arquivo.h"
+#include "io.h"
+#include "paralelo.h"
+#include "cores.h"
+#include "metricas.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <stdexcept>
+#include <ctime>
+#include <sys/stat.h>
+
+const std::string FICHEIRO_VIRAGENS = "rh_viragens.txt";
+
+static std::string nomePendente() {
+    return FICHEIRO_VIRAGENS + ".pendente";
+}
+
+static std::string nomeDadosNovos(const std::string& ficheiroDados) {
+    return ficheiroDados + ".viragem";
+}
+
+// ===============================================
+// CÁLCULO (PARALELO)
+// ===============================================
+
+std::vector<SaldoViragem> calcularViragem(const std::vector<Colaborador>& lista, const PoliticaViragem& politica,
+                                          ResumoViragem& resumo) {
+    std::vector<SaldoViragem> saldos(lista.size());
+    std::vector<ResumoViragem> parciais(numeroThreads());
+    executarBlocos(lista.size(), [&](size_t inicio, size_t fim, unsigned t) {
+        ResumoViragem& parcial = parciais[t];
+        for (size_t i = inicio; i < fim; ++i) {
+            SaldoViragem& saldo = saldos[i];
+            saldo.gozados = unidadesMarcadas(lista[i], MASCARA_DESCONTA_SALDO);
+            saldo.restantes = std::max(lista[i].saldo_ferias, 0);
+            saldo.transitados = std::min(saldo.restantes, std::max(politica.maxTransitados, 0) * UNIDADES_POR_DIA);
+            saldo.perdidos = saldo.restantes - saldo.transitados;
+            saldo.novoSaldo = politica.diasAnuais * UNIDADES_POR_DIA + saldo.transitados;
+            parcial.gozados += saldo.gozados;
+            parcial.transitados += saldo.transitados;
+            parcial.perdidos += saldo.perdidos;
+        }
+    });
+
+    resumo.colaboradores = lista.size();
+    resumo.gozados = resumo.transitados = resumo.perdidos = 0;
+    for (const auto& parcial : parciais) {
+        resumo.gozados += parcial.gozados;
+        resumo.transitados += parcial.transitados;
+        resumo.perdidos += parcial.perdidos;
+    }
+    return saldos;
+}
+
+void aplicarViragem(std::vector<Colaborador>& lista, const std::vector<SaldoViragem>& saldos) {
+    executarBlocos(lista.size(), [&](size_t inicio, size_t fim, unsigned) {
+        for (size_t i = inicio; i < fim; ++i) {
+            lista[i].calendario.clear();
+            lista[i].parciais.clear();
+            lista[i].saldo_ferias = saldos[i].novoSaldo;
+        }
+    });
+}
+
+// ===============================================
+// REGISTO DOS ANOS FECHADOS
+// ===============================================
+
+static std::vector<int> anosVirados() {
+    std::vector<int> anos;
+    std::ifstream ficheiro(FICHEIRO_VIRAGENS);
+    std::string linha;
+    while (std::getline(ficheiro, linha)) {
+        if (linha.empty() || linha[0] == '#') continue;
+        try {
+            anos.push_back(std::stoi(linha.substr(0, linha.find(';'))));
+        } catch (const std::exception&) {
+            std::cerr << COR_AMARELA << "[AVISO] Linha invalida em " << FICHEIRO_VIRAGENS << ": " << linha << "\n" << RESET_COR;
+        }
+    }
+    return anos;
+}
+
+int ultimoAnoVirado() {
+    std::vector<int> anos = anosVirados();
+    return anos.empty() ? 0 : *std::max_element(anos.begin(), anos.end());
+}
+
+// Acrescenta uma linha ao registo (reescrito por inteiro e publicado com rename)
+static bool registarViragem(const std::string& linha) {
+    std::string conteudo;
+    {
+        std::ifstream existente(FICHEIRO_VIRAGENS, std::ios::binary);
+        std::stringstream ss;
+        ss << existente.rdbuf();
+        conteudo = ss.str();
+    }
+    if (!conteudo.empty() && conteudo.back() != '\n') conteudo += '\n';
+    conteudo += linha + "\n";
+
+    const std::string temporario = FICHEIRO_VIRAGENS + ".tmp";
+    {
+        std::ofstream ficheiro(temporario, std::ios::binary);
+        if (!ficheiro.is_open()) return false;
+        ficheiro << conteudo;
+        if (!ficheiro) return false;
+    }
+    return publicarFicheiro(temporario, FICHEIRO_VIRAGENS);
+}
+
+// ===============================================
+// PUBLICAÇÃO QUE PODE SER RETOMADA
+// ===============================================
+
+struct AssinaturaFicheiro {
+    uint64_t tamanho = 0;
+    uint64_t hash = 0; // FNV-1a de 64 bits do conteúdo
+
+    bool operator==(const AssinaturaFicheiro& outra) const { return tamanho == outra.tamanho && hash == outra.hash; }
+};
+
+static bool assinar(const std::string& nomeFicheiro, AssinaturaFicheiro& assinatura) {
+    std::ifstream ficheiro(nomeFicheiro, std::ios::binary);
+    if (!ficheiro.is_open()) return false;
+    assinatura = AssinaturaFicheiro();
+    assinatura.hash = 1469598103934665603ULL;
+    std::vector<char> bloco(1 << 20);
+    while (ficheiro) {
+        ficheiro.read(bloco.data(), static_cast<std::streamsize>(bloco.size()));
+        const size_t lidos = static_cast<size_t>(ficheiro.gcount());
+        for (size_t i = 0; i < lidos; ++i) {
+            assinatura.hash ^= static_cast<unsigned char>(bloco[i]);
+            assinatura.hash *= 1099511628211ULL;
+        }
+        assinatura.tamanho += lidos;
+    }
+    return true;
+}
+
+// Passo 3: publica os dados novos (se ainda não estiverem publicados) e regista o ano.
+// 'registo' é a linha de rh_viragens.txt; 'assinatura' a dos dados novos.
+static bool publicarViragem(const std::string& ficheiroDados, const std::string& registo, const AssinaturaFicheiro& assinatura) {
+    const std::string novos = nomeDadosNovos(ficheiroDados);
+    AssinaturaFicheiro atual;
+    if (assinar(novos, atual) && atual == assinatura) {
+        if (!publicarFicheiro(novos, ficheiroDados)) {
+            std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel substituir " << ficheiroDados << ".\n" << RESET_COR;
+            return false;
+        }
+    }
+    std::remove(nomeJournal(ficheiroDados).c_str());
+    if (!registarViragem(registo)) {
+        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel atualizar " << FICHEIRO_VIRAGENS << ".\n" << RESET_COR;
+        return false;
+    }
+    std::remove(nomePendente().c_str());
+    return true;
+}
+
+// Conclui uma viragem interrompida depois de gravado o pendente. Retorna false se não for possível.
+static bool retomarPendente(const std::string& ficheiroDados) {
+    std::ifstream pendente(nomePendente());
+    if (!pendente.is_open()) return true;
+
+    // <ano>;<diasAnuais>;<maxTransitados>;<colaboradores>;<tamanho>;<hash>
+    std::string linha;
+    std::getline(pendente, linha);
+    pendente.close();
+    std::vector<std::string> campos;
+    std::stringstream ss(linha);
+    std::string campo;
+    while (std::getline(ss, campo, ';')) campos.push_back(campo);
+
+    int ano = 0;
+    AssinaturaFicheiro registada;
+    try {
+        if (campos.size() != 6) throw std::invalid_argument(linha);
+        ano = std::stoi(campos[0]);
+        registada.tamanho = std::stoull(campos[4]);
+        registada.hash = std::stoull(campos[5]);
+    } catch (const std::exception&) {
+        std::cerr << COR_AMARELA << "[AVISO] " << nomePendente() << " invalido; ignorado.\n" << RESET_COR;
+        std::remove(nomePendente().c_str());
+        return true;
+    }
+
+    // Nem os dados novos nem o ficheiro de dados têm a assinatura: a gravação não chegou ao fim
+    // e o ficheiro de dados ainda é o do ano por fechar
+    AssinaturaFicheiro atual;
+    const std::string novos = nomeDadosNovos(ficheiroDados);
+    if (!(assinar(novos, atual) && atual == registada) && !(assinar(ficheiroDados, atual) && atual == registada)) {
+        std::remove(novos.c_str());
+        std::remove(nomePendente().c_str());
+        std::cout << COR_AMARELA << "[AVISO] A viragem de " << ano << " foi interrompida antes de gravar; sera refeita.\n" << RESET_COR;
+        return true;
+    }
+
+    const std::string registo = campos[0] + ";" + campos[1] + ";" + campos[2] + ";" + campos[3];
+    if (!publicarViragem(ficheiroDados, registo, registada)) return false;
+    std::cout << COR_VERDE << "[INFO] Viragem de " << ano << " interrompida e concluida agora.\n" << RESET_COR;
+    return true;
+}
+
+// ===============================================
+// MARCAÇÕES QUE PODEM SER DO ANO NOVO
+// ===============================================
+
+// Número máximo de colaboradores listados na consola
+static const size_t MAX_COLABORADORES_ANO_NOVO = 20;
+
+static std::time_t ultimaAlteracao(const std::string& nomeFicheiro) {
+    struct stat info;
+    return stat(nomeFicheiro.c_str(), &info) == 0 ? info.st_mtime : 0;
+}
+
+// Os calendários não têm ano: se os dados foram alterados depois de 31/12 de 'ano', as marcações
+// de 1/1 até ao dia dessa alteração podem já ser do ano novo e a viragem arquivá-las-ia como de
+// 'ano' e apagá-las-ia. Lista-as e retorna quantas são (0 se os dados não mudaram depois do fim do ano).
+static size_t avisarMarcacoesAnoNovo(const std::vector<Colaborador>& lista, const std::string& ficheiroDados, int ano) {
+    const std::time_t alteracao = std::max(ultimaAlteracao(ficheiroDados), ultimaAlteracao(nomeJournal(ficheiroDados)));
+    std::tm inicioAnoNovo = {};
+    inicioAnoNovo.tm_year = ano + 1 - 1900;
+    inicioAnoNovo.tm_mday = 1;
+    inicioAnoNovo.tm_isdst = -1;
+    if (alteracao < std::mktime(&inicioAnoNovo)) return 0;
+
+    // Último dia do ano novo em que os dados podem ter sido marcados (o ano todo se já passou)
+    const std::tm local = *std::localtime(&alteracao);
+    const int limite = local.tm_year + 1900 > ano + 1 ? 366 : local.tm_yday + 1;
+
+    size_t total = 0, listados = 0;
+    std::ostringstream detalhe;
+    for (const auto& colab : lista) {
+        std::string dias;
+        for (const auto& par : colab.calendario) {
+            if (par.first > limite) break;
+            if (!temTipo(MASCARA_MARCAVEL, par.second)) continue;
+            int dia = 0, mes = 0;
+            if (!diaDoAnoParaData(par.first, ano + 1, dia, mes)) continue;
+            dias += (dias.empty() ? "" : ", ") + std::to_string(dia) + "/" + std::to_string(mes) + ":" +
+                    propriedadesMarcacao(par.second).simbolo;
+            ++total;
+        }
+        if (dias.empty() || ++listados > MAX_COLABORADORES_ANO_NOVO) continue;
+        detalhe << "  " << colab.id << " " << colab.nome << ": " << dias << "\n";
+    }
+    if (total == 0) return 0;
+
+    std::cerr << COR_AMARELA << "[AVISO] " << ficheiroDados << " foi alterado em " << local.tm_mday << "/" << local.tm_mon + 1
+              << "/" << local.tm_year + 1900 << ", depois do fim de " << ano << ". Estas " << total
+              << " marcacoes podem ser de " << ano + 1 << " e seriam arquivadas como " << ano << " e apagadas:\n"
+              << RESET_COR << detalhe.str();
+    if (listados > MAX_COLABORADORES_ANO_NOVO) {
+        std::cerr << "  ... e mais " << listados - MAX_COLABORADORES_ANO_NOVO << " colaboradores.\n";
+    }
+    return total;
+}
+
+// ===============================================
+// TRABALHO COMPLETO
+// ===============================================
+
+// CSV com uma linha por colaborador: ID,Nome,Departamento,Gozados,Restantes,Transitados,Perdidos,Novo_Saldo
+static bool exportarViragemCSV(const std::vector<Colaborador>& lista, const std::vector<SaldoViragem>& saldos,
+                               const std::string& nomeFicheiro) {
+    BufferEscrita saida(nomeFicheiro);
+    if (!saida.aberto()) return false;
+    saida.escrever("ID,Nome,Departamento,Gozados,Restantes,Transitados,Perdidos,Novo_Saldo\n");
+    for (size_t i = 0; i < lista.size(); ++i) {
+        const SaldoViragem& s = saldos[i];
+        saida.escreverInt(lista[i].id);
+        saida.escreverChar(',');
+        saida.escrever(lista[i].nome);
+        saida.escreverChar(',');
+        saida.escrever(lista[i].departamento);
+        saida.escreverChar(',');
+        saida.escreverDias(s.gozados);
+        saida.escreverChar(',');
+        saida.escreverDias(s.restantes);
+        saida.escreverChar(',');
+        saida.escreverDias(s.transitados);
+        saida.escreverChar(',');
+        saida.escreverDias(s.perdidos);
+        saida.escreverChar(',');
+        saida.escreverDias(s.novoSaldo);
+        saida.escreverChar('\n');
+    }
+    return true;
+}
+
+bool virarAno(const std::string& ficheiroDados, int ano, const PoliticaViragem& politica, bool forcar) {
+    MEDIR_ESCOPO(Metrica::VIRAR_ANO);
+    auto inicio = std::chrono::steady_clock::now();
+
+    if (ano >= obterAnoAtual()) {
+        std::cerr << COR_VERMELHA << "ERRO: So e possivel fechar anos anteriores a " << obterAnoAtual() << ".\n" << RESET_COR;
+        return false;
+    }
+    if (politica.diasAnuais < 0 || politica.maxTransitados < 0) {
+        std::cerr << COR_VERMELHA << "ERRO: A politica de ferias nao pode ter valores negativos.\n" << RESET_COR;
+        return false;
+    }
+    if (!retomarPendente(ficheiroDados)) return false;
+
+    std::vector<int> anos = anosVirados();
+    if (std::find(anos.begin(), anos.end(), ano) != anos.end()) {
+        std::cout << COR_VERDE << "[INFO] O ano " << ano << " ja foi fechado (" << FICHEIRO_VIRAGENS << "). Nada a fazer.\n" << RESET_COR;
+        return true;
+    }
+    const int ultimo = anos.empty() ? 0 : *std::max_element(anos.begin(), anos.end());
+    if (ultimo != 0 && ano != ultimo + 1) {
+        std::cerr << COR_VERMELHA << "ERRO: O ultimo ano fechado foi " << ultimo << "; o proximo a fechar e "
+                  << ultimo + 1 << ".\n" << RESET_COR;
+        return false;
+    }
+
+    std::vector<Colaborador> lista;
+    carregarDados(lista, ficheiroDados);
+    if (std::ifstream(nomeJournal(ficheiroDados)).is_open()) {
+        // As alterações do autosave passam primeiro para o ficheiro, para o journal não ser
+        // reaplicado sobre o ano novo
+        guardarDados(lista, ficheiroDados);
+    }
+
+    if (avisarMarcacoesAnoNovo(lista, ficheiroDados, ano) > 0) {
+        if (!forcar) {
+            std::cerr << COR_VERMELHA << "ERRO: Viragem de " << ano << " cancelada. Se estas marcacoes forem de " << ano
+                      << ", repita com --forcar.\n" << RESET_COR;
+            return false;
+        }
+        std::cout << COR_AMARELA << "[AVISO] --forcar: as marcacoes acima sao tratadas como de " << ano << ".\n" << RESET_COR;
+    }
+
+    ResumoViragem resumo;
+    resumo.ano = ano;
+    std::vector<SaldoViragem> saldos = calcularViragem(lista, politica, resumo);
+
+    if (anoArquivado(ano)) {
+        std::cout << COR_AMARELA << "[AVISO] O arquivo de " << ano << " ja existe e e mantido (" << nomeArquivoAno(ano) << ").\n" << RESET_COR;
+    } else if (!arquivarAno(lista, ano)) {
+        return false;
+    }
+
+    aplicarViragem(lista, saldos);
+
+    // Publicação: dados novos -> pendente -> rename -> registo
+    const std::string novos = nomeDadosNovos(ficheiroDados);
+    const std::string registo = std::to_string(ano) + ";" + std::to_string(politica.diasAnuais) + ";" +
+                                std::to_string(politica.maxTransitados) + ";" + std::to_string(lista.size());
+    AssinaturaFicheiro assinatura;
+    if (!escreverFicheiroDados(lista, novos) || !assinar(novos, assinatura)) {
+        std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel gravar " << novos << ".\n" << RESET_COR;
+        return false;
+    }
+    {
+        const std::string temporario = nomePendente() + ".tmp";
+        std::ofstream pendente(temporario);
+        pendente << registo << ";" << assinatura.tamanho << ";" << assinatura.hash << "\n";
+        pendente.close();
+        if (!pendente || !publicarFicheiro(temporario, nomePendente())) {
+            std::cerr << COR_VERMELHA << "ERRO: Nao foi possivel gravar " << nomePendente() << ".\n" << RESET_COR;
+            std::remove(novos.c_str());
+            return false;
+        }
+    }
+    if (!publicarViragem(ficheiroDados, registo, assinatura)) return false;
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+    std::cout << COR_VERDE << "[INFO] Ano " << ano << " fechado para " << resumo.colaboradores << " colaboradores ("
+              << std::fixed << std::setprecision(1) << ms << " ms).\n" << RESET_COR << std::defaultfloat << std::setprecision(6);
+    std::cout << "Dias de ferias gozados: " << formatarDias(resumo.gozados) << "\n";
+    std::cout << "Dias transitados para " << ano + 1 << ": " << formatarDias(resumo.transitados) << " (maximo " << politica.maxTransitados
+              << " por colaborador)\n";
+    std::cout << "Dias perdidos: " << formatarDias(resumo.perdidos) << "\n";
+    std::cout << "Saldo de " << ano + 1 << ": " << politica.diasAnuais << " dias + transitados\n";
+
+    const std::string relatorio = "viragem_" + std::to_string(ano) + ".csv";
+    if (exportarViragemCSV(lista, saldos, relatorio)) {
+        std::cout << COR_VERDE << "[INFO] Saldos por colaborador em " << relatorio << ".\n" << RESET_COR;
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+#ifndef VIRAGEM_H
+#define VIRAGEM_H
+
+#include "colaborador.h"
+#include <string>
+#include <vector>
+
+// ===============================================
+// VIRAGEM DO ANO (FECHO E ABERTURA)
+// ===============================================
+// Fecha um ano para a empresa inteira: conta os dias de férias gozados, passa para o ano novo os
+// dias por gozar até ao limite da política, arquiva os calendários do ano (arquivo.h) e começa o
+// ano novo com calendários vazios e o saldo anual mais os dias transitados. O cálculo e a
+// abertura são paralelos por colaborador.
+//
+// O ficheiro de dados só é substituído no fim, num passo que pode ser retomado:
+//   1. os dados novos são escritos em <dados>.viragem;
+//   2. <viragens>.pendente regista o ano e o tamanho/assinatura desse ficheiro;
+//   3. <dados>.viragem substitui <dados> (rename) e o ano é acrescentado a rh_viragens.txt;
+//   4. o pendente é apagado.
+// Se o processo parar a meio, a execução seguinte conclui o passo 3 (a assinatura diz se o
+// ficheiro novo está completo e se já foi publicado) antes de fazer outra coisa. Um ano que já
+// consta de rh_viragens.txt não é fechado outra vez, por isso o trabalho pode ser repetido.
+
+extern const std::string FICHEIRO_VIRAGENS; // Uma linha <ano>;<diasAnuais>;<maxTransitados>;<colaboradores>
+
+struct PoliticaViragem {
+    int diasAnuais = 22;    // Saldo atribuído no ano novo
+    int maxTransitados = 5; // Dias por gozar que passam para o ano novo (o resto perde-se)
+};
+
+// Em unidades (UNIDADES_POR_DIA por dia, marcacoes.h)
+struct SaldoViragem {
+    int gozados = 0;     // Férias marcadas no ano fechado
+    int restantes = 0;   // Saldo por gozar no fecho (saldo_ferias, já sem as férias marcadas)
+    int transitados = 0;
+    int perdidos = 0;
+    int novoSaldo = 0;
+};
+
+struct ResumoViragem {
+    int ano = 0;
+    size_t colaboradores = 0;
+    long long gozados = 0;
+    long long transitados = 0;
+    long long perdidos = 0;
+};
+
+// Saldo de fecho de cada colaborador (pela ordem da lista), sem alterar nada
+std::vector<SaldoViragem> calcularViragem(const std::vector<Colaborador>& lista, const PoliticaViragem& politica,
+                                          ResumoViragem& resumo);
+
+// Abre o ano novo na lista: calendários vazios e o saldo calculado
+void aplicarViragem(std::vector<Colaborador>& lista, const std::vector<SaldoViragem>& saldos);
+
+// Último ano fechado em rh_viragens.txt (0 se nenhum)
+int ultimoAnoVirado();
+
+// Trabalho completo sobre o ficheiro de dados (--virar-ano). Retorna true se o ano ficou fechado,
+// incluindo quando já o estava. Os calendários não têm ano: se os dados foram alterados depois de
+// 31/12 de 'ano', as marcações de 1/1 até essa data podem ser do ano novo e seriam arquivadas e
+// apagadas; são listadas e a viragem só continua com 'forcar' (--forcar).
+bool virarAno(const std::string& ficheiroDados, int ano, const PoliticaViragem& politica, bool forcar = false);
+
+#endif // VIRAGEM_H